@@ -0,0 +1,35 @@
+#pragma once
+#include "Mymath.h"
+#include <cmath>
+
+// ベンチマーク用の固定カメラ
+namespace BenchCamera {
+
+// カメラの行列
+struct CameraMatrices {
+    Matrix4x4 billboard;
+    Matrix4x4 viewProjection;
+};
+
+// 透視投影（縦の視野角45度、16:9、0.1～100）のカメラ
+inline CameraMatrices MakeCameraMatrices() {
+    // カメラのワールド行列の回転部分がビルボード行列になる
+    Matrix4x4 cameraWorld = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.5f, 0.0f }, { 0.0f, 5.0f, -20.0f });
+    Matrix4x4 billboard = cameraWorld;
+    billboard.m[3][0] = 0.0f;
+    billboard.m[3][1] = 0.0f;
+    billboard.m[3][2] = 0.0f;
+
+    float cotHalfFov = 1.0f / std::tan(0.3927f);
+    float nearClip = 0.1f;
+    float farClip = 100.0f;
+    Matrix4x4 projection = {
+        cotHalfFov / (16.0f / 9.0f), 0, 0, 0,
+        0, cotHalfFov, 0, 0,
+        0, 0, farClip / (farClip - nearClip), 1,
+        0, 0, -nearClip * farClip / (farClip - nearClip), 0
+    };
+    return { billboard, Multiply(InverseAffine(cameraWorld), projection) };
+}
+
+} // namespace BenchCamera
@@ -0,0 +1,110 @@
+#include "BenchCamera.h"
+#include "BillboardTransform.h"
+#include "FastMath.h"
+#include "Mymath.h"
+#include "ParticlePool.h"
+#include "ParticleRandom.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <span>
+#include <vector>
+
+// パーティクルのWorld行列・WVP行列の計算の比較
+// 以前の Scale * RotateZ * Billboard の4x4行列の乗算と、前計算した軸から直接求めるMakeBillboardTransform
+// MakeBillboardTransformは1粒ずつsinとcosを求める場合と、ParticleManagerと同じくブロックごとにまとめて求める場合を比べる
+
+namespace {
+
+const uint32_t kParticleCount = 10000;
+
+ParticlePool MakePool() {
+    ParticleRandom random(1);
+    ParticlePool pool;
+    uint32_t first = pool.Append(kParticleCount);
+    random.FillUniform(&pool.positionX[first], kParticleCount, -10.0f, 10.0f);
+    random.FillUniform(&pool.positionY[first], kParticleCount, -10.0f, 10.0f);
+    random.FillUniform(&pool.positionZ[first], kParticleCount, -10.0f, 10.0f);
+    random.FillUniform(&pool.size[first], kParticleCount, 0.5f, 1.0f);
+    random.FillUniform(&pool.rotation[first], kParticleCount, -3.0f, 3.0f);
+    return pool;
+}
+
+// 以前の実装：拡大縮小・Z回転・ビルボードの行列を掛け合わせ、さらにビュープロジェクション行列を掛ける
+void BM_MatrixMultiply(benchmark::State& state) {
+    BenchCamera::CameraMatrices camera = BenchCamera::MakeCameraMatrices();
+    ParticlePool pool = MakePool();
+    std::vector<Matrix4x4> world(kParticleCount);
+    std::vector<Matrix4x4> wvp(kParticleCount);
+
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < kParticleCount; ++i) {
+            Matrix4x4 matWorld = MakeScaleMatrix({ pool.size[i], pool.size[i], pool.size[i] });
+            matWorld = Multiply(matWorld, MakeRotateZMatrix(pool.rotation[i]));
+            matWorld = Multiply(matWorld, camera.billboard);
+            matWorld.m[3][0] = pool.positionX[i];
+            matWorld.m[3][1] = pool.positionY[i];
+            matWorld.m[3][2] = pool.positionZ[i];
+            world[i] = matWorld;
+            wvp[i] = Multiply(matWorld, camera.viewProjection);
+        }
+        benchmark::DoNotOptimize(world.data());
+        benchmark::DoNotOptimize(wvp.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kParticleCount);
+}
+
+// フレームに1回作る前計算データから直接求める（sinとcosは1粒ずつ）
+void BM_BillboardTransform(benchmark::State& state) {
+    BenchCamera::CameraMatrices camera = BenchCamera::MakeCameraMatrices();
+    BillboardBasis basis = MakeBillboardBasis(camera.billboard, camera.viewProjection);
+    ParticlePool pool = MakePool();
+    std::vector<Matrix4x4> world(kParticleCount);
+    std::vector<Matrix4x4> wvp(kParticleCount);
+
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < kParticleCount; ++i) {
+            MakeBillboardTransform(basis, pool.size[i], pool.rotation[i],
+                { pool.positionX[i], pool.positionY[i], pool.positionZ[i] }, world[i], wvp[i]);
+        }
+        benchmark::DoNotOptimize(world.data());
+        benchmark::DoNotOptimize(wvp.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kParticleCount);
+}
+
+// 現在の実装：sinとcosを64粒ずつまとめてFastMath::SinCosで求めてから、前計算データで直接求める
+void BM_BillboardTransformBlockSinCos(benchmark::State& state) {
+    BenchCamera::CameraMatrices camera = BenchCamera::MakeCameraMatrices();
+    BillboardBasis basis = MakeBillboardBasis(camera.billboard, camera.viewProjection);
+    ParticlePool pool = MakePool();
+    std::vector<Matrix4x4> world(kParticleCount);
+    std::vector<Matrix4x4> wvp(kParticleCount);
+    const uint32_t kBlockSize = 64;
+    float sins[kBlockSize];
+    float coses[kBlockSize];
+
+    for (auto _ : state) {
+        for (uint32_t blockBegin = 0; blockBegin < kParticleCount; blockBegin += kBlockSize) {
+            uint32_t blockCount = (std::min)(kBlockSize, kParticleCount - blockBegin);
+            FastMath::SinCos(std::span<const float>(&pool.rotation[blockBegin], blockCount),
+                std::span<float>(sins, blockCount), std::span<float>(coses, blockCount));
+            for (uint32_t j = 0; j < blockCount; ++j) {
+                uint32_t i = blockBegin + j;
+                MakeBillboardTransform(basis, pool.size[i], sins[j], coses[j],
+                    { pool.positionX[i], pool.positionY[i], pool.positionZ[i] }, world[i], wvp[i]);
+            }
+        }
+        benchmark::DoNotOptimize(world.data());
+        benchmark::DoNotOptimize(wvp.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kParticleCount);
+}
+
+} // namespace
+
+BENCHMARK(BM_MatrixMultiply)->Name("Particle/Billboard/MatrixMultiply");
+BENCHMARK(BM_BillboardTransform)->Name("Particle/Billboard/BillboardTransform");
+BENCHMARK(BM_BillboardTransformBlockSinCos)->Name("Particle/Billboard/BillboardTransformBlockSinCos");
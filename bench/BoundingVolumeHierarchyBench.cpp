@@ -0,0 +1,223 @@
+#include "BenchCamera.h"
+#include "BoundingVolumeHierarchy.h"
+#include "ParticleRandom.h"
+#include <benchmark/benchmark.h>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+// BVHの構築・更新・検索の時間
+// 視錐台と球の検索、レイキャストは全アイテムを1つずつ調べる方法と比べる
+// アイテムは数によらず密度が同じになるよう、一辺が数の立方根に比例する範囲に大きさ0.5～2の箱を置く
+
+namespace {
+
+std::vector<AABB> MakeAABBs(uint32_t count, uint32_t seed) {
+    float halfExtent = 2.0f * std::cbrt(static_cast<float>(count));
+    ParticleRandom random(seed);
+    std::vector<AABB> aabbs(count);
+    for (AABB& aabb : aabbs) {
+        Vector3 min = { random.NextFloat(-halfExtent, halfExtent), random.NextFloat(-halfExtent, halfExtent), random.NextFloat(-halfExtent, halfExtent) };
+        aabb = { min, { min.x + random.NextFloat(0.5f, 2.0f), min.y + random.NextFloat(0.5f, 2.0f), min.z + random.NextFloat(0.5f, 2.0f) } };
+    }
+    return aabbs;
+}
+
+// 原点の周りに散らばったレイ（始点は手前、向きは原点付近へ）
+std::vector<Ray> MakeRays(uint32_t rayCount, uint32_t itemCount) {
+    float halfExtent = 2.0f * std::cbrt(static_cast<float>(itemCount));
+    ParticleRandom random(3);
+    std::vector<Ray> rays(rayCount);
+    for (Ray& ray : rays) {
+        ray.origin = { random.NextFloat(-halfExtent, halfExtent), random.NextFloat(-halfExtent, halfExtent), -halfExtent * 2.0f };
+        Vector3 target = { random.NextFloat(-halfExtent, halfExtent), random.NextFloat(-halfExtent, halfExtent), 0.0f };
+        Vector3 d = { target.x - ray.origin.x, target.y - ray.origin.y, target.z - ray.origin.z };
+        float inverseLength = 1.0f / std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+        ray.direction = { d.x * inverseLength, d.y * inverseLength, d.z * inverseLength };
+    }
+    return rays;
+}
+
+// 全アイテムを範囲に収めるカメラ（BenchCameraの視錐台を範囲の大きさに合わせて縮める）
+Frustum MakeSceneFrustum(uint32_t itemCount) {
+    float scale = 20.0f / (2.0f * std::cbrt(static_cast<float>(itemCount)));
+    Matrix4x4 sceneToCamera = MakeAffineMatrix({ scale, scale, scale }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f });
+    return MakeFrustum(Multiply(sceneToCamera, BenchCamera::MakeCameraMatrices().viewProjection));
+}
+
+void BM_Build(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    BoundingVolumeHierarchy bvh;
+    for (auto _ : state) {
+        bvh.Build(aabbs);
+        benchmark::ClobberMemory();
+    }
+    state.counters["sah_cost"] = bvh.ComputeCost();
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 1割のアイテムが動いたフレームの更新（UpdateItemとRefit）
+void BM_RefitIncremental(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    ParticleRandom random(2);
+    uint32_t movedCount = count / 10;
+    std::vector<uint32_t> movedItems(movedCount);
+    for (uint32_t& item : movedItems) {
+        item = static_cast<uint32_t>(random.NextFloat() * (count - 1));
+    }
+    float offset = 0.0f;
+    for (auto _ : state) {
+        // 行ったり来たりさせて木の品質が悪化し続けないようにする
+        offset = offset > 0.0f ? -0.1f : 0.1f;
+        for (uint32_t item : movedItems) {
+            AABB& aabb = aabbs[item];
+            aabb.min.x += offset;
+            aabb.max.x += offset;
+            bvh.UpdateItem(item, aabb);
+        }
+        bvh.Refit();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * movedCount);
+}
+
+// 全アイテムが動いたフレームの更新（Refit(span)）
+void BM_RefitAll(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    for (auto _ : state) {
+        bvh.Refit(aabbs);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_FrustumBvh(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    Frustum frustum = MakeSceneFrustum(count);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    std::vector<uint32_t> visibleItems;
+    for (auto _ : state) {
+        visibleItems.clear();
+        bvh.QueryFrustum(frustum, visibleItems);
+        benchmark::DoNotOptimize(visibleItems.data());
+    }
+    state.counters["visible"] = static_cast<double>(visibleItems.size());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_FrustumLinear(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    Frustum frustum = MakeSceneFrustum(count);
+    std::vector<uint32_t> visibleItems;
+    for (auto _ : state) {
+        visibleItems.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (IsAABBInFrustum(frustum, aabbs[i])) {
+                visibleItems.push_back(i);
+            }
+        }
+        benchmark::DoNotOptimize(visibleItems.data());
+    }
+    state.counters["visible"] = static_cast<double>(visibleItems.size());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 半径4の球と重なるアイテムの検索（爆発の範囲など）
+void BM_SphereBvh(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    std::vector<uint32_t> items;
+    for (auto _ : state) {
+        items.clear();
+        bvh.QuerySphere({ { 0.0f, 0.0f, 0.0f }, 4.0f }, items);
+        benchmark::DoNotOptimize(items.data());
+    }
+    state.counters["found"] = static_cast<double>(items.size());
+}
+
+void BM_SphereLinear(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    Sphere sphere = { { 0.0f, 0.0f, 0.0f }, 4.0f };
+    std::vector<uint32_t> items;
+    for (auto _ : state) {
+        items.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (IsSphereAABBOverlap(sphere, aabbs[i])) {
+                items.push_back(i);
+            }
+        }
+        benchmark::DoNotOptimize(items.data());
+    }
+    state.counters["found"] = static_cast<double>(items.size());
+}
+
+// 1024本のレイの最も近いアイテム（rays/s）
+void BM_RaycastBvh(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    std::vector<Ray> rays = MakeRays(1024, count);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    uint32_t hitCount = 0;
+    for (auto _ : state) {
+        hitCount = 0;
+        for (const Ray& ray : rays) {
+            BvhRayHit hit;
+            hitCount += bvh.Raycast(ray, FLT_MAX, hit) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hitCount);
+    }
+    state.counters["hits"] = static_cast<double>(hitCount);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+void BM_RaycastLinear(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<AABB> aabbs = MakeAABBs(count, 1);
+    std::vector<Ray> rays = MakeRays(1024, count);
+    uint32_t hitCount = 0;
+    for (auto _ : state) {
+        hitCount = 0;
+        for (const Ray& ray : rays) {
+            Vector3 inverseDirection = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+            float closest = FLT_MAX;
+            bool isHit = false;
+            for (const AABB& aabb : aabbs) {
+                float distance;
+                if (IntersectRayAABB(ray, inverseDirection, aabb, closest, distance)) {
+                    closest = distance;
+                    isHit = true;
+                }
+            }
+            hitCount += isHit ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hitCount);
+    }
+    state.counters["hits"] = static_cast<double>(hitCount);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->Name("Bvh/Build")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RefitIncremental)->Name("Bvh/Refit/Incremental10Percent")->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RefitAll)->Name("Bvh/Refit/All")->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrustumBvh)->Name("Bvh/Frustum/Bvh")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrustumLinear)->Name("Bvh/Frustum/Linear")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SphereBvh)->Name("Bvh/Sphere/Bvh")->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SphereLinear)->Name("Bvh/Sphere/Linear")->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RaycastBvh)->Name("Bvh/Raycast/Bvh")->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RaycastLinear)->Name("Bvh/Raycast/Linear")->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,90 @@
+#include "BenchCamera.h"
+#include "Bounds.h"
+#include "Frustum.h"
+#include "ParticleRandom.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// 視錐台カリングの処理量（items_per_secondの1M/sが1000 objects/msにあたる）
+// 1個ずつ判定する球・AABBと、4個ずつSIMDで判定するCullSpheresを比べる
+// オブジェクトはカメラの周り±100の範囲に置く（およそ1割が視錐台と重なる）
+
+namespace {
+
+std::vector<Sphere> MakeSpheres(uint32_t count) {
+    ParticleRandom random(1);
+    std::vector<Sphere> spheres(count);
+    for (Sphere& sphere : spheres) {
+        sphere.center = { random.NextFloat(-100.0f, 100.0f), random.NextFloat(-100.0f, 100.0f), random.NextFloat(-100.0f, 100.0f) };
+        sphere.radius = random.NextFloat(0.5f, 3.0f);
+    }
+    return spheres;
+}
+
+// 1個ずつ球で判定する
+void BM_SphereScalar(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    Frustum frustum = MakeFrustum(BenchCamera::MakeCameraMatrices().viewProjection);
+    std::vector<Sphere> spheres = MakeSpheres(count);
+    std::vector<uint32_t> visibleIndices(count);
+    uint32_t visibleCount = 0;
+    for (auto _ : state) {
+        visibleCount = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (IsSphereInFrustum(frustum, spheres[i])) {
+                visibleIndices[visibleCount++] = i;
+            }
+        }
+        benchmark::DoNotOptimize(visibleIndices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["visible"] = static_cast<double>(visibleCount);
+}
+
+// 1個ずつAABBで判定する
+void BM_AABBScalar(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    Frustum frustum = MakeFrustum(BenchCamera::MakeCameraMatrices().viewProjection);
+    std::vector<Sphere> spheres = MakeSpheres(count);
+    std::vector<AABB> aabbs(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        aabbs[i] = MakeAABB(spheres[i]);
+    }
+    std::vector<uint32_t> visibleIndices(count);
+    uint32_t visibleCount = 0;
+    for (auto _ : state) {
+        visibleCount = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (IsAABBInFrustum(frustum, aabbs[i])) {
+                visibleIndices[visibleCount++] = i;
+            }
+        }
+        benchmark::DoNotOptimize(visibleIndices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["visible"] = static_cast<double>(visibleCount);
+}
+
+// 4個ずつSIMDで判定する（Object3d::CullObjectsと同じ経路）
+void BM_CullSpheres(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    Frustum frustum = MakeFrustum(BenchCamera::MakeCameraMatrices().viewProjection);
+    std::vector<Sphere> spheres = MakeSpheres(count);
+    std::vector<uint32_t> visibleIndices(count);
+    uint32_t visibleCount = 0;
+    for (auto _ : state) {
+        visibleCount = CullSpheres(frustum, spheres, visibleIndices);
+        benchmark::DoNotOptimize(visibleIndices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["visible"] = static_cast<double>(visibleCount);
+}
+
+} // namespace
+
+BENCHMARK(BM_SphereScalar)->Name("Frustum/Cull/SphereScalar")->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_AABBScalar)->Name("Frustum/Cull/AABBScalar")->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_CullSpheres)->Name("Frustum/Cull/CullSpheres")->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,75 @@
+#include "MatrixSimd.h"
+#include "Mymath.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// 4x4行列演算のSIMD版とスカラー版の比較
+// 1回の呼び出しでは差が測れないので、行列の配列をまとめて処理する時間を測る
+
+namespace {
+
+const size_t kMatrixCount = 1024;
+
+// 乱数でアフィン行列の配列を作る（逆行列が存在するもの）
+std::vector<Matrix4x4> MakeMatrices() {
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> translate(-100.0f, 100.0f);
+    std::vector<Matrix4x4> matrices(kMatrixCount);
+    for (Matrix4x4& matrix : matrices) {
+        matrix = MakeAffineMatrix(
+            { scale(engine), scale(engine), scale(engine) },
+            { angle(engine), angle(engine), angle(engine) },
+            { translate(engine), translate(engine), translate(engine) });
+    }
+    return matrices;
+}
+
+// 隣り合う行列の積
+template<Matrix4x4 (*Function)(const Matrix4x4&, const Matrix4x4&)>
+void BM_Multiply(benchmark::State& state) {
+    std::vector<Matrix4x4> matrices = MakeMatrices();
+    std::vector<Matrix4x4> results(kMatrixCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kMatrixCount; ++i) {
+            results[i] = Function(matrices[i], matrices[(i + 1) % kMatrixCount]);
+        }
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kMatrixCount);
+}
+
+// 1つの行列を引数に取る処理（転置・逆行列）
+template<Matrix4x4 (*Function)(const Matrix4x4&)>
+void BM_Unary(benchmark::State& state) {
+    std::vector<Matrix4x4> matrices = MakeMatrices();
+    std::vector<Matrix4x4> results(kMatrixCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kMatrixCount; ++i) {
+            results[i] = Function(matrices[i]);
+        }
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kMatrixCount);
+}
+
+// 使用中の実装の名前を出力に含める
+void AddBackendContext() {
+    benchmark::AddCustomContext("MatrixSimd backend", MatrixSimd::GetBackendName());
+}
+const bool kIsContextAdded = (AddBackendContext(), true);
+
+} // namespace
+
+BENCHMARK(BM_Multiply<MatrixSimd::MultiplyScalar>)->Name("Matrix/Multiply/Scalar");
+BENCHMARK(BM_Multiply<MatrixSimd::Multiply>)->Name("Matrix/Multiply/Simd");
+BENCHMARK(BM_Unary<MatrixSimd::TransposeScalar>)->Name("Matrix/Transpose/Scalar");
+BENCHMARK(BM_Unary<MatrixSimd::Transpose>)->Name("Matrix/Transpose/Simd");
+BENCHMARK(BM_Unary<MatrixSimd::InverseScalar>)->Name("Matrix/Inverse/Scalar");
+BENCHMARK(BM_Unary<MatrixSimd::Inverse>)->Name("Matrix/Inverse/Simd");
+BENCHMARK(BM_Unary<MatrixSimd::InverseAffineScalar>)->Name("Matrix/InverseAffine/Scalar");
+BENCHMARK(BM_Unary<MatrixSimd::InverseAffine>)->Name("Matrix/InverseAffine/Simd");
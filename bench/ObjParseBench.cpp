@@ -0,0 +1,157 @@
+#include "ObjFile.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// OBJの解析の処理量（bytes/s）
+// 以前のModel::LoadObjFileの1行ずつstd::getlineとstd::istringstreamで読む方法と、ObjFile::Parseを比べる
+// ファイルの読み込み時間を含めないよう、どちらもメモリ上のテキストを解析する
+// 入力はResourcesのモデルと、大きなモデルの代わりに生成した256x256マスの格子（131072面）
+
+namespace {
+
+// 解析するテキスト
+struct Input {
+    std::string name;
+    std::string text;
+};
+
+std::string ReadText(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    return stream.str();
+}
+
+// 位置・テクスチャ座標・法線を持つ三角形の格子のOBJ
+std::string MakeGridObj(uint32_t cellCount) {
+    std::ostringstream stream;
+    stream << "o grid\n";
+    for (uint32_t z = 0; z <= cellCount; ++z) {
+        for (uint32_t x = 0; x <= cellCount; ++x) {
+            float px = static_cast<float>(x) / static_cast<float>(cellCount) * 10.0f;
+            float pz = static_cast<float>(z) / static_cast<float>(cellCount) * 10.0f;
+            stream << "v " << px << ' ' << std::sin(px) * std::cos(pz) << ' ' << pz << '\n';
+            stream << "vt " << static_cast<float>(x) / cellCount << ' ' << static_cast<float>(z) / cellCount << '\n';
+            stream << "vn 0 1 0\n";
+        }
+    }
+    auto index = [cellCount](uint32_t x, uint32_t z) { return z * (cellCount + 1) + x + 1; };
+    auto writeCorner = [&stream](uint32_t i) { stream << ' ' << i << '/' << i << '/' << i; };
+    for (uint32_t z = 0; z < cellCount; ++z) {
+        for (uint32_t x = 0; x < cellCount; ++x) {
+            stream << 'f';
+            writeCorner(index(x, z));
+            writeCorner(index(x, z + 1));
+            writeCorner(index(x + 1, z));
+            stream << "\nf";
+            writeCorner(index(x + 1, z));
+            writeCorner(index(x, z + 1));
+            writeCorner(index(x + 1, z + 1));
+            stream << '\n';
+        }
+    }
+    return stream.str();
+}
+
+const std::vector<Input>& GetInputs() {
+    static const std::vector<Input> inputs = [] {
+        std::vector<Input> result;
+        for (const char* fileName : { "Models/sphere.obj", "06_02/axis.obj", "06_02/multiMaterial.obj", "06_02/plane.obj" }) {
+            result.push_back({ fileName, ReadText(std::string(ENGINE_RESOURCE_DIR "/") + fileName) });
+        }
+        result.push_back({ "grid256", MakeGridObj(256) });
+        return result;
+    }();
+    return inputs;
+}
+
+// 以前の実装（Model::LoadObjFileの解析部分。三角形の「v/vt/vn」だけに対応する）
+std::vector<VertexData> ParseLegacy(const std::string& text) {
+    std::vector<VertexData> vertices;
+    std::vector<Vector4> positions;
+    std::vector<Vector3> normals;
+    std::vector<Vector2> texcoords;
+    std::string line;
+    std::istringstream file(text);
+
+    while (std::getline(file, line)) {
+        std::string identifier;
+        std::istringstream s(line);
+        s >> identifier;
+
+        if (identifier == "v") {
+            Vector4 position;
+            s >> position.x >> position.y >> position.z;
+            position.w = 1.0f;
+            position.x *= -1;
+            positions.push_back(position);
+        }
+        else if (identifier == "vt") {
+            Vector2 texcoord;
+            s >> texcoord.x >> texcoord.y;
+            texcoord.y = 1 - texcoord.y;
+            texcoords.push_back(texcoord);
+        }
+        else if (identifier == "vn") {
+            Vector3 normal;
+            s >> normal.x >> normal.y >> normal.z;
+            normal.x *= -1;
+            normals.push_back(normal);
+        }
+        else if (identifier == "f") {
+            VertexData triangle[3];
+            for (int32_t faceVertex = 0; faceVertex < 3; ++faceVertex) {
+                std::string vertexDefinition;
+                s >> vertexDefinition;
+                std::istringstream v(vertexDefinition);
+                uint32_t elementIndices[3];
+                for (int32_t element = 0; element < 3; ++element) {
+                    std::string index;
+                    std::getline(v, index, '/');
+                    elementIndices[element] = std::stoi(index);
+                }
+                triangle[faceVertex] = { positions[elementIndices[0] - 1], texcoords[elementIndices[1] - 1], normals[elementIndices[2] - 1] };
+            }
+            vertices.push_back(triangle[2]);
+            vertices.push_back(triangle[1]);
+            vertices.push_back(triangle[0]);
+        }
+    }
+    return vertices;
+}
+
+void SetLabel(benchmark::State& state, const Input& input, size_t vertexCount) {
+    state.SetLabel(input.name + " vertices=" + std::to_string(vertexCount));
+}
+
+void BM_Legacy(benchmark::State& state) {
+    const Input& input = GetInputs()[state.range(0)];
+    size_t vertexCount = 0;
+    for (auto _ : state) {
+        std::vector<VertexData> vertices = ParseLegacy(input.text);
+        vertexCount = vertices.size();
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    SetLabel(state, input, vertexCount);
+    state.SetBytesProcessed(state.iterations() * input.text.size());
+}
+
+void BM_ObjFile(benchmark::State& state) {
+    const Input& input = GetInputs()[state.range(0)];
+    ObjFile objFile;
+    for (auto _ : state) {
+        objFile.Parse(input.text);
+        benchmark::DoNotOptimize(objFile.GetVertices().data());
+    }
+    SetLabel(state, input, objFile.GetVertices().size());
+    state.SetBytesProcessed(state.iterations() * input.text.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_Legacy)->Name("ObjParse/Legacy")->DenseRange(0, 4);
+BENCHMARK(BM_ObjFile)->Name("ObjParse/ObjFile")->DenseRange(0, 4);
@@ -0,0 +1,164 @@
+#include "ParticleForceField.h"
+#include "ParticleSimulation.h"
+#include "ParticleSpatialHash.h"
+#include "ParticlePool.h"
+#include "ParticleRandom.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+// 力場・衝突・パーティクル同士の反発の1フレームあたりのCPU時間
+// 反発は空間ハッシュの構築と近傍探索を分けて測り、全組を調べる方法（O(n^2)）とも比べる
+// パーティクルは数によらず密度が同じ（1立方単位あたり8個）になるよう箱の大きさを変えて配置する
+
+namespace {
+
+const float kDeltaTime = 1.0f / 60.0f;
+const float kDensity = 8.0f;
+
+ParticlePool MakePool(uint32_t count) {
+    float halfExtent = 0.5f * std::cbrt(static_cast<float>(count) / kDensity);
+    ParticleRandom random(1);
+    ParticlePool pool;
+    uint32_t first = pool.Append(count);
+    random.FillUniform(&pool.positionX[first], count, -halfExtent, halfExtent);
+    random.FillUniform(&pool.positionY[first], count, -halfExtent, halfExtent);
+    random.FillUniform(&pool.positionZ[first], count, -halfExtent, halfExtent);
+    random.FillUniform(&pool.velocityX[first], count, -1.0f, 1.0f);
+    random.FillUniform(&pool.velocityY[first], count, -1.0f, 1.0f);
+    random.FillUniform(&pool.velocityZ[first], count, -1.0f, 1.0f);
+    return pool;
+}
+
+ParticleRepulsion MakeRepulsion() {
+    ParticleRepulsion repulsion;
+    repulsion.isEnabled = true;
+    repulsion.radius = 0.5f;
+    repulsion.strength = 1.0f;
+    return repulsion;
+}
+
+// 空間ハッシュの構築
+void BM_SpatialHashBuild(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticlePool pool = MakePool(count);
+    ParticleRepulsion repulsion = MakeRepulsion();
+    ParticleSpatialHash hash;
+    for (auto _ : state) {
+        hash.Build(pool.positionX.data(), pool.positionY.data(), pool.positionZ.data(), count, repulsion.radius * 2.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 空間ハッシュを使った近傍探索と反発（構築済みのハッシュを使う）
+void BM_SpatialHashQuery(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticlePool pool = MakePool(count);
+    ParticleRepulsion repulsion = MakeRepulsion();
+    ParticleSpatialHash hash;
+    hash.Build(pool.positionX.data(), pool.positionY.data(), pool.positionZ.data(), count, repulsion.radius * 2.0f);
+    for (auto _ : state) {
+        ApplyRepulsion(repulsion, hash, pool, 0, count, kDeltaTime);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 比較用：全ての組の距離を調べる反発
+void BM_BruteForceRepulsion(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticlePool pool = MakePool(count);
+    ParticleRepulsion repulsion = MakeRepulsion();
+    float radius = repulsion.radius;
+    float radiusSq = radius * radius;
+    float scale = repulsion.strength * kDeltaTime;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < count; ++i) {
+            float ax = 0.0f;
+            float ay = 0.0f;
+            float az = 0.0f;
+            for (uint32_t j = 0; j < count; ++j) {
+                float dx = pool.positionX[i] - pool.positionX[j];
+                float dy = pool.positionY[i] - pool.positionY[j];
+                float dz = pool.positionZ[i] - pool.positionZ[j];
+                float distanceSq = dx * dx + dy * dy + dz * dz;
+                if (j == i || distanceSq >= radiusSq || distanceSq < 1.0e-8f) {
+                    continue;
+                }
+                float distance = std::sqrt(distanceSq);
+                float weight = (1.0f - distance / radius) / distance;
+                ax += dx * weight;
+                ay += dy * weight;
+                az += dz * weight;
+            }
+            pool.velocityX[i] += ax * scale;
+            pool.velocityY[i] += ay * scale;
+            pool.velocityZ[i] += az * scale;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 力場（引力・渦・風を1つずつ）
+void BM_ForceFields(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticlePool pool = MakePool(count);
+    ParticleForceStage stage;
+    stage.attractors.push_back({ { 0.0f, 2.0f, 0.0f }, 4.0f, 8.0f });
+    stage.vortices.push_back({ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 3.0f, 0.0f });
+    stage.windVolumes.push_back({ { -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f }, { 2.0f, 0.0f, 1.0f }, 0.5f });
+    for (auto _ : state) {
+        ApplyForceFields(stage, pool, 0, count, kDeltaTime);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 衝突（平面と球を1つずつ）
+void BM_Colliders(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticlePool pool = MakePool(count);
+    ParticleForceStage stage;
+    stage.planeColliders.push_back({ { 0.0f, 1.0f, 0.0f }, -2.0f, 0.5f, 0.1f });
+    stage.sphereColliders.push_back({ { 1.0f, 0.0f, 1.0f }, 2.0f, 0.3f, 0.2f });
+    for (auto _ : state) {
+        ApplyColliders(stage, pool, 0, count);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 反発を有効にした1ステップ全体（JobSystemのワーカーなし）
+void BM_SimulateWithRepulsion(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticlePool source = MakePool(count);
+    ParticleRandom random(2);
+    random.FillUniform(source.lifeTimeMax.data(), count, 1000.0f, 2000.0f);
+    ParticleForceStage stage;
+    stage.repulsion = MakeRepulsion();
+    ParticleSpatialHash hash;
+    float buildMilliseconds = 0.0f;
+    float repulsionMilliseconds = 0.0f;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ParticlePool pool = source;
+        state.ResumeTiming();
+        ParticleSimulationTimings timings = SimulateParticles(pool, ParticleLifetimeCurves(), stage, hash, kDeltaTime, 1);
+        buildMilliseconds += timings.spatialHashBuildMilliseconds;
+        repulsionMilliseconds += timings.repulsionMilliseconds;
+    }
+    // SimulateParticlesが記録する内訳（1フレームあたり）
+    state.counters["build_ms"] = buildMilliseconds / static_cast<float>(state.iterations());
+    state.counters["repulsion_ms"] = repulsionMilliseconds / static_cast<float>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+BENCHMARK(BM_SpatialHashBuild)->Name("Particle/Repulsion/HashBuild")->Arg(10000)->Arg(30000)->Arg(100000);
+BENCHMARK(BM_SpatialHashQuery)->Name("Particle/Repulsion/HashQuery")->Arg(10000)->Arg(30000)->Arg(100000);
+BENCHMARK(BM_BruteForceRepulsion)->Name("Particle/Repulsion/BruteForce")->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ForceFields)->Name("Particle/ForceFields")->Arg(10000)->Arg(100000);
+BENCHMARK(BM_Colliders)->Name("Particle/Colliders")->Arg(10000)->Arg(100000);
+BENCHMARK(BM_SimulateWithRepulsion)->Name("Particle/Simulate/Repulsion")->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
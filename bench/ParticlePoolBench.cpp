@@ -0,0 +1,154 @@
+#include "ParticlePool.h"
+#include "ParticleKernel.h"
+#include "ParticleRandom.h"
+#include <benchmark/benchmark.h>
+#include <list>
+#include <vector>
+
+// パーティクルの保持方法の比較（以前のstd::list<Particle>と、属性ごとの連続配列のParticlePool）
+// 1フレーム分の更新（積分・寿命が尽きたものの削除）と、減った分の発生を繰り返す時間を測る
+
+namespace {
+
+const float kDeltaTime = 1.0f / 60.0f;
+
+// 発生時のパーティクル（寿命1～3秒なので毎フレーム1%程度が入れ替わる）
+Particle MakeParticle(ParticleRandom& random) {
+    Particle particle;
+    particle.position = { random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f) };
+    particle.velocity = { random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f) };
+    particle.accel = { 0.0f, random.NextFloat(-9.8f, 0.0f), 0.0f };
+    particle.startSize = random.NextFloat(0.5f, 1.0f);
+    particle.endSize = 0.0f;
+    particle.size = particle.startSize;
+    particle.startColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+    particle.endColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+    particle.color = particle.startColor;
+    particle.rotation = 0.0f;
+    particle.rotationVelocity = random.NextFloat(-1.0f, 1.0f);
+    particle.lifeTime = 0.0f;
+    particle.lifeTimeMax = random.NextFloat(1.0f, 3.0f);
+    return particle;
+}
+
+// 以前の実装：リストの要素を1つずつ更新し、寿命が尽きたものはeraseする
+void BM_ListUpdate(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticleRandom random(1);
+    std::list<Particle> particles;
+    for (uint32_t i = 0; i < count; ++i) {
+        particles.push_back(MakeParticle(random));
+    }
+
+    for (auto _ : state) {
+        for (auto it = particles.begin(); it != particles.end(); ) {
+            it->lifeTime += kDeltaTime;
+            if (it->lifeTime >= it->lifeTimeMax) {
+                it = particles.erase(it);
+                continue;
+            }
+            it->velocity.x += it->accel.x * kDeltaTime;
+            it->velocity.y += it->accel.y * kDeltaTime;
+            it->velocity.z += it->accel.z * kDeltaTime;
+            it->position.x += it->velocity.x * kDeltaTime;
+            it->position.y += it->velocity.y * kDeltaTime;
+            it->position.z += it->velocity.z * kDeltaTime;
+            it->rotation += it->rotationVelocity * kDeltaTime;
+            float t = it->lifeTime / it->lifeTimeMax;
+            it->size = (1.0f - t) * it->startSize + t * it->endSize;
+            it->color.x = (1.0f - t) * it->startColor.x + t * it->endColor.x;
+            it->color.y = (1.0f - t) * it->startColor.y + t * it->endColor.y;
+            it->color.z = (1.0f - t) * it->startColor.z + t * it->endColor.z;
+            it->color.w = (1.0f - t) * it->startColor.w + t * it->endColor.w;
+            ++it;
+        }
+        // 減った分を発生させて数を保つ
+        while (particles.size() < count) {
+            particles.push_back(MakeParticle(random));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// a += b * scale
+void AddScaled(float* a, const float* b, float scale, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        a[i] += b[i] * scale;
+    }
+}
+
+// out = (1 - t) * from + t * to
+void Lerp(float* out, const float* from, const float* to, const float* t, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = (1.0f - t[i]) * from[i] + t[i] * to[i];
+    }
+}
+
+// 連続配列をSIMDカーネルを使わない素直なループで更新する
+// 1粒ずつ全属性を更新するループは、28本の配列を同時に読み書きするのでポインタがレジスタに収まらずベクトル化もされず、
+// 寿命の判定で分岐してその場でKillすると全属性配列の先頭と要素数を毎回読み直すことになる（std::listより遅かった）
+// 属性ごとにループを分けて数本の配列だけを順に読み書きし、寿命が尽きたものは最後にKillExpiredでまとめて削除する
+void BM_PoolUpdate(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticleRandom random(1);
+    ParticlePool pool;
+    pool.Reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        pool.Add(MakeParticle(random));
+    }
+    std::vector<float> t(count);
+
+    for (auto _ : state) {
+        uint32_t n = pool.Size();
+        for (uint32_t i = 0; i < n; ++i) {
+            pool.lifeTime[i] += kDeltaTime;
+            t[i] = pool.lifeTime[i] / pool.lifeTimeMax[i];
+        }
+        AddScaled(pool.velocityX.data(), pool.accelX.data(), kDeltaTime, n);
+        AddScaled(pool.velocityY.data(), pool.accelY.data(), kDeltaTime, n);
+        AddScaled(pool.velocityZ.data(), pool.accelZ.data(), kDeltaTime, n);
+        AddScaled(pool.positionX.data(), pool.velocityX.data(), kDeltaTime, n);
+        AddScaled(pool.positionY.data(), pool.velocityY.data(), kDeltaTime, n);
+        AddScaled(pool.positionZ.data(), pool.velocityZ.data(), kDeltaTime, n);
+        AddScaled(pool.rotation.data(), pool.rotationVelocity.data(), kDeltaTime, n);
+        Lerp(pool.size.data(), pool.startSize.data(), pool.endSize.data(), t.data(), n);
+        Lerp(pool.colorR.data(), pool.startColorR.data(), pool.endColorR.data(), t.data(), n);
+        Lerp(pool.colorG.data(), pool.startColorG.data(), pool.endColorG.data(), t.data(), n);
+        Lerp(pool.colorB.data(), pool.startColorB.data(), pool.endColorB.data(), t.data(), n);
+        Lerp(pool.colorA.data(), pool.startColorA.data(), pool.endColorA.data(), t.data(), n);
+        pool.KillExpired();
+        while (pool.Size() < count) {
+            pool.Add(MakeParticle(random));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// 現在の実装：SIMDカーネルで全体を積分してから、寿命が尽きたものをまとめて削除する
+void BM_PoolKernel(benchmark::State& state) {
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    ParticleRandom random(1);
+    ParticlePool pool;
+    pool.Reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        pool.Add(MakeParticle(random));
+    }
+
+    for (auto _ : state) {
+        IntegrateParticles(pool, 0, pool.Size(), kDeltaTime);
+        pool.KillExpired();
+        while (pool.Size() < count) {
+            pool.Add(MakeParticle(random));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+BENCHMARK(BM_ListUpdate)->Name("Particle/Storage/List")->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PoolUpdate)->Name("Particle/Storage/Pool")->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PoolKernel)->Name("Particle/Storage/PoolKernel")->Arg(1000)->Arg(10000)->Arg(100000);
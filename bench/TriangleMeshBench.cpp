@@ -0,0 +1,189 @@
+#include "TriangleMesh.h"
+#include "ObjFile.h"
+#include "ParticleRandom.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 三角形メッシュへのレイキャストの処理量（rays/s）
+// 1本ずつのRaycast・RaycastAnyと、4本ずつのRaycastPacket・RaycastAnyPacketを比べる
+// メッシュはResourcesの球（960面）と、ステージを想定した起伏のある格子（256x256マス、131072三角形）
+// レイは画面のピクセルのように並んだ向きのそろったもの（ピッキング）と、位置も向きもばらばらなもの（射線）
+
+namespace {
+
+const float kMaxDistance = 1000.0f;
+const uint32_t kRaysPerSide = 64;
+
+// 読み込んだOBJの三角形の頂点位置
+std::vector<Vector3> LoadObjPositions(const char* filePath) {
+    ObjFile objFile;
+    bool isLoaded = objFile.Load(filePath);
+    (void)isLoaded;
+    std::vector<Vector3> positions;
+    for (const VertexData& vertex : objFile.GetVertices()) {
+        positions.push_back({ vertex.position.x, vertex.position.y, vertex.position.z });
+    }
+    return positions;
+}
+
+// 高さ y = sin(x) * cos(z) の格子（四角形ごとに2枚の三角形）
+std::vector<Vector3> MakeGridPositions(uint32_t cellCount) {
+    auto makePosition = [cellCount](uint32_t x, uint32_t z) {
+        float px = static_cast<float>(x) / static_cast<float>(cellCount) * 40.0f;
+        float pz = static_cast<float>(z) / static_cast<float>(cellCount) * 40.0f;
+        return Vector3{ px, std::sin(px) * std::cos(pz), pz };
+    };
+    std::vector<Vector3> positions;
+    for (uint32_t z = 0; z < cellCount; ++z) {
+        for (uint32_t x = 0; x < cellCount; ++x) {
+            positions.push_back(makePosition(x, z));
+            positions.push_back(makePosition(x, z + 1));
+            positions.push_back(makePosition(x + 1, z));
+            positions.push_back(makePosition(x + 1, z));
+            positions.push_back(makePosition(x, z + 1));
+            positions.push_back(makePosition(x + 1, z + 1));
+        }
+    }
+    return positions;
+}
+
+Vector3 Normalize3(const Vector3& v) {
+    float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    return { v.x / length, v.y / length, v.z / length };
+}
+
+// ベンチマークに使うメッシュとレイ
+struct Scene {
+    TriangleMesh mesh;
+    // 手前上方の1点から、メッシュのAABBのxz範囲を覆う格子点へ向かうレイ（行ごとに並ぶ）
+    std::vector<Ray> coherentRays;
+    // AABBを2倍に広げた範囲の点から、ばらばらな向きに飛ぶレイ
+    std::vector<Ray> randomRays;
+};
+
+Scene MakeScene(const std::vector<Vector3>& positions) {
+    Scene scene;
+    scene.mesh.Build(positions);
+
+    AABB aabb = MakeAABB(positions);
+    Vector3 center = GetAABBCenter(aabb);
+    Vector3 extent = GetAABBExtent(aabb);
+    float size = std::fmax(extent.x, std::fmax(extent.y, extent.z));
+
+    Vector3 eye = { center.x, center.y + size * 1.5f, center.z - size * 3.0f };
+    for (uint32_t row = 0; row < kRaysPerSide; ++row) {
+        for (uint32_t column = 0; column < kRaysPerSide; ++column) {
+            float u = (static_cast<float>(column) + 0.5f) / kRaysPerSide * 2.0f - 1.0f;
+            float v = (static_cast<float>(row) + 0.5f) / kRaysPerSide * 2.0f - 1.0f;
+            Vector3 target = { center.x + u * extent.x * 1.2f, center.y, center.z + v * extent.z * 1.2f };
+            scene.coherentRays.push_back({ eye, Normalize3({ target.x - eye.x, target.y - eye.y, target.z - eye.z }) });
+        }
+    }
+
+    ParticleRandom random(1);
+    for (uint32_t i = 0; i < kRaysPerSide * kRaysPerSide; ++i) {
+        Vector3 origin = {
+            center.x + random.NextFloat(-2.0f, 2.0f) * extent.x,
+            center.y + random.NextFloat(-2.0f, 2.0f) * extent.y,
+            center.z + random.NextFloat(-2.0f, 2.0f) * extent.z,
+        };
+        Vector3 direction;
+        do {
+            direction = { random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f) };
+        } while (direction.x * direction.x + direction.y * direction.y + direction.z * direction.z < 0.01f);
+        scene.randomRays.push_back({ origin, Normalize3(direction) });
+    }
+    return scene;
+}
+
+// range(0): 0なら球、1なら格子
+const Scene& GetScene(int64_t meshIndex) {
+    static const Scene sphere = MakeScene(LoadObjPositions(ENGINE_RESOURCE_DIR "/Models/sphere.obj"));
+    static const Scene grid = MakeScene(MakeGridPositions(256));
+    return meshIndex == 0 ? sphere : grid;
+}
+
+// range(1): 0なら向きのそろったレイ、1ならばらばらなレイ
+const std::vector<Ray>& GetRays(const benchmark::State& state) {
+    const Scene& scene = GetScene(state.range(0));
+    return state.range(1) == 0 ? scene.coherentRays : scene.randomRays;
+}
+
+void SetLabel(benchmark::State& state, uint32_t hitCount) {
+    const Scene& scene = GetScene(state.range(0));
+    state.SetLabel(std::string(state.range(0) == 0 ? "sphere" : "grid") + "(" +
+        std::to_string(scene.mesh.GetTriangleCount()) + " tris) " + (state.range(1) == 0 ? "coherent" : "random") +
+        " hits=" + std::to_string(hitCount));
+}
+
+// 最も近い交点を1本ずつ求める
+void BM_Raycast(benchmark::State& state) {
+    const TriangleMesh& mesh = GetScene(state.range(0)).mesh;
+    const std::vector<Ray>& rays = GetRays(state);
+    std::vector<MeshRayHit> hits(rays.size());
+    uint32_t hitCount = 0;
+    for (auto _ : state) {
+        hitCount = 0;
+        for (size_t i = 0; i < rays.size(); ++i) {
+            hitCount += mesh.Raycast(rays[i], kMaxDistance, hits[i]) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hits.data());
+    }
+    SetLabel(state, hitCount);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+// 最も近い交点を4本ずつ求める
+void BM_RaycastPacket(benchmark::State& state) {
+    const TriangleMesh& mesh = GetScene(state.range(0)).mesh;
+    const std::vector<Ray>& rays = GetRays(state);
+    std::vector<MeshRayHit> hits(rays.size());
+    uint32_t hitCount = 0;
+    for (auto _ : state) {
+        hitCount = mesh.RaycastPacket(rays, kMaxDistance, hits);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    SetLabel(state, hitCount);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+// 遮蔽判定を1本ずつ行う
+void BM_RaycastAny(benchmark::State& state) {
+    const TriangleMesh& mesh = GetScene(state.range(0)).mesh;
+    const std::vector<Ray>& rays = GetRays(state);
+    uint32_t hitCount = 0;
+    for (auto _ : state) {
+        hitCount = 0;
+        for (const Ray& ray : rays) {
+            hitCount += mesh.RaycastAny(ray, kMaxDistance) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hitCount);
+    }
+    SetLabel(state, hitCount);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+// 遮蔽判定を4本ずつ行う
+void BM_RaycastAnyPacket(benchmark::State& state) {
+    const TriangleMesh& mesh = GetScene(state.range(0)).mesh;
+    const std::vector<Ray>& rays = GetRays(state);
+    // std::vector<bool>は連続した領域にならないので配列で確保する
+    std::unique_ptr<bool[]> isHits = std::make_unique<bool[]>(rays.size());
+    uint32_t hitCount = 0;
+    for (auto _ : state) {
+        hitCount = mesh.RaycastAnyPacket(rays, kMaxDistance, std::span<bool>(isHits.get(), rays.size()));
+        benchmark::DoNotOptimize(isHits.get());
+    }
+    SetLabel(state, hitCount);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_Raycast)->Name("TriangleMesh/Raycast")->ArgsProduct({ { 0, 1 }, { 0, 1 } });
+BENCHMARK(BM_RaycastPacket)->Name("TriangleMesh/RaycastPacket")->ArgsProduct({ { 0, 1 }, { 0, 1 } });
+BENCHMARK(BM_RaycastAny)->Name("TriangleMesh/RaycastAny")->ArgsProduct({ { 0, 1 }, { 0, 1 } });
+BENCHMARK(BM_RaycastAnyPacket)->Name("TriangleMesh/RaycastAnyPacket")->ArgsProduct({ { 0, 1 }, { 0, 1 } });
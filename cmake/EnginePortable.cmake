@@ -0,0 +1,60 @@
+# Windows・DirectX12に依存しないエンジンのソースを静的ライブラリにまとめる
+# テスト（tests/）とベンチマーク（bench/）からincludeして使う
+if(TARGET EnginePortable)
+    return()
+endif()
+
+set(ENGINE_SOURCE_DIR ${CMAKE_CURRENT_LIST_DIR}/../src/Engine)
+
+find_package(Threads REQUIRED)
+
+add_library(EnginePortable STATIC
+    # 数学
+    ${ENGINE_SOURCE_DIR}/Math/BoundingVolumeHierarchy.cpp
+    ${ENGINE_SOURCE_DIR}/Math/Bounds.cpp
+    ${ENGINE_SOURCE_DIR}/Math/FastMath.cpp
+    ${ENGINE_SOURCE_DIR}/Math/Frustum.cpp
+    ${ENGINE_SOURCE_DIR}/Math/MatrixSimd.cpp
+    ${ENGINE_SOURCE_DIR}/Math/Mymath.cpp
+    ${ENGINE_SOURCE_DIR}/Math/Quaternion.cpp
+    ${ENGINE_SOURCE_DIR}/Math/TransformBatch.cpp
+    ${ENGINE_SOURCE_DIR}/Math/TransformComponent.cpp
+    ${ENGINE_SOURCE_DIR}/Math/TriangleMesh.cpp
+    # ジョブシステム
+    ${ENGINE_SOURCE_DIR}/Core/JobSystem.cpp
+    # パーティクル（描画を行うParticleManager・ParticleEmitterを除く）
+    ${ENGINE_SOURCE_DIR}/Particle/BillboardTransform.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleCurve.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleDepthSort.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleForceField.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleKernel.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticlePool.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleRandom.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleSimulation.cpp
+    ${ENGINE_SOURCE_DIR}/Particle/ParticleSpatialHash.cpp
+    # メッシュの読み込み・最適化
+    ${ENGINE_SOURCE_DIR}/Graphics/MeshCache.cpp
+    ${ENGINE_SOURCE_DIR}/Graphics/MeshOptimizer.cpp
+    ${ENGINE_SOURCE_DIR}/Graphics/ObjFile.cpp
+    # ログ
+    ${ENGINE_SOURCE_DIR}/Utility/Logger.cpp
+)
+
+# エンジンのソースは同じフォルダにあるかのようにファイル名だけでincludeしている
+target_include_directories(EnginePortable PUBLIC
+    ${ENGINE_SOURCE_DIR}/Math
+    ${ENGINE_SOURCE_DIR}/Core
+    ${ENGINE_SOURCE_DIR}/Particle
+    ${ENGINE_SOURCE_DIR}/Graphics
+    ${ENGINE_SOURCE_DIR}/Utility
+)
+target_compile_features(EnginePortable PUBLIC cxx_std_20)
+target_link_libraries(EnginePortable PUBLIC Threads::Threads)
+
+# 領域分け用の#pragma regionはMSVC以外では警告になるので無視する
+if(NOT MSVC)
+    target_compile_options(EnginePortable PUBLIC -Wno-unknown-pragmas)
+endif()
+
+# リソースのフォルダ（テストやベンチマークでモデルを読み込む）
+set(ENGINE_RESOURCE_DIR ${CMAKE_CURRENT_LIST_DIR}/../Resources)
@@ -4,16 +4,26 @@
 // 静的メンバ変数の実体化
 Camera* Object3dCommon::defaultCamera_ = nullptr;
 
+namespace {
+// ビュープロジェクション行列の更新番号（破棄したカメラと同じアドレスに作られても番号が重ならないよう全カメラで共通）
+uint32_t viewProjectionVersionCounter = 0;
+}
+
 Camera::Camera() :
     fovY_(0.45f),
     aspectRatio_(16.0f / 9.0f),
     nearClip_(0.1f),
-    farClip_(100.0f)
+    farClip_(100.0f),
+    projectionType_(ProjectionType::kPerspective),
+    orthographicWidth_(16.0f),
+    orthographicHeight_(9.0f),
+    isReverseZ_(false),
+    isInfiniteFar_(false),
+    isProjectionDirty_(true),
+    viewProjectionVersion_(0)
 {
-    // トランスフォームの初期設定
-    transform_.scale = { 1.0f, 1.0f, 1.0f };
-    transform_.rotate = { 0.0f, 0.0f, 0.0f };
-    transform_.translate = { 0.0f, 0.0f, -5.0f };
+    // トランスフォームの初期設定（スケール1・回転0はTransformComponentの初期値）
+    transform_.SetTranslate({ 0.0f, 0.0f, -5.0f });
 
     // 初期更新
     Update();
@@ -27,44 +37,102 @@ Camera::~Camera() {
 }
 
 void Camera::Update() {
-    // ワールド行列の計算
-    worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+    bool isChanged = false;
 
-    // ビュー行列の計算（ワールド行列の逆行列）
-    viewMatrix_ = Inverse(worldMatrix_);
+    // トランスフォームが変わったときだけワールド行列とビュー行列を作り直す
+    if (transform_.IsDirty()) {
+        // ワールド行列の計算
+        worldMatrix_ = transform_.GetWorldMatrix();
+
+        // ビュー行列の計算（ワールド行列の逆行列、アフィン行列なので専用の逆行列を使う）
+        viewMatrix_ = InverseAffine(worldMatrix_);
+        isChanged = true;
+    }
 
-    // プロジェクション行列の計算
-    projectionMatrix_ = MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_);
+    // 投影の設定が変わったときだけプロジェクション行列を作り直す
+    if (isProjectionDirty_) {
+        if (projectionType_ == ProjectionType::kOrthographic) {
+            float halfWidth = orthographicWidth_ * 0.5f;
+            float halfHeight = orthographicHeight_ * 0.5f;
+            projectionMatrix_ = isReverseZ_ ?
+                MakeOrthographicMatrixReverseZ(-halfWidth, halfHeight, halfWidth, -halfHeight, nearClip_, farClip_) :
+                MakeOrthographicMatrix(-halfWidth, halfHeight, halfWidth, -halfHeight, nearClip_, farClip_);
+        } else if (isInfiniteFar_) {
+            projectionMatrix_ = isReverseZ_ ?
+                MakePerspectiveFovMatrixInfiniteReverseZ(fovY_, aspectRatio_, nearClip_) :
+                MakePerspectiveFovMatrixInfinite(fovY_, aspectRatio_, nearClip_);
+        } else {
+            projectionMatrix_ = isReverseZ_ ?
+                MakePerspectiveFovMatrixReverseZ(fovY_, aspectRatio_, nearClip_, farClip_) :
+                MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_);
+        }
+        inverseProjectionMatrix_ = Inverse(projectionMatrix_);
+        isProjectionDirty_ = false;
+        isChanged = true;
+    }
 
     // ビュープロジェクション行列の計算
-    viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
+    if (isChanged) {
+        viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
+        // (V * P)^-1 = P^-1 * V^-1 で、V^-1はワールド行列
+        inverseViewProjectionMatrix_ = Multiply(inverseProjectionMatrix_, worldMatrix_);
+        viewProjectionVersion_ = ++viewProjectionVersionCounter;
+
+        // カリング用の視錐台
+        frustum_ = MakeFrustum(viewProjectionMatrix_);
+    }
 }
 
 // セッター
 void Camera::SetRotate(const Vector3& rotate) {
-    transform_.rotate = rotate;
+    transform_.SetRotate(rotate);
 }
 
 void Camera::SetTranslate(const Vector3& translate) {
-    transform_.translate = translate;
+    transform_.SetTranslate(translate);
 }
 
 void Camera::SetFovY(float fovY) {
+    isProjectionDirty_ |= fovY_ != fovY;
     fovY_ = fovY;
 }
 
 void Camera::SetAspectRatio(float aspectRatio) {
+    isProjectionDirty_ |= aspectRatio_ != aspectRatio;
     aspectRatio_ = aspectRatio;
 }
 
 void Camera::SetNearClip(float nearClip) {
+    isProjectionDirty_ |= nearClip_ != nearClip;
     nearClip_ = nearClip;
 }
 
 void Camera::SetFarClip(float farClip) {
+    isProjectionDirty_ |= farClip_ != farClip;
     farClip_ = farClip;
 }
 
+void Camera::SetProjectionType(ProjectionType projectionType) {
+    isProjectionDirty_ |= projectionType_ != projectionType;
+    projectionType_ = projectionType;
+}
+
+void Camera::SetOrthographicSize(float width, float height) {
+    isProjectionDirty_ |= orthographicWidth_ != width || orthographicHeight_ != height;
+    orthographicWidth_ = width;
+    orthographicHeight_ = height;
+}
+
+void Camera::SetReverseZ(bool isReverseZ) {
+    isProjectionDirty_ |= isReverseZ_ != isReverseZ;
+    isReverseZ_ = isReverseZ;
+}
+
+void Camera::SetInfiniteFar(bool isInfiniteFar) {
+    isProjectionDirty_ |= isInfiniteFar_ != isInfiniteFar;
+    isInfiniteFar_ = isInfiniteFar;
+}
+
 // ゲッター
 const Matrix4x4& Camera::GetWorldMatrix() const {
     return worldMatrix_;
@@ -83,11 +151,11 @@ const Matrix4x4& Camera::GetViewProjectionMatrix() const {
 }
 
 const Vector3& Camera::GetRotate() const {
-    return transform_.rotate;
+    return transform_.GetRotate();
 }
 
 const Vector3& Camera::GetTranslate() const {
-    return transform_.translate;
+    return transform_.GetTranslate();
 }
 
 float Camera::GetFovY() const {
@@ -106,6 +174,33 @@ float Camera::GetFarClip() const {
     return farClip_;
 }
 
+Ray Camera::ScreenPointToRay(const Vector2& screenPosition, float screenWidth, float screenHeight) const {
+    // スクリーン座標から正規化デバイス座標へ（Yは上向き）
+    float ndcX = screenPosition.x / screenWidth * 2.0f - 1.0f;
+    float ndcY = 1.0f - screenPosition.y / screenHeight * 2.0f;
+    // ニアクリップ面の深度
+    float nearDepth = isReverseZ_ ? 1.0f : 0.0f;
+
+    // ニアクリップ面上の点をビュー空間に戻す
+    const Matrix4x4& m = inverseProjectionMatrix_;
+    Vector3 nearPoint = {
+        ndcX * m.m[0][0] + ndcY * m.m[1][0] + nearDepth * m.m[2][0] + m.m[3][0],
+        ndcX * m.m[0][1] + ndcY * m.m[1][1] + nearDepth * m.m[2][1] + m.m[3][1],
+        ndcX * m.m[0][2] + ndcY * m.m[1][2] + nearDepth * m.m[2][2] + m.m[3][2],
+    };
+    float w = ndcX * m.m[0][3] + ndcY * m.m[1][3] + nearDepth * m.m[2][3] + m.m[3][3];
+    nearPoint /= w;
+
+    // 透視投影ならカメラの位置からその点へ、正射影なら視線方向へ進む
+    Vector3 direction = projectionType_ == ProjectionType::kOrthographic ? Vector3{ 0.0f, 0.0f, 1.0f } : nearPoint;
+
+    Ray ray;
+    ray.origin = TransformPoint(nearPoint, worldMatrix_);
+    ray.direction = TransformVector(direction, worldMatrix_);
+    ray.direction /= std::sqrt(Dot(ray.direction, ray.direction));
+    return ray;
+}
+
 // デフォルトカメラの設定・取得
 void Object3dCommon::SetDefaultCamera(Camera* camera) {
     defaultCamera_ = camera;
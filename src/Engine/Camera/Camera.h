@@ -2,15 +2,24 @@
 #include "Vector3.h"
 #include "Matrix4x4.h"
 #include "Mymath.h"
+#include "TransformComponent.h"
+#include "Frustum.h"
+#include "Bounds.h"
 
 // カメラクラス - 3Dオブジェクトからカメラ機能を分離
 class Camera {
 public:
+    // 投影の種類
+    enum class ProjectionType {
+        kPerspective,  // 透視投影
+        kOrthographic, // 正射影
+    };
+
     // コンストラクタ・デストラクタ
     Camera();
     ~Camera();
 
-    // 更新処理 - 毎フレーム行列を更新する
+    // 更新処理 - 毎フレーム呼ぶが、行列は値が変わったものだけ作り直す
     void Update();
 
     // セッター
@@ -20,22 +29,45 @@ public:
     void SetAspectRatio(float aspectRatio);
     void SetNearClip(float nearClip);
     void SetFarClip(float farClip);
+    void SetProjectionType(ProjectionType projectionType);
+    // 正射影で映す範囲の幅と高さ（カメラの位置が中心になる）
+    void SetOrthographicSize(float width, float height);
+    // reverse-Z（ニアクリップで深度1・ファークリップで深度0）にするか
+    // 深度のクリア値と比較関数も逆にする必要があるので、DirectXCommon::SetReverseZと合わせて設定すること
+    void SetReverseZ(bool isReverseZ);
+    // ファークリップをなくすか（透視投影のときだけ有効、reverse-Zと組み合わせると遠くまで精度が落ちにくい）
+    void SetInfiniteFar(bool isInfiniteFar);
 
     // ゲッター
     const Matrix4x4& GetWorldMatrix() const;
     const Matrix4x4& GetViewMatrix() const;
     const Matrix4x4& GetProjectionMatrix() const;
     const Matrix4x4& GetViewProjectionMatrix() const;
+    // 逆行列（行列を作り直すときに一緒に求めておく）
+    const Matrix4x4& GetInverseViewMatrix() const { return worldMatrix_; }
+    const Matrix4x4& GetInverseProjectionMatrix() const { return inverseProjectionMatrix_; }
+    const Matrix4x4& GetInverseViewProjectionMatrix() const { return inverseViewProjectionMatrix_; }
+    const Frustum& GetFrustum() const { return frustum_; }
     const Vector3& GetRotate() const;
     const Vector3& GetTranslate() const;
     float GetFovY() const;
     float GetAspectRatio() const;
     float GetNearClip() const;
     float GetFarClip() const;
+    ProjectionType GetProjectionType() const { return projectionType_; }
+    bool IsReverseZ() const { return isReverseZ_; }
+    bool IsInfiniteFar() const { return isInfiniteFar_; }
+
+    // スクリーン座標（左上原点のピクセル）を通るワールド空間のレイ（ニアクリップ面から奥へ向かう、方向は正規化済み）
+    // マウスでの選択に使う
+    Ray ScreenPointToRay(const Vector2& screenPosition, float screenWidth, float screenHeight) const;
+
+    // ビュープロジェクション行列の更新番号（作り直すたびに変わる）
+    uint32_t GetViewProjectionVersion() const { return viewProjectionVersion_; }
 
 private:
     // ビュー行列関連データ
-    Transform transform_;       // カメラのトランスフォーム
+    TransformComponent transform_; // カメラのトランスフォーム
     Matrix4x4 worldMatrix_;     // カメラのワールド行列
     Matrix4x4 viewMatrix_;      // ビュー行列
 
@@ -45,9 +77,21 @@ private:
     float aspectRatio_;         // アスペクト比
     float nearClip_;            // ニアクリップ距離
     float farClip_;             // ファークリップ距離
+    ProjectionType projectionType_; // 投影の種類
+    float orthographicWidth_;   // 正射影の幅
+    float orthographicHeight_;  // 正射影の高さ
+    bool isReverseZ_;           // reverse-Zか
+    bool isInfiniteFar_;        // ファークリップなしか
+    Matrix4x4 inverseProjectionMatrix_; // プロジェクション行列の逆行列
+    bool isProjectionDirty_;    // プロジェクション行列の作り直しが必要か
 
     // 合成行列 - ビュー行列とプロジェクション行列の積
     Matrix4x4 viewProjectionMatrix_;
+    Matrix4x4 inverseViewProjectionMatrix_; // ビュープロジェクション行列の逆行列
+    uint32_t viewProjectionVersion_; // ビュープロジェクション行列の更新番号
+
+    // 視錐台 - ビュープロジェクション行列を作り直すときに一緒に作る
+    Frustum frustum_;
 };
 
 // 静的なデフォルトカメラの定義
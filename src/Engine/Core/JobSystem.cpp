@@ -0,0 +1,204 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+// 現在のスレッドが使うキュー番号（メインスレッドは0番）
+thread_local uint32_t currentQueueIndex = 0;
+}
+
+#pragma region ワークスティーリングキュー
+void JobSystem::WorkQueue::Push(Job job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+}
+
+bool JobSystem::WorkQueue::Pop(Job& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jobs_.empty()) {
+        return false;
+    }
+    // 所有スレッドは直前に積んだジョブから処理する（キャッシュに残っている可能性が高い）
+    job = std::move(jobs_.back());
+    jobs_.pop_back();
+    return true;
+}
+
+bool JobSystem::WorkQueue::Steal(Job& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jobs_.empty()) {
+        return false;
+    }
+    // 他のスレッドは古いジョブ（大きな単位であることが多い）から盗む
+    job = std::move(jobs_.front());
+    jobs_.pop_front();
+    return true;
+}
+#pragma endregion
+
+JobSystem::~JobSystem() {
+    Finalize();
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+    // 二重初期化の防止
+    assert(workers_.empty());
+
+    // ワーカー数の決定（メインスレッドの分を差し引く）
+    if (workerCount == 0) {
+        uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+        workerCount = hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+    }
+
+    isStopping_ = false;
+    pendingJobCount_ = 0;
+
+    // キューの作成（0番はメインスレッド用）
+    queues_.clear();
+    for (uint32_t i = 0; i < workerCount + 1; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    // ワーカースレッドの起動
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+    }
+}
+
+void JobSystem::Finalize() {
+    if (workers_.empty()) {
+        return;
+    }
+
+    // 全ワーカーを起こして終了させる
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        isStopping_ = true;
+    }
+    sleepCondition_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    queues_.clear();
+}
+
+void JobSystem::WorkerMain(uint32_t queueIndex) {
+    currentQueueIndex = queueIndex;
+
+    while (!isStopping_) {
+        Job job;
+        if (FindJob(queueIndex, job)) {
+            job();
+            continue;
+        }
+
+        // ジョブがなければ投入されるまで眠る
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this]() {
+            return isStopping_ || pendingJobCount_ > 0;
+        });
+    }
+}
+
+bool JobSystem::FindJob(uint32_t queueIndex, Job& job) {
+    // まず自分のキューから取り出す
+    bool isFound = queues_[queueIndex]->Pop(job);
+
+    // 空なら他のキューから順に盗む
+    uint32_t queueCount = static_cast<uint32_t>(queues_.size());
+    for (uint32_t i = 1; !isFound && i < queueCount; ++i) {
+        isFound = queues_[(queueIndex + i) % queueCount]->Steal(job);
+    }
+
+    if (isFound) {
+        --pendingJobCount_;
+    }
+    return isFound;
+}
+
+uint32_t JobSystem::GetCurrentQueueIndex() const {
+    // ジョブシステム外のスレッドはメインスレッドのキューを使う
+    return currentQueueIndex < queues_.size() ? currentQueueIndex : 0;
+}
+
+void JobSystem::Submit(Job job, JobCounter* counter) {
+    if (counter) {
+        counter->fetch_add(1);
+    }
+
+    // ワーカーがいない場合はその場で実行する
+    if (workers_.empty()) {
+        job();
+        if (counter) {
+            counter->fetch_sub(1);
+        }
+        return;
+    }
+
+    // 積んだ直後に取り出されて減算が先に走ると0を下回るので、積む前に加算する
+    // （起床判定と競合しないようにロック中に加算する）
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++pendingJobCount_;
+    }
+
+    // 完了時にカウンタを減らすジョブとして積む
+    queues_[GetCurrentQueueIndex()]->Push([job = std::move(job), counter]() {
+        job();
+        if (counter) {
+            counter->fetch_sub(1);
+        }
+    });
+    sleepCondition_.notify_one();
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+    uint32_t queueIndex = GetCurrentQueueIndex();
+
+    // 待っている間も手伝うことで、ジョブ内からの入れ子の待機でも詰まらない
+    while (counter.load() > 0) {
+        Job job;
+        if (!queues_.empty() && FindJob(queueIndex, job)) {
+            job();
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const RangeJob& rangeJob) {
+    if (begin >= end) {
+        return;
+    }
+
+    uint32_t count = end - begin;
+    grainSize = (std::max)(grainSize, 1u);
+
+    // ワーカーがいない、または分割するほどの量がなければそのまま処理する
+    if (workers_.empty() || count <= grainSize) {
+        rangeJob(begin, end);
+        return;
+    }
+
+    // スレッド数の数倍に分割して負荷の偏りを盗み合いで吸収する
+    uint32_t targetChunkCount = (GetWorkerCount() + 1) * 4;
+    uint32_t chunkSize = (std::max)(grainSize, (count + targetChunkCount - 1) / targetChunkCount);
+    uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    // 先頭以外のチャンクをジョブとして投入
+    JobCounter counter = 0;
+    for (uint32_t chunk = 1; chunk < chunkCount; ++chunk) {
+        uint32_t chunkBegin = begin + chunk * chunkSize;
+        uint32_t chunkEnd = (std::min)(end, chunkBegin + chunkSize);
+        Submit([&rangeJob, chunkBegin, chunkEnd]() { rangeJob(chunkBegin, chunkEnd); }, &counter);
+    }
+
+    // 先頭のチャンクは呼び出したスレッドで処理する
+    rangeJob(begin, (std::min)(end, begin + chunkSize));
+
+    // 残りのチャンクの完了を待つ
+    Wait(counter);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ジョブの完了待ちに使うカウンタ（未完了のジョブ数）
+using JobCounter = std::atomic<uint32_t>;
+
+// ジョブシステムクラス
+// ワーカースレッドごとにジョブの両端キューを持ち、自分のキューが空になったら
+// 他のスレッドのキューからジョブを盗んで実行する（ワークスティーリング）
+class JobSystem {
+public:
+    // ジョブ本体
+    using Job = std::function<void()>;
+
+    // 範囲処理の本体（[begin, end)を処理する）
+    using RangeJob = std::function<void(uint32_t begin, uint32_t end)>;
+
+private:
+    // ワークスティーリング用の両端キュー
+    // 所有スレッドは末尾から取り出し、他のスレッドは先頭から盗む
+    class WorkQueue {
+    public:
+        // ジョブの追加（所有スレッド）
+        void Push(Job job);
+        // ジョブの取り出し（所有スレッド）
+        bool Pop(Job& job);
+        // ジョブを盗む（他のスレッド）
+        bool Steal(Job& job);
+
+    private:
+        std::mutex mutex_;
+        std::deque<Job> jobs_;
+    };
+
+    // ワーカースレッド
+    std::vector<std::thread> workers_;
+
+    // スレッドごとのキュー（0番はメインスレッド用）
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+    // 待機中のワーカーを起こすための同期オブジェクト
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+
+    // 実行待ちのジョブ数
+    std::atomic<uint32_t> pendingJobCount_ = 0;
+
+    // 終了フラグ
+    std::atomic<bool> isStopping_ = false;
+
+    // コピー禁止
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // コンストラクタ（シングルトン）
+    JobSystem() = default;
+    // デストラクタ
+    ~JobSystem();
+
+    // ワーカースレッドのメインループ
+    void WorkerMain(uint32_t queueIndex);
+
+    // 自分のキューまたは他のキューからジョブを1つ取得
+    bool FindJob(uint32_t queueIndex, Job& job);
+
+    // 現在のスレッドのキュー番号
+    uint32_t GetCurrentQueueIndex() const;
+
+public:
+    // シングルトンインスタンスの取得
+    static JobSystem* GetInstance() {
+        static JobSystem instance;
+        return &instance;
+    }
+
+    // 初期化（workerCountが0ならハードウェアスレッド数-1個のワーカーを作成）
+    void Initialize(uint32_t workerCount = 0);
+
+    // 終了処理（全ワーカーを停止して合流する）
+    void Finalize();
+
+    // ワーカー数の取得（メインスレッドを含まない）
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    // ジョブの投入（counterが指定されていれば完了時に減算される）
+    void Submit(Job job, JobCounter* counter = nullptr);
+
+    // カウンタが0になるまで待つ（待っている間もジョブを実行する）
+    void Wait(const JobCounter& counter);
+
+    // 範囲を分割して並列に処理する（grainSizeは1ジョブあたりの最小要素数）
+    // 呼び出したスレッドも処理に参加し、全範囲の処理が終わるまで戻らない
+    void ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const RangeJob& rangeJob);
+};
@@ -1,6 +1,7 @@
 #include "DirectXCommon.h"
 #include <cassert>
 #include <format>
+#include <algorithm>
 #pragma comment(lib,"d3d12.lib")
 #pragma comment(lib,"dxgi.lib")
 #include "Logger.h"
@@ -115,7 +116,7 @@ void DirectXCommon::DepthBufferInitialize()
 	resourceDesc.Height = WinApp::kClientHeight;//Textureの高さ
 	resourceDesc.MipLevels = 1;//mipmapの数
 	resourceDesc.DepthOrArraySize = 1;//奥行きor配列Textureの配列数
-	resourceDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;//DepthStencilとして利用可能なフォーマット
+	resourceDesc.Format = GetDepthFormat();//DepthStencilとして利用可能なフォーマット
 	resourceDesc.SampleDesc.Count = 1;//サンプリング。１固定
 	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;//2次元
 	resourceDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;//DepthStencilとして使う通知
@@ -124,8 +125,8 @@ void DirectXCommon::DepthBufferInitialize()
 	heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;//VRAM上に作る
 	//深度値のクリア設定
 	D3D12_CLEAR_VALUE depthClearValue{};
-	depthClearValue.DepthStencil.Depth = 1.0f;//最大値
-	depthClearValue.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;//フォーアット。Resource合わせる
+	depthClearValue.DepthStencil.Depth = GetDepthClearValue();//最も奥の値（通常は1、reverse-Zでは0）
+	depthClearValue.Format = GetDepthFormat();//フォーアット。Resource合わせる
 	//Resourceの生成
 	Microsoft::WRL::ComPtr<ID3D12Resource> resource = nullptr;
 	hr = device->CreateCommittedResource(
@@ -179,7 +180,7 @@ void DirectXCommon::RTVInitialize()
 void DirectXCommon::DSVInitialize()
 {
 	D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc{};
-	dsvDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;//Format
+	dsvDesc.Format = GetDepthFormat();//Format
 	dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;//2Dtexture
 	//DSHeapの先頭にDSVを作る
 	device->CreateDepthStencilView(depthStencilResource.Get(),
@@ -292,7 +293,7 @@ void DirectXCommon::Begin()
 	commandList->OMSetRenderTargets(1, &rtvHandles[backBufferIndex], false, nullptr);
 	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = dsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
 	commandList->OMSetRenderTargets(1, &rtvHandles[backBufferIndex], false, &dsvHandle);
-	commandList->ClearDepthStencilView(dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+	commandList->ClearDepthStencilView(dsvHandle, D3D12_CLEAR_FLAG_DEPTH, GetDepthClearValue(), 0, 0, nullptr);
 	//指定した色で画面全体をクリアする
 	// 背景色を黒に変更
 	float clearColor[] = { 0.1f,0.25f,0.5f,1.0f };	//青っぽい色。RGBAの順
@@ -408,8 +409,12 @@ void DirectXCommon::UpdateFixFPS()
 			std::this_thread::sleep_for(std::chrono::microseconds(1));
 		}
 	}
+	//前フレームからの経過時間を記録する（ブレークポイント等で止まった後は上限で打ち切る）
+	const float kMaxDeltaTime = 0.1f;
+	std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+	deltaTime_ = (std::min)(std::chrono::duration<float>(frameEnd - reference_).count(), kMaxDeltaTime);
 	//現在の時間を記録をする
-	reference_ = std::chrono::steady_clock::now();
+	reference_ = frameEnd;
 }
 
 
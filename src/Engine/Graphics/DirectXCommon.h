@@ -15,6 +15,7 @@
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <cassert>
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 
@@ -34,6 +35,17 @@ class DirectXCommon
 	void ImguiInitialize();
 
 public:
+	//reverse-Z（手前ほど深度が大きい）にするか。深度バッファを作るInitializeより前に呼ぶ
+	//reverse-Zでは精度を生かすため深度バッファを浮動小数点にし、クリア値を0・比較関数をGreaterEqualにする
+	void SetReverseZ(bool isReverseZ) { assert(!device); isReverseZ_ = isReverseZ; }
+	bool IsReverseZ() const { return isReverseZ_; }
+	//深度バッファのフォーマット（PSOのDSVFormatに使う）
+	DXGI_FORMAT GetDepthFormat() const { return isReverseZ_ ? DXGI_FORMAT_D32_FLOAT_S8X24_UINT : DXGI_FORMAT_D24_UNORM_S8_UINT; }
+	//深度のクリア値（最も奥）
+	float GetDepthClearValue() const { return isReverseZ_ ? 0.0f : 1.0f; }
+	//手前にあるものを優先する深度の比較関数
+	D3D12_COMPARISON_FUNC GetDepthComparisonFunc() const { return isReverseZ_ ? D3D12_COMPARISON_FUNC_GREATER_EQUAL : D3D12_COMPARISON_FUNC_LESS_EQUAL; }
+
 	//初期化
 	void Initialize(WinApp* winApp);
 	//描画前処理
@@ -77,6 +89,9 @@ public:
 		return depthStencilDesc;
 	}
 
+	//前フレームからの経過時間（秒）。止まっていた後に巨大な値にならないよう上限を設ける
+	float GetDeltaTime() const { return deltaTime_; }
+
 private:
 	//WindowsAPI
 	WinApp* winApp_ = nullptr;
@@ -118,8 +133,12 @@ private:
 	D3D12_RESOURCE_BARRIER barrier{};
 
 	std::chrono::steady_clock::time_point reference_;
+	//前フレームからの経過時間（秒）
+	float deltaTime_ = 1.0f / 60.0f;
 
 	D3D12_DEPTH_STENCIL_DESC depthStencilDesc{};
+	//reverse-Zか
+	bool isReverseZ_ = false;
 
 
 private:
@@ -0,0 +1,440 @@
+#include "MeshCache.h"
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include "Logger.h"
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ファイル先頭のヘッダー
+struct MeshCache::Header {
+    char magic[4];
+    uint32_t version;
+    // sizeof(VertexData)（構造体が変わったキャッシュを読まないため）
+    uint32_t vertexStride;
+    uint32_t sourceCount;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t subMeshCount;
+    uint32_t materialCount;
+    uint32_t stringSize;
+    // 各領域のファイル先頭からの位置
+    uint64_t sourceOffset;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t subMeshOffset;
+    uint64_t materialOffset;
+    uint64_t stringOffset;
+    // ローカル空間での境界
+    AABB localAABB;
+    Sphere localBoundingSphere;
+};
+
+// 元ファイルの記録
+struct MeshCache::SourceRecord {
+    uint64_t size;
+    int64_t lastWriteTime;
+    uint64_t contentHash;
+    // パス（文字列領域の位置と長さ）
+    uint32_t pathOffset;
+    uint32_t pathLength;
+};
+
+// マテリアルの記録
+struct MeshCache::MaterialRecord {
+    Vector4 ambient;
+    Vector4 diffuse;
+    Vector4 specular;
+    float shininess;
+    float alpha;
+    // マテリアル名とテクスチャのパス（文字列領域の位置と長さ）
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t textureOffset;
+    uint32_t textureLength;
+};
+
+namespace
+{
+    // ファイルの識別子
+    const char kMagic[4] = { 'M', 'S', 'H', 'C' };
+    // 各領域の境界
+    const uint64_t kSectionAlignment = 16;
+
+    uint64_t AlignUp(uint64_t value) {
+        return (value + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+    }
+
+    // 8バイトずつ混ぜる64ビットのハッシュ（改変の検出用で、暗号学的な強さはない）
+    uint64_t HashBytes(const uint8_t* data, uint64_t size) {
+        const uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+        uint64_t hash = size ^ 0xCBF29CE484222325ull;
+        uint64_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * kMultiplier;
+            hash ^= hash >> 29;
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, data + i, static_cast<size_t>(size - i));
+        hash = (hash ^ tail) * kMultiplier;
+        return hash ^ (hash >> 32);
+    }
+
+    // ファイルを読み取り専用でメモリにマップする
+    bool MapFile(const std::string& path, const uint8_t*& outData, uint64_t& outSize, void*& outFile, void*& outMapping) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        outData = static_cast<const uint8_t*>(view);
+        outSize = static_cast<uint64_t>(fileSize.QuadPart);
+        outFile = file;
+        outMapping = mapping;
+        return true;
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(file, &status) != 0 || status.st_size == 0) {
+            close(file);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED) {
+            return false;
+        }
+        outData = static_cast<const uint8_t*>(view);
+        outSize = static_cast<uint64_t>(status.st_size);
+        outFile = nullptr;
+        outMapping = nullptr;
+        return true;
+#endif
+    }
+
+    // マップを解除する
+    void UnmapFile(const uint8_t* data, uint64_t size, void* file, void* mapping) {
+#if defined(_WIN32)
+        (void)size;
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+        CloseHandle(file);
+#else
+        (void)file;
+        (void)mapping;
+        munmap(const_cast<uint8_t*>(data), static_cast<size_t>(size));
+#endif
+    }
+
+    // 書き込み用のバッファに値を追加する
+    template<typename T>
+    void Append(std::vector<uint8_t>& buffer, const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T) * count);
+        if (count > 0) {
+            std::memcpy(buffer.data() + offset, values, sizeof(T) * count);
+        }
+    }
+
+    // 16バイト境界まで0で埋める
+    void Pad(std::vector<uint8_t>& buffer) {
+        buffer.resize(static_cast<size_t>(AlignUp(buffer.size())), 0);
+    }
+
+    // 領域がファイルに収まっているか
+    bool IsSectionInFile(uint64_t offset, uint64_t count, uint64_t stride, uint64_t fileSize) {
+        return offset % 4 == 0 && offset <= fileSize && count <= (fileSize - offset) / stride;
+    }
+}
+
+MeshCache::~MeshCache() {
+    Close();
+}
+
+std::string MeshCache::GetCachePath(const std::string& sourcePath) {
+    return sourcePath + ".meshcache";
+}
+
+bool MeshCache::Write(const std::string& cachePath, std::span<const std::string> sourcePaths, const Contents& contents) {
+    // 文字列領域（元ファイルのパス、マテリアル名、テクスチャのパス）
+    std::string strings;
+    auto addString = [&strings](const std::string& value, uint32_t& outOffset, uint32_t& outLength) {
+        outOffset = static_cast<uint32_t>(strings.size());
+        outLength = static_cast<uint32_t>(value.size());
+        strings += value;
+    };
+
+    std::vector<SourceRecord> sources(sourcePaths.size());
+    for (size_t i = 0; i < sourcePaths.size(); ++i) {
+        SourceRecord& record = sources[i];
+        if (!GetFileStamp(sourcePaths[i], record.size, record.lastWriteTime)) {
+            Logger::Log("WARNING: MeshCache: Source file not found - " + sourcePaths[i] + "\n");
+            return false;
+        }
+        record.contentHash = HashFile(sourcePaths[i]);
+        addString(sourcePaths[i], record.pathOffset, record.pathLength);
+    }
+
+    std::vector<MaterialRecord> materials(contents.materials.size());
+    for (size_t i = 0; i < contents.materials.size(); ++i) {
+        const MaterialData& material = contents.materials[i];
+        MaterialRecord& record = materials[i];
+        record.ambient = material.ambient;
+        record.diffuse = material.diffuse;
+        record.specular = material.specular;
+        record.shininess = material.shininess;
+        record.alpha = material.alpha;
+        addString(material.name, record.nameOffset, record.nameLength);
+        addString(material.textureFilePath, record.textureOffset, record.textureLength);
+    }
+
+    // ヘッダーと各領域を1つのバッファに並べる
+    Header header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.vertexStride = sizeof(VertexData);
+    header.sourceCount = static_cast<uint32_t>(sources.size());
+    header.vertexCount = static_cast<uint32_t>(contents.vertices.size());
+    header.indexCount = static_cast<uint32_t>(contents.indices.size());
+    header.subMeshCount = static_cast<uint32_t>(contents.subMeshes.size());
+    header.materialCount = static_cast<uint32_t>(materials.size());
+    header.stringSize = static_cast<uint32_t>(strings.size());
+    header.localAABB = contents.localAABB;
+    header.localBoundingSphere = contents.localBoundingSphere;
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve(static_cast<size_t>(AlignUp(sizeof(Header)) + AlignUp(sizeof(SourceRecord) * sources.size()) +
+        AlignUp(sizeof(VertexData) * contents.vertices.size()) + AlignUp(sizeof(uint32_t) * contents.indices.size()) +
+        AlignUp(sizeof(SubMeshData) * contents.subMeshes.size()) + AlignUp(sizeof(MaterialRecord) * materials.size()) + strings.size()));
+    Append(buffer, &header, 1);
+    Pad(buffer);
+    header.sourceOffset = buffer.size();
+    Append(buffer, sources.data(), sources.size());
+    Pad(buffer);
+    header.vertexOffset = buffer.size();
+    Append(buffer, contents.vertices.data(), contents.vertices.size());
+    Pad(buffer);
+    header.indexOffset = buffer.size();
+    Append(buffer, contents.indices.data(), contents.indices.size());
+    Pad(buffer);
+    header.subMeshOffset = buffer.size();
+    Append(buffer, contents.subMeshes.data(), contents.subMeshes.size());
+    Pad(buffer);
+    header.materialOffset = buffer.size();
+    Append(buffer, materials.data(), materials.size());
+    Pad(buffer);
+    header.stringOffset = buffer.size();
+    Append(buffer, strings.data(), strings.size());
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+
+    // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+    std::string temporaryPath = cachePath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            Logger::Log("WARNING: MeshCache: Failed to create file - " + temporaryPath + "\n");
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        if (!file) {
+            Logger::Log("WARNING: MeshCache: Failed to write file - " + temporaryPath + "\n");
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    if (error) {
+        Logger::Log("WARNING: MeshCache: Failed to replace file - " + cachePath + "\n");
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::Open(const std::string& cachePath) {
+    Close();
+    if (!MapFile(cachePath, data_, size_, fileHandle_, mappingHandle_)) {
+        return false;
+    }
+
+    // ヘッダーと各領域の範囲を確認する
+    const Header* header = reinterpret_cast<const Header*>(data_);
+    bool isValid = size_ >= sizeof(Header) &&
+        std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+        header->version == kVersion &&
+        header->vertexStride == sizeof(VertexData) &&
+        IsSectionInFile(header->sourceOffset, header->sourceCount, sizeof(SourceRecord), size_) &&
+        IsSectionInFile(header->vertexOffset, header->vertexCount, sizeof(VertexData), size_) &&
+        IsSectionInFile(header->indexOffset, header->indexCount, sizeof(uint32_t), size_) &&
+        IsSectionInFile(header->subMeshOffset, header->subMeshCount, sizeof(SubMeshData), size_) &&
+        IsSectionInFile(header->materialOffset, header->materialCount, sizeof(MaterialRecord), size_) &&
+        IsSectionInFile(header->stringOffset, header->stringSize, 1, size_);
+    // サブメッシュの範囲がインデックスとマテリアルの数に収まっているか
+    if (isValid) {
+        const SubMeshData* subMeshes = reinterpret_cast<const SubMeshData*>(data_ + header->subMeshOffset);
+        for (uint32_t i = 0; i < header->subMeshCount; ++i) {
+            isValid = isValid && uint64_t(subMeshes[i].indexStart) + subMeshes[i].indexCount <= header->indexCount &&
+                subMeshes[i].materialIndex < header->materialCount;
+        }
+    }
+    if (!isValid) {
+        Logger::Log("MeshCache: Ignoring outdated or broken cache - " + cachePath + "\n");
+        Close();
+        return false;
+    }
+    header_ = header;
+
+    if (!IsSourceUpToDate()) {
+        Logger::Log("MeshCache: Source files changed - " + cachePath + "\n");
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MeshCache::Close() {
+    if (data_) {
+        UnmapFile(data_, size_, fileHandle_, mappingHandle_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    header_ = nullptr;
+    isSourceStampChanged_ = false;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+}
+
+std::vector<std::string> MeshCache::GetSourcePaths() const {
+    assert(header_);
+    const SourceRecord* records = reinterpret_cast<const SourceRecord*>(data_ + header_->sourceOffset);
+    std::vector<std::string> paths;
+    for (uint32_t i = 0; i < header_->sourceCount; ++i) {
+        paths.push_back(GetString(records[i].pathOffset, records[i].pathLength));
+    }
+    return paths;
+}
+
+std::span<const VertexData> MeshCache::GetVertices() const {
+    assert(header_);
+    return { reinterpret_cast<const VertexData*>(data_ + header_->vertexOffset), header_->vertexCount };
+}
+
+std::span<const uint32_t> MeshCache::GetIndices() const {
+    assert(header_);
+    return { reinterpret_cast<const uint32_t*>(data_ + header_->indexOffset), header_->indexCount };
+}
+
+std::span<const SubMeshData> MeshCache::GetSubMeshes() const {
+    assert(header_);
+    return { reinterpret_cast<const SubMeshData*>(data_ + header_->subMeshOffset), header_->subMeshCount };
+}
+
+uint32_t MeshCache::GetMaterialCount() const {
+    assert(header_);
+    return header_->materialCount;
+}
+
+MaterialData MeshCache::GetMaterial(uint32_t index) const {
+    assert(header_ && index < header_->materialCount);
+    const MaterialRecord& record = reinterpret_cast<const MaterialRecord*>(data_ + header_->materialOffset)[index];
+    MaterialData material;
+    material.name = GetString(record.nameOffset, record.nameLength);
+    material.textureFilePath = GetString(record.textureOffset, record.textureLength);
+    material.ambient = record.ambient;
+    material.diffuse = record.diffuse;
+    material.specular = record.specular;
+    material.shininess = record.shininess;
+    material.alpha = record.alpha;
+    return material;
+}
+
+const AABB& MeshCache::GetLocalAABB() const {
+    assert(header_);
+    return header_->localAABB;
+}
+
+const Sphere& MeshCache::GetLocalBoundingSphere() const {
+    assert(header_);
+    return header_->localBoundingSphere;
+}
+
+bool MeshCache::GetFileStamp(const std::string& path, uint64_t& outSize, int64_t& outLastWriteTime) {
+    std::error_code error;
+    outSize = std::filesystem::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    outLastWriteTime = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    return !error;
+}
+
+uint64_t MeshCache::HashFile(const std::string& path) {
+    const uint8_t* data = nullptr;
+    uint64_t size = 0;
+    void* file = nullptr;
+    void* mapping = nullptr;
+    if (!MapFile(path, data, size, file, mapping)) {
+        return 0;
+    }
+    uint64_t hash = HashBytes(data, size);
+    UnmapFile(data, size, file, mapping);
+    return hash;
+}
+
+std::string MeshCache::GetString(uint32_t offset, uint32_t length) const {
+    if (uint64_t(offset) + length > header_->stringSize) {
+        return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(data_ + header_->stringOffset + offset), length);
+}
+
+bool MeshCache::IsSourceUpToDate() {
+    const SourceRecord* records = reinterpret_cast<const SourceRecord*>(data_ + header_->sourceOffset);
+    for (uint32_t i = 0; i < header_->sourceCount; ++i) {
+        const SourceRecord& record = records[i];
+        std::string path = GetString(record.pathOffset, record.pathLength);
+        uint64_t size;
+        int64_t lastWriteTime;
+        if (path.empty() || !GetFileStamp(path, size, lastWriteTime) || size != record.size) {
+            return false;
+        }
+        // 更新日時だけが違う場合（チェックアウトし直した場合など）は内容が同じかを確かめる
+        if (lastWriteTime != record.lastWriteTime) {
+            if (HashFile(path) != record.contentHash) {
+                return false;
+            }
+            isSourceStampChanged_ = true;
+        }
+    }
+    return true;
+}
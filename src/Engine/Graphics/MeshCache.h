@@ -0,0 +1,96 @@
+#pragma once
+#include "Mymath.h"
+#include "Bounds.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// 読み込み・最適化済みのメッシュを保存するバイナリのキャッシュファイル
+// 形式：ヘッダー、元ファイルの記録、頂点の配列、インデックスの配列、サブメッシュの配列、マテリアルの配列、文字列領域（各領域は16バイト境界に置く）
+// 読み込みはファイルをメモリにマップして各配列をそのまま参照するので、頂点ごとの解析や変換は行わない
+// 元ファイル（OBJとMTL）のサイズと更新日時が記録と同じなら有効とし、更新日時だけが違う場合は内容のハッシュで判定する
+class MeshCache {
+public:
+    // 形式の版（VertexDataやマテリアルの記録の構造、配列の意味を変えたら上げる）
+    // 2: 頂点を統合してインデックスで参照するようにした
+    // 3: 三角形と頂点を描画向けに並べ替えるようにした
+    // 4: マテリアルの一覧とサブメッシュを保存するようにした
+    static const uint32_t kVersion = 4;
+
+    // キャッシュに書き込む内容
+    struct Contents {
+        std::span<const VertexData> vertices;
+        std::span<const uint32_t> indices;
+        std::span<const MaterialData> materials;
+        std::span<const SubMeshData> subMeshes;
+        AABB localAABB;
+        Sphere localBoundingSphere;
+    };
+
+    MeshCache() = default;
+    ~MeshCache();
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+
+    // 元ファイルに対応するキャッシュファイルのパス
+    static std::string GetCachePath(const std::string& sourcePath);
+
+    // キャッシュファイルの書き込み（sourcePathsは更新判定に使う元ファイル）
+    static bool Write(const std::string& cachePath, std::span<const std::string> sourcePaths, const Contents& contents);
+
+    // キャッシュファイルを開く（無い、壊れている、版が違う、元ファイルが変わっている場合はfalse）
+    bool Open(const std::string& cachePath);
+
+    // 閉じる（GetVerticesなどで受け取ったspanも無効になる）
+    void Close();
+
+    // 開いているか
+    bool IsOpen() const { return header_ != nullptr; }
+
+    // 元ファイルの更新日時だけが変わっていたか（内容のハッシュで有効と判定した場合）
+    // 次回からハッシュを計算しなくて済むよう、呼び出し側でCloseしてから書き直す
+    bool IsSourceStampChanged() const { return isSourceStampChanged_; }
+
+    // 記録している元ファイルのパス
+    std::vector<std::string> GetSourcePaths() const;
+
+    // マップしたファイル上の配列
+    std::span<const VertexData> GetVertices() const;
+    std::span<const uint32_t> GetIndices() const;
+    std::span<const SubMeshData> GetSubMeshes() const;
+
+    // マテリアル（テクスチャのパスを文字列にするため値で返す）
+    uint32_t GetMaterialCount() const;
+    MaterialData GetMaterial(uint32_t index) const;
+
+    // ローカル空間での境界
+    const AABB& GetLocalAABB() const;
+    const Sphere& GetLocalBoundingSphere() const;
+
+private:
+    struct Header;
+    struct SourceRecord;
+    struct MaterialRecord;
+
+    // 元ファイルのサイズと更新日時（取得できなければfalse）
+    static bool GetFileStamp(const std::string& path, uint64_t& outSize, int64_t& outLastWriteTime);
+
+    // ファイル内容のハッシュ（読めなければ0）
+    static uint64_t HashFile(const std::string& path);
+
+    // 文字列領域の文字列
+    std::string GetString(uint32_t offset, uint32_t length) const;
+
+    // 元ファイルが記録から変わっていないか
+    bool IsSourceUpToDate();
+
+    // マップしたファイル
+    const uint8_t* data_ = nullptr;
+    uint64_t size_ = 0;
+    const Header* header_ = nullptr;
+    bool isSourceStampChanged_ = false;
+    // OSのハンドル（Windowsではファイルとマッピング）
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+};
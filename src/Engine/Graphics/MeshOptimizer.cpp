@@ -0,0 +1,446 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // 丸めた頂点の値（位置3、法線3、テクスチャ座標2）
+    const size_t kWeldKeySize = 8;
+
+    struct WeldKey {
+        int32_t values[kWeldKeySize];
+
+        bool operator==(const WeldKey& other) const {
+            return std::memcmp(values, other.values, sizeof(values)) == 0;
+        }
+    };
+
+    // ハッシュ表の空きスロット
+    const uint32_t kEmptySlot = UINT32_MAX;
+
+    // 値をquantum単位の整数に丸める（極端に大きい値やNaNはint32に収まる範囲に寄せる）
+    int32_t Quantize(float value, float inverseQuantum) {
+        const float kLimit = 2.0e9f;
+        float scaled = std::floor(value * inverseQuantum + 0.5f);
+        if (!(scaled > -kLimit)) {
+            scaled = -kLimit;
+        }
+        if (scaled > kLimit) {
+            scaled = kLimit;
+        }
+        return static_cast<int32_t>(scaled);
+    }
+
+    WeldKey MakeWeldKey(const VertexData& vertex, float inverseQuantum) {
+        WeldKey key;
+        key.values[0] = Quantize(vertex.position.x, inverseQuantum);
+        key.values[1] = Quantize(vertex.position.y, inverseQuantum);
+        key.values[2] = Quantize(vertex.position.z, inverseQuantum);
+        key.values[3] = Quantize(vertex.normal.x, inverseQuantum);
+        key.values[4] = Quantize(vertex.normal.y, inverseQuantum);
+        key.values[5] = Quantize(vertex.normal.z, inverseQuantum);
+        key.values[6] = Quantize(vertex.texcoord.x, inverseQuantum);
+        key.values[7] = Quantize(vertex.texcoord.y, inverseQuantum);
+        return key;
+    }
+
+    // キーのハッシュ（各要素を掛け算で混ぜ、上位ビットを下位に畳み込む）
+    uint32_t HashWeldKey(const WeldKey& key) {
+        uint64_t hash = 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < kWeldKeySize; ++i) {
+            hash = (hash ^ static_cast<uint32_t>(key.values[i])) * 0xFF51AFD7ED558CCDull;
+        }
+        hash ^= hash >> 32;
+        return static_cast<uint32_t>(hash);
+    }
+
+    // Forsythの方法で想定するキャッシュの大きさ（LRU、実際のキャッシュより少し大きめにする）
+    const uint32_t kForsythCacheSize = 32;
+    // 点数の計算の係数（Forsythの記事の値）
+    const float kCacheDecayPower = 1.5f;
+    const float kLastTriangleScore = 0.75f;
+    const float kValenceBoostScale = 2.0f;
+    const float kValenceBoostPower = 0.5f;
+    // 未出力の三角形の数による点数を表にしておく上限
+    const uint32_t kMaxValenceScore = 32;
+
+    // 頂点の点数の表
+    struct ForsythScoreTable {
+        // キャッシュ内の位置ごとの点数（直前の三角形の3頂点は、同じ辺を続けて使いすぎないよう少し下げる）
+        float cache[kForsythCacheSize];
+        // 未出力の三角形の数ごとの点数（残りが少ない頂点を優先して使い切る）
+        float valence[kMaxValenceScore];
+
+        ForsythScoreTable() {
+            for (uint32_t i = 0; i < kForsythCacheSize; ++i) {
+                if (i < 3) {
+                    cache[i] = kLastTriangleScore;
+                }
+                else {
+                    float scale = 1.0f / static_cast<float>(kForsythCacheSize - 3);
+                    cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scale, kCacheDecayPower);
+                }
+            }
+            valence[0] = 0.0f;
+            for (uint32_t i = 1; i < kMaxValenceScore; ++i) {
+                valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+            }
+        }
+
+        // 頂点の点数（cachePositionはキャッシュ外なら-1、未出力の三角形がなければ-1点）
+        float GetScore(int32_t cachePosition, uint32_t valenceCount) const {
+            if (valenceCount == 0) {
+                return -1.0f;
+            }
+            float score = cachePosition >= 0 ? cache[cachePosition] : 0.0f;
+            if (valenceCount < kMaxValenceScore) {
+                score += valence[valenceCount];
+            }
+            else {
+                score += kValenceBoostScale * std::pow(static_cast<float>(valenceCount), -kValenceBoostPower);
+            }
+            return score;
+        }
+    };
+
+    // FIFOの頂点キャッシュのシミュレーション（頂点ごとに追加した時刻を記録し、cacheSize回の追加で追い出されたとみなす）
+    class FifoCache {
+    public:
+        FifoCache(size_t vertexCount, uint32_t cacheSize)
+            : timestamps_(vertexCount, 0), cacheSize_(cacheSize), time_(cacheSize + 1) {}
+
+        // 頂点を参照する（キャッシュになければ追加して1を返す）
+        uint32_t Access(uint32_t vertex) {
+            if (time_ - timestamps_[vertex] > cacheSize_) {
+                timestamps_[vertex] = time_++;
+                return 1;
+            }
+            return 0;
+        }
+
+        // キャッシュを空にする
+        void Flush() {
+            time_ += cacheSize_ + 1;
+        }
+
+    private:
+        std::vector<uint32_t> timestamps_;
+        uint32_t cacheSize_;
+        uint32_t time_;
+    };
+
+    Vector3 ToVector3(const Vector4& v) {
+        return { v.x, v.y, v.z };
+    }
+}
+
+void MeshOptimizer::WeldVertices(std::span<const VertexData> vertices, float quantum,
+    std::vector<VertexData>& outVertices, std::vector<uint32_t>& outIndices) {
+    assert(quantum > 0.0f);
+    assert(vertices.size() < kEmptySlot);
+    outVertices.clear();
+    outIndices.clear();
+    outIndices.reserve(vertices.size());
+
+    // 表の大きさは頂点数の2倍以上の2の累乗にして、使用率を50%以下に保つ
+    size_t tableSize = 16;
+    while (tableSize < vertices.size() * 2) {
+        tableSize *= 2;
+    }
+    const size_t mask = tableSize - 1;
+    // スロットにはまとめた頂点の添字を入れる（キーは頂点と同じ順でkeysに持つ）
+    std::vector<uint32_t> slots(tableSize, kEmptySlot);
+    std::vector<WeldKey> keys;
+
+    const float inverseQuantum = 1.0f / quantum;
+    for (const VertexData& vertex : vertices) {
+        WeldKey key = MakeWeldKey(vertex, inverseQuantum);
+        size_t slot = HashWeldKey(key) & mask;
+        while (slots[slot] != kEmptySlot && !(keys[slots[slot]] == key)) {
+            slot = (slot + 1) & mask;
+        }
+
+        // 初めて現れた値なら頂点を追加する
+        if (slots[slot] == kEmptySlot) {
+            slots[slot] = static_cast<uint32_t>(outVertices.size());
+            outVertices.push_back(vertex);
+            keys.push_back(key);
+        }
+        outIndices.push_back(slots[slot]);
+    }
+}
+
+void MeshOptimizer::MergeSubMeshesByMaterial(std::span<uint32_t> indices, std::vector<SubMeshData>& subMeshes) {
+    std::stable_sort(subMeshes.begin(), subMeshes.end(), [](const SubMeshData& a, const SubMeshData& b) {
+        return a.materialIndex < b.materialIndex;
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    std::vector<SubMeshData> merged;
+    for (const SubMeshData& subMesh : subMeshes) {
+        assert(uint64_t(subMesh.indexStart) + subMesh.indexCount <= indices.size());
+        if (subMesh.indexCount == 0) {
+            continue;
+        }
+        if (merged.empty() || merged.back().materialIndex != subMesh.materialIndex) {
+            merged.push_back({ static_cast<uint32_t>(result.size()), 0, subMesh.materialIndex });
+        }
+        result.insert(result.end(), indices.begin() + subMesh.indexStart, indices.begin() + subMesh.indexStart + subMesh.indexCount);
+        merged.back().indexCount += subMesh.indexCount;
+    }
+    assert(result.size() == indices.size());
+
+    std::copy(result.begin(), result.end(), indices.begin());
+    subMeshes = std::move(merged);
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount,
+    uint32_t cacheSize) {
+    VertexCacheStatistics statistics;
+    if (indices.size() < 3 || vertexCount == 0) {
+        return statistics;
+    }
+
+    FifoCache cache(vertexCount, cacheSize);
+    for (uint32_t index : indices) {
+        assert(index < vertexCount);
+        statistics.transformedVertexCount += cache.Access(index);
+    }
+    statistics.acmr = static_cast<float>(statistics.transformedVertexCount) / static_cast<float>(indices.size() / 3);
+    statistics.atvr = static_cast<float>(statistics.transformedVertexCount) / static_cast<float>(vertexCount);
+    return statistics;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount) {
+    static const ForsythScoreTable scoreTable;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // 頂点ごとの未出力の三角形の一覧（各頂点の範囲の先頭からvalence個が未出力）
+    std::vector<uint32_t> valence(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        assert(indices[i] < vertexCount);
+        ++valence[indices[i]];
+    }
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + valence[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    // 頂点と三角形の点数
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = scoreTable.GetScore(-1, valence[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<uint8_t> isEmitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    }
+
+    // 最初は点数が最も高い三角形から始める
+    size_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+
+    // LRUキャッシュの中身（新しい順、出力した三角形の3頂点を追加した直後は最大でkForsythCacheSize + 3個）
+    uint32_t cache[kForsythCacheSize + 3];
+    uint32_t newCache[kForsythCacheSize + 3];
+    size_t cacheCount = 0;
+
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    size_t nextTriangle = 0;
+    while (result.size() < triangleCount * 3) {
+        // キャッシュ内の頂点に未出力の三角形がなければ、まだ出力していない三角形を先頭から探す
+        if (bestTriangle == SIZE_MAX) {
+            while (isEmitted[nextTriangle]) {
+                ++nextTriangle;
+            }
+            bestTriangle = nextTriangle;
+        }
+
+        // 三角形を出力して、各頂点の未出力の一覧から外す
+        const uint32_t* corners = &indices[bestTriangle * 3];
+        isEmitted[bestTriangle] = 1;
+        for (size_t corner = 0; corner < 3; ++corner) {
+            uint32_t vertex = corners[corner];
+            result.push_back(vertex);
+
+            uint32_t* triangles = &adjacency[adjacencyOffsets[vertex]];
+            uint32_t* last = triangles + valence[vertex] - 1;
+            *std::find(triangles, last, static_cast<uint32_t>(bestTriangle)) = *last;
+            --valence[vertex];
+        }
+
+        // 出力した三角形の頂点を先頭に入れてキャッシュを更新する
+        size_t newCacheCount = 0;
+        for (size_t corner = 0; corner < 3; ++corner) {
+            if (std::find(newCache, newCache + newCacheCount, corners[corner]) == newCache + newCacheCount) {
+                newCache[newCacheCount++] = corners[corner];
+            }
+        }
+        const size_t cornerCount = newCacheCount;
+        for (size_t i = 0; i < cacheCount; ++i) {
+            if (std::find(newCache, newCache + cornerCount, cache[i]) == newCache + cornerCount) {
+                newCache[newCacheCount++] = cache[i];
+            }
+        }
+
+        // キャッシュ内の頂点と、追い出された頂点の点数を更新し、その頂点を使う三角形の点数に差分を反映する
+        bestTriangle = SIZE_MAX;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < newCacheCount; ++i) {
+            uint32_t vertex = newCache[i];
+            int32_t position = i < kForsythCacheSize ? static_cast<int32_t>(i) : -1;
+            cachePositions[vertex] = position;
+            float score = scoreTable.GetScore(position, valence[vertex]);
+            float delta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+
+            const uint32_t* triangles = &adjacency[adjacencyOffsets[vertex]];
+            for (uint32_t j = 0; j < valence[vertex]; ++j) {
+                uint32_t triangle = triangles[j];
+                triangleScores[triangle] += delta;
+                if (position >= 0 && triangleScores[triangle] > bestScore) {
+                    bestScore = triangleScores[triangle];
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        cacheCount = std::min<size_t>(newCacheCount, kForsythCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::span<uint32_t> indices, std::span<const VertexData> vertices, float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // キャッシュを使い切って3頂点とも読み直しになる位置でまず分け（ここで切っても効率は変わらない）
+    FifoCache cache(vertices.size(), kVertexCacheSize);
+    std::vector<uint8_t> misses(triangleCount);
+    std::vector<size_t> hardStarts;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        misses[t] = static_cast<uint8_t>(cache.Access(indices[t * 3]) + cache.Access(indices[t * 3 + 1]) + cache.Access(indices[t * 3 + 2]));
+        if (t == 0 || misses[t] == 3) {
+            hardStarts.push_back(t);
+        }
+    }
+    hardStarts.push_back(triangleCount);
+
+    // さらに、キャッシュを空にしてから数えたACMRが元のまとまりのthreshold倍以内に収まる位置で細かく分ける
+    std::vector<size_t> clusterStarts;
+    for (size_t h = 0; h + 1 < hardStarts.size(); ++h) {
+        size_t begin = hardStarts[h];
+        size_t end = hardStarts[h + 1];
+        uint32_t hardMissCount = 0;
+        for (size_t t = begin; t < end; ++t) {
+            hardMissCount += misses[t];
+        }
+        float limit = threshold * static_cast<float>(hardMissCount) / static_cast<float>(end - begin);
+
+        cache.Flush();
+        clusterStarts.push_back(begin);
+        uint32_t missCount = 0;
+        size_t clusterBegin = begin;
+        for (size_t t = begin; t < end; ++t) {
+            missCount += cache.Access(indices[t * 3]) + cache.Access(indices[t * 3 + 1]) + cache.Access(indices[t * 3 + 2]);
+            if (t + 1 < end && static_cast<float>(missCount) <= limit * static_cast<float>(t + 1 - clusterBegin)) {
+                cache.Flush();
+                clusterStarts.push_back(t + 1);
+                clusterBegin = t + 1;
+                missCount = 0;
+            }
+        }
+    }
+    clusterStarts.push_back(triangleCount);
+    const size_t clusterCount = clusterStarts.size() - 1;
+
+    // クラスタごとに面積で重み付けした中心と法線を求める（法線は周り順に依存しないよう頂点の法線を使う）
+    std::vector<Vector3> clusterCenters(clusterCount, { 0.0f, 0.0f, 0.0f });
+    std::vector<Vector3> clusterNormals(clusterCount, { 0.0f, 0.0f, 0.0f });
+    std::vector<float> clusterAreas(clusterCount, 0.0f);
+    Vector3 meshCenter = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; ++c) {
+        for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+            const VertexData& vertex0 = vertices[indices[t * 3]];
+            const VertexData& vertex1 = vertices[indices[t * 3 + 1]];
+            const VertexData& vertex2 = vertices[indices[t * 3 + 2]];
+            Vector3 position0 = ToVector3(vertex0.position);
+            Vector3 position1 = ToVector3(vertex1.position);
+            Vector3 position2 = ToVector3(vertex2.position);
+
+            Vector3 cross = Cross(position1 - position0, position2 - position0);
+            float area = std::sqrt(Dot(cross, cross)) * 0.5f;
+            Vector3 center = (position0 + position1 + position2) / 3.0f;
+
+            clusterCenters[c] += center * area;
+            clusterNormals[c] += (vertex0.normal + vertex1.normal + vertex2.normal) * area;
+            clusterAreas[c] += area;
+        }
+        meshCenter += clusterCenters[c];
+        meshArea += clusterAreas[c];
+    }
+    if (meshArea <= 0.0f) {
+        return;
+    }
+    meshCenter /= meshArea;
+
+    // メッシュの中心から見て外側にあり、外を向いているクラスタほど先に描画する
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        float normalLengthSq = Dot(clusterNormals[c], clusterNormals[c]);
+        if (clusterAreas[c] > 0.0f && normalLengthSq > 0.0f) {
+            Vector3 offset = clusterCenters[c] / clusterAreas[c] - meshCenter;
+            sortKeys[c] = Dot(offset, clusterNormals[c]) / std::sqrt(normalLengthSq);
+        }
+    }
+    std::vector<uint32_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        order[c] = static_cast<uint32_t>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    for (uint32_t c : order) {
+        result.insert(result.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+    }
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<VertexData>& vertices, std::span<uint32_t> indices) {
+    // 初めて使われた順に新しい番号を振る
+    std::vector<uint32_t> remap(vertices.size(), kEmptySlot);
+    std::vector<VertexData> result;
+    result.reserve(vertices.size());
+    for (uint32_t& index : indices) {
+        assert(index < vertices.size());
+        if (remap[index] == kEmptySlot) {
+            remap[index] = static_cast<uint32_t>(result.size());
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(result);
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "Mymath.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// 読み込み時のメッシュ最適化処理
+namespace MeshOptimizer
+{
+    // 頂点の溶接で同じとみなす値の刻み（以前の文字列キー"%.2f"と同じく小数点以下2桁）
+    const float kWeldQuantum = 0.01f;
+
+    // 頂点キャッシュの評価で想定するキャッシュの大きさ（頂点数、FIFO）
+    const uint32_t kVertexCacheSize = 16;
+
+    // 描画の重なりを減らす並べ替えで許す、頂点キャッシュの効率（ACMR）の低下の割合
+    const float kOverdrawThreshold = 1.05f;
+
+    // 頂点キャッシュの効率
+    struct VertexCacheStatistics {
+        // 頂点シェーダーが実行される回数（キャッシュミスの数）
+        uint32_t transformedVertexCount = 0;
+        // 三角形あたりの実行回数（Average Cache Miss Ratio、0.5～3で小さいほど良い）
+        float acmr = 0.0f;
+        // 頂点あたりの実行回数（Average Transformed Vertex Ratio、1が最小）
+        float atvr = 0.0f;
+    };
+
+    // 三角形リストの頂点から、位置・法線・テクスチャ座標をquantum単位に丸めた値が一致する頂点を1つにまとめる
+    // 丸めた値の整数をそのままキーにして、オープンアドレス法（線形探索）のハッシュ表で重複を探す
+    // outVerticesには各グループで最初に現れた頂点を現れた順に入れ、outIndicesには元の頂点ごとにoutVerticesの添字を入れる
+    void WeldVertices(std::span<const VertexData> vertices, float quantum,
+        std::vector<VertexData>& outVertices, std::vector<uint32_t>& outIndices);
+
+    // サブメッシュの三角形をマテリアルの番号順に並べ替え、同じマテリアルの範囲を1つにまとめる（同じマテリアルの中では元の順を保つ）
+    // subMeshesは重ならずにindices全体を覆っている必要がある
+    void MergeSubMeshesByMaterial(std::span<uint32_t> indices, std::vector<SubMeshData>& subMeshes);
+
+    // インデックスの順に描画したときの頂点キャッシュの効率を、cacheSize頂点のFIFOキャッシュとして見積もる
+    VertexCacheStatistics AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount,
+        uint32_t cacheSize = kVertexCacheSize);
+
+    // 頂点キャッシュに残っている頂点を使う三角形が続くように三角形の順番を並べ替える（Forsythの方法）
+    // 各頂点に「キャッシュ内の位置」と「未出力の三角形の数」から点数を付け、点数の合計が最も高い三角形から出力する
+    void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+    // 外側を向いた部分が先に描画されるように、OptimizeVertexCache後の三角形をまとまり（クラスタ）単位で並べ替える
+    // キャッシュを使い切る位置と、ACMRがthreshold倍以内に収まる位置でクラスタに分けるので、頂点キャッシュの効率はほぼ保たれる
+    // 向きは頂点の法線から求めるので、三角形の周り順や背面カリングの設定には依存しない
+    void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const VertexData> vertices,
+        float threshold = kOverdrawThreshold);
+
+    // 頂点をインデックスで最初に使われる順に並べ替え、インデックスを付け替える（使われない頂点は削除する）
+    // 頂点の読み込みがメモリ上で前から順に進むようになる
+    void OptimizeVertexFetch(std::vector<VertexData>& vertices, std::span<uint32_t> indices);
+};
@@ -1,10 +1,15 @@
 // src/Engine/Graphics/Model.cpp
 #include "Model.h"
 #include "TextureManager.h"
+#include "FastMath.h"
+#include "ObjFile.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include <cassert>
-#include <unordered_map>
+#include <cctype>
 #include <cmath>
 
 Model::Model() : dxCommon_(nullptr) {}
@@ -17,31 +22,93 @@ void Model::Initialize(DirectXCommon* dxCommon) {
 }
 
 void Model::LoadFromObj(const std::string& directoryPath, const std::string& filename) {
-    // モデルデータの読み込み
-    modelData_ = LoadObjFile(directoryPath, filename);
+    // 変換済みのキャッシュが元ファイルと一致していれば、解析と最適化を省いてそれを使う
+    // （キャッシュの頂点とインデックスはマップしたままGPUのバッファへ書き込まれる）
+    std::string cachePath = MeshCache::GetCachePath(directoryPath + "/" + filename);
+    if (!LoadMeshCache(cachePath)) {
+        // モデルデータの読み込み
+        std::vector<std::string> sourcePaths;
+        modelData_ = LoadObjFile(directoryPath, filename, sourcePaths);
+
+        // モデルデータを最適化（UV球などの表示品質向上のため）
+        // ファイル名も渡すように修正
+        OptimizeTriangles(modelData_, filename);
+
+        // 視錐台カリング用の境界を計算
+        CalculateBounds();
+
+        // 次回の読み込み用にキャッシュを書き出す
+        WriteMeshCache(cachePath, sourcePaths);
+
+        // 頂点バッファとインデックスバッファの作成
+        CreateBuffers(modelData_.vertices, modelData_.indices);
+        meshCachePath_.clear();
+    }
+
+    // レイキャスト用のメッシュは使うときに作り直す
+    triangleMesh_.Clear();
+    isTriangleMeshBuilt_ = false;
+
+    // 各マテリアルのテクスチャの読み込み
+    for (MaterialData& material : modelData_.materials) {
+        LoadMaterialTexture(material, directoryPath);
+    }
+
+    // デバッグ情報
+    OutputDebugStringA(("Model: Loaded " + std::to_string(vertexCount_) + " vertices and " +
+        std::to_string(indexCount_) + " indices from " + filename + "\n").c_str());
+}
+
+void Model::CreateBuffers(std::span<const VertexData> vertices, std::span<const uint32_t> indices) {
+    vertexCount_ = static_cast<uint32_t>(vertices.size());
+    indexCount_ = static_cast<uint32_t>(indices.size());
+
+    // 頂点バッファの作成
+    vertexResource_ = dxCommon_->CreateBufferResource(vertices.size_bytes());
+
+    // 頂点バッファビューの設定
+    vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
+    vertexBufferView_.SizeInBytes = static_cast<UINT>(vertices.size_bytes());
+    vertexBufferView_.StrideInBytes = sizeof(VertexData);
 
-    // モデルデータを最適化（UV球などの表示品質向上のため）
-    // ファイル名も渡すように修正
-    OptimizeTriangles(modelData_, filename);
+    // 頂点データの書き込み
+    VertexData* vertexData = nullptr;
+    vertexResource_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
+    std::memcpy(vertexData, vertices.data(), vertices.size_bytes());
 
-    // テクスチャの読み込み
-    if (!modelData_.material.textureFilePath.empty()) {
+    // インデックスバッファの作成
+    indexResource_ = dxCommon_->CreateBufferResource(indices.size_bytes());
+
+    // インデックスバッファビューの設定
+    indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
+    indexBufferView_.SizeInBytes = static_cast<UINT>(indices.size_bytes());
+    indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+
+    // インデックスデータの書き込み
+    uint32_t* indexData = nullptr;
+    indexResource_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
+    std::memcpy(indexData, indices.data(), indices.size_bytes());
+}
+
+// マテリアルのテクスチャを読み込む（MTLで指定された場所になければ別の場所を探し、見つからなければパスを空にする）
+void Model::LoadMaterialTexture(MaterialData& material, const std::string& directoryPath) {
+    if (!material.textureFilePath.empty()) {
         // テクスチャパスをログに出力
-        OutputDebugStringA(("Model: Texture path from MTL: " + modelData_.material.textureFilePath + "\n").c_str());
+        OutputDebugStringA(("Model: Texture path from MTL: " + material.textureFilePath + "\n").c_str());
 
         // テクスチャが存在するかチェック
-        DWORD fileAttributes = GetFileAttributesA(modelData_.material.textureFilePath.c_str());
+        DWORD fileAttributes = GetFileAttributesA(material.textureFilePath.c_str());
         if (fileAttributes != INVALID_FILE_ATTRIBUTES) {
             // テクスチャが存在する場合のみ読み込み
-            TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
-            OutputDebugStringA(("Model: Texture loaded - " + modelData_.material.textureFilePath + "\n").c_str());
+            TextureManager::GetInstance()->LoadTexture(material.textureFilePath);
+            OutputDebugStringA(("Model: Texture loaded - " + material.textureFilePath + "\n").c_str());
         }
         else {
             // テクスチャが見つからない場合、別の場所を探す
-            OutputDebugStringA(("WARNING: Texture file not found at: " + modelData_.material.textureFilePath + "\n").c_str());
+            OutputDebugStringA(("WARNING: Texture file not found at: " + material.textureFilePath + "\n").c_str());
 
             // ファイル名のみを抽出
-            std::string filenameOnly = modelData_.material.textureFilePath;
+            std::string filenameOnly = material.textureFilePath;
             size_t lastSlash = filenameOnly.find_last_of("/\\");
             if (lastSlash != std::string::npos) {
                 filenameOnly = filenameOnly.substr(lastSlash + 1);
@@ -60,7 +127,7 @@ void Model::LoadFromObj(const std::string& directoryPath, const std::string& fil
                 OutputDebugStringA(("Model: Trying alternative path: " + path + "\n").c_str());
                 if (GetFileAttributesA(path.c_str()) != INVALID_FILE_ATTRIBUTES) {
                     // 見つかった場合はパスを更新して読み込み
-                    modelData_.material.textureFilePath = path;
+                    material.textureFilePath = path;
                     TextureManager::GetInstance()->LoadTexture(path);
                     OutputDebugStringA(("Model: Texture found and loaded from: " + path + "\n").c_str());
                     found = true;
@@ -71,29 +138,13 @@ void Model::LoadFromObj(const std::string& directoryPath, const std::string& fil
             if (!found) {
                 // どこにも見つからない場合
                 OutputDebugStringA("WARNING: Texture file not found in any location. Clearing texture path.\n");
-                modelData_.material.textureFilePath = ""; // パスをクリア
+                material.textureFilePath = ""; // パスをクリア
             }
         }
     }
     else {
-        OutputDebugStringA("Model: No texture specified in MTL file\n");
+        OutputDebugStringA(("Model: No texture specified in MTL material: " + material.name + "\n").c_str());
     }
-
-    // 頂点バッファの作成
-    vertexResource_ = dxCommon_->CreateBufferResource(sizeof(VertexData) * modelData_.vertices.size());
-
-    // 頂点バッファビューの設定
-    vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
-    vertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(VertexData) * modelData_.vertices.size());
-    vertexBufferView_.StrideInBytes = sizeof(VertexData);
-
-    // 頂点データの書き込み
-    VertexData* vertexData = nullptr;
-    vertexResource_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
-    std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-
-    // デバッグ情報
-    OutputDebugStringA(("Model: Loaded " + std::to_string(modelData_.vertices.size()) + " vertices from " + filename + "\n").c_str());
 }
 
 // UV球などの表示品質を向上させるためのモデルデータ最適化関数
@@ -101,132 +152,67 @@ void Model::OptimizeTriangles(ModelData& modelData, const std::string& filename)
     // 最適化前の頂点数を保存
     size_t originalVertexCount = modelData.vertices.size();
 
-    // 重複頂点の検出と削除のためのデータ構造
+    // 位置・法線・UVが（小数点以下2桁で）一致する頂点を統合してインデックスで参照する
     std::vector<VertexData> optimizedVertices;
     std::vector<uint32_t> indices;
-    std::unordered_map<std::string, uint32_t> vertexMap;
-
-    // 各頂点を処理
-    for (const auto& vertex : modelData.vertices) {
-        // 頂点のハッシュキーを作成（類似頂点の統合を強化）
-        // 精度を大幅に下げて頂点統合を促進（小数点以下2桁に制限）
-        char buffer[256];
-        snprintf(buffer, sizeof(buffer), "%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f",
-            vertex.position.x, vertex.position.y, vertex.position.z,
-            vertex.normal.x, vertex.normal.y, vertex.normal.z,
-            vertex.texcoord.x, vertex.texcoord.y);
-        std::string key = buffer;
-
-        // この頂点がまだ追加されていなければ追加する
-        if (vertexMap.find(key) == vertexMap.end()) {
-            vertexMap[key] = static_cast<uint32_t>(optimizedVertices.size());
-
-            // 法線を正規化して品質を向上
-            VertexData normalizedVertex = vertex;
-            float length = std::sqrt(
-                normalizedVertex.normal.x * normalizedVertex.normal.x +
-                normalizedVertex.normal.y * normalizedVertex.normal.y +
-                normalizedVertex.normal.z * normalizedVertex.normal.z
-            );
-
-            if (length > 0.0001f) {
-                normalizedVertex.normal.x /= length;
-                normalizedVertex.normal.y /= length;
-                normalizedVertex.normal.z /= length;
-            }
-
-            optimizedVertices.push_back(normalizedVertex);
-        }
+    MeshOptimizer::WeldVertices(modelData.vertices, MeshOptimizer::kWeldQuantum, optimizedVertices, indices);
 
-        // インデックスを追加
-        indices.push_back(vertexMap[key]);
+    // 法線を正規化して品質を向上（全頂点まとめて正規化する）
+    std::vector<Vector3> normals(optimizedVertices.size());
+    for (size_t i = 0; i < optimizedVertices.size(); i++) {
+        normals[i] = optimizedVertices[i].normal;
+    }
+    FastMath::Normalize(normals);
+    for (size_t i = 0; i < optimizedVertices.size(); i++) {
+        optimizedVertices[i].normal = normals[i];
     }
 
     // 法線平均化処理を追加（共有頂点の法線を平均化して滑らかにする）
     std::vector<Vector3> smoothedNormals(optimizedVertices.size(), { 0.0f, 0.0f, 0.0f });
     std::vector<int> normalCount(optimizedVertices.size(), 0);
 
-    // 各三角形の法線を集計
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        if (i + 2 < indices.size()) {
-            // 三角形の頂点インデックス
-            uint32_t idx0 = indices[i];
-            uint32_t idx1 = indices[i + 1];
-            uint32_t idx2 = indices[i + 2];
-
-            // 三角形の辺ベクトル
-            Vector3 edge1 = {
-                optimizedVertices[idx1].position.x - optimizedVertices[idx0].position.x,
-                optimizedVertices[idx1].position.y - optimizedVertices[idx0].position.y,
-                optimizedVertices[idx1].position.z - optimizedVertices[idx0].position.z
-            };
-
-            Vector3 edge2 = {
-                optimizedVertices[idx2].position.x - optimizedVertices[idx0].position.x,
-                optimizedVertices[idx2].position.y - optimizedVertices[idx0].position.y,
-                optimizedVertices[idx2].position.z - optimizedVertices[idx0].position.z
-            };
-
-            // 外積で面法線を計算
-            Vector3 faceNormal = {
-                edge1.y * edge2.z - edge1.z * edge2.y,
-                edge1.z * edge2.x - edge1.x * edge2.z,
-                edge1.x * edge2.y - edge1.y * edge2.x
-            };
+    // 各三角形の面法線を外積で計算（面積がほぼ0の三角形は除く）
+    std::vector<Vector3> faceNormals;
+    std::vector<size_t> faceFirstIndices;
+    faceNormals.reserve(indices.size() / 3);
+    faceFirstIndices.reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Vector4& position0 = optimizedVertices[indices[i]].position;
+        const Vector4& position1 = optimizedVertices[indices[i + 1]].position;
+        const Vector4& position2 = optimizedVertices[indices[i + 2]].position;
+
+        // 三角形の辺ベクトル
+        Vector3 edge1 = { position1.x - position0.x, position1.y - position0.y, position1.z - position0.z };
+        Vector3 edge2 = { position2.x - position0.x, position2.y - position0.y, position2.z - position0.z };
+
+        Vector3 faceNormal = Cross(edge1, edge2);
+        if (Dot(faceNormal, faceNormal) > FastMath::kNormalizeMinLengthSq) {
+            faceNormals.push_back(faceNormal);
+            faceFirstIndices.push_back(i);
+        }
+    }
 
-            // 法線の長さを計算
-            float length = std::sqrt(
-                faceNormal.x * faceNormal.x +
-                faceNormal.y * faceNormal.y +
-                faceNormal.z * faceNormal.z
-            );
-
-            // 法線を正規化
-            if (length > 0.0001f) {
-                faceNormal.x /= length;
-                faceNormal.y /= length;
-                faceNormal.z /= length;
-
-                // 各頂点に面法線を加算
-                smoothedNormals[idx0].x += faceNormal.x;
-                smoothedNormals[idx0].y += faceNormal.y;
-                smoothedNormals[idx0].z += faceNormal.z;
-                normalCount[idx0]++;
-
-                smoothedNormals[idx1].x += faceNormal.x;
-                smoothedNormals[idx1].y += faceNormal.y;
-                smoothedNormals[idx1].z += faceNormal.z;
-                normalCount[idx1]++;
-
-                smoothedNormals[idx2].x += faceNormal.x;
-                smoothedNormals[idx2].y += faceNormal.y;
-                smoothedNormals[idx2].z += faceNormal.z;
-                normalCount[idx2]++;
-            }
+    // 面法線をまとめて正規化してから各頂点に加算
+    FastMath::Normalize(faceNormals);
+    for (size_t face = 0; face < faceNormals.size(); face++) {
+        for (size_t corner = 0; corner < 3; corner++) {
+            uint32_t index = indices[faceFirstIndices[face] + corner];
+            smoothedNormals[index] += faceNormals[face];
+            normalCount[index]++;
         }
     }
 
-    // 法線を平均化
+    // 法線を平均化して長さを正規化
     for (size_t i = 0; i < optimizedVertices.size(); i++) {
         if (normalCount[i] > 0) {
-            smoothedNormals[i].x /= normalCount[i];
-            smoothedNormals[i].y /= normalCount[i];
-            smoothedNormals[i].z /= normalCount[i];
-
-            // 長さを正規化
-            float length = std::sqrt(
-                smoothedNormals[i].x * smoothedNormals[i].x +
-                smoothedNormals[i].y * smoothedNormals[i].y +
-                smoothedNormals[i].z * smoothedNormals[i].z
-            );
-
-            if (length > 0.0001f) {
-                smoothedNormals[i].x /= length;
-                smoothedNormals[i].y /= length;
-                smoothedNormals[i].z /= length;
-            }
+            smoothedNormals[i] /= static_cast<float>(normalCount[i]);
+        }
+    }
+    FastMath::Normalize(smoothedNormals);
 
-            // 平滑化された法線を適用
+    // 平滑化された法線を適用
+    for (size_t i = 0; i < optimizedVertices.size(); i++) {
+        if (normalCount[i] > 0) {
             optimizedVertices[i].normal = smoothedNormals[i];
         }
     }
@@ -237,6 +223,7 @@ void Model::OptimizeTriangles(ModelData& modelData, const std::string& filename)
         (filename.find("globe") != std::string::npos);
 
     if (isSphere) {
+        std::vector<Vector3> blendedNormals(optimizedVertices.size());
         for (size_t i = 0; i < optimizedVertices.size(); i++) {
             // UV座標から球面上の位置を計算
             float u = optimizedVertices[i].texcoord.x;
@@ -245,134 +232,221 @@ void Model::OptimizeTriangles(ModelData& modelData, const std::string& filename)
             // 球面座標
             float phi = u * 2.0f * 3.14159265f;  // 0～2π
             float theta = v * 3.14159265f;       // 0～π
+            float sinPhi, cosPhi, sinTheta, cosTheta;
+            FastMath::SinCos(phi, sinPhi, cosPhi);
+            FastMath::SinCos(theta, sinTheta, cosTheta);
 
             // 球面座標から理論的な法線を計算
-            Vector3 theoreticalNormal;
-            theoreticalNormal.x = std::sin(theta) * std::cos(phi);
-            theoreticalNormal.y = std::cos(theta);
-            theoreticalNormal.z = std::sin(theta) * std::sin(phi);
+            Vector3 theoreticalNormal = { sinTheta * cosPhi, cosTheta, sinTheta * sinPhi };
 
             // 99%理論的な法線を使用して完全な球面を強制
-            Vector3 blendedNormal;
-            blendedNormal.x = 0.99f * theoreticalNormal.x + 0.01f * optimizedVertices[i].normal.x;
-            blendedNormal.y = 0.99f * theoreticalNormal.y + 0.01f * optimizedVertices[i].normal.y;
-            blendedNormal.z = 0.99f * theoreticalNormal.z + 0.01f * optimizedVertices[i].normal.z;
-
-            // 長さを正規化
-            float length = std::sqrt(
-                blendedNormal.x * blendedNormal.x +
-                blendedNormal.y * blendedNormal.y +
-                blendedNormal.z * blendedNormal.z
-            );
-
-            if (length > 0.0001f) {
-                blendedNormal.x /= length;
-                blendedNormal.y /= length;
-                blendedNormal.z /= length;
-            }
+            blendedNormals[i] = 0.99f * theoreticalNormal + 0.01f * optimizedVertices[i].normal;
+        }
 
-            // 混合された法線を適用
-            optimizedVertices[i].normal = blendedNormal;
+        // 長さを正規化して混合された法線を適用
+        FastMath::Normalize(blendedNormals);
+        for (size_t i = 0; i < optimizedVertices.size(); i++) {
+            optimizedVertices[i].normal = blendedNormals[i];
         }
     }
 
-    // インデックスリストから頂点配列を再構築
-    std::vector<VertexData> rebuiltVertices;
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        // 三角形の頂点を追加（順序を維持）
-        if (i + 2 < indices.size()) {
-            rebuiltVertices.push_back(optimizedVertices[indices[i + 2]]);
-            rebuiltVertices.push_back(optimizedVertices[indices[i + 1]]);
-            rebuiltVertices.push_back(optimizedVertices[indices[i]]);
-        }
+    // 三角形の周り順を逆にしたインデックスにする（以前の頂点配列の再構築と同じ順序）
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::swap(indices[i], indices[i + 2]);
     }
 
-    // 最適化された頂点配列で元の配列を置き換え
-    if (!rebuiltVertices.empty()) {
-        modelData.vertices = rebuiltVertices;
+    // マテリアルごとに1回の描画で済むよう、同じマテリアルの三角形を1つの範囲にまとめる
+    // （インデックスの位置は読み込んだ三角形リストの頂点の位置と同じなので、サブメッシュの範囲はそのまま使える）
+    MeshOptimizer::VertexCacheStatistics before = MeshOptimizer::AnalyzeVertexCache(indices, optimizedVertices.size());
+    MeshOptimizer::MergeSubMeshesByMaterial(indices, modelData.subMeshes);
+
+    // 描画順の最適化（頂点シェーダーの実行回数、描画の重なり、頂点の読み込みの順に効く並べ替え）
+    // 三角形の並べ替えはサブメッシュの範囲の中だけで行い、頂点の並べ替えは共有する頂点バッファ全体で行う
+    for (const SubMeshData& subMesh : modelData.subMeshes) {
+        std::span<uint32_t> subMeshIndices(indices.data() + subMesh.indexStart, subMesh.indexCount);
+        MeshOptimizer::OptimizeVertexCache(subMeshIndices, optimizedVertices.size());
+        MeshOptimizer::OptimizeOverdraw(subMeshIndices, optimizedVertices);
     }
+    MeshOptimizer::OptimizeVertexFetch(optimizedVertices, indices);
+    MeshOptimizer::VertexCacheStatistics after = MeshOptimizer::AnalyzeVertexCache(indices, optimizedVertices.size());
+
+    // 統合した頂点とインデックスで元のデータを置き換え
+    modelData.vertices = std::move(optimizedVertices);
+    modelData.indices = std::move(indices);
+
+    OutputDebugStringA(("Model: Welded " + std::to_string(originalVertexCount) + " vertices into " +
+        std::to_string(modelData.vertices.size()) + " - " + filename + "\n").c_str());
+    OutputDebugStringA(("Model: Vertex cache ACMR " + std::to_string(before.acmr) + " -> " + std::to_string(after.acmr) +
+        ", ATVR " + std::to_string(before.atvr) + " -> " + std::to_string(after.atvr) + " - " + filename + "\n").c_str());
 }
 
-ModelData Model::LoadObjFile(const std::string& directoryPath, const std::string& filename) {
-    ModelData modelData; // 構築するModelData
-    std::vector<Vector4> positions; // 位置
-    std::vector<Vector3> normals; // 法線
-    std::vector<Vector2> texcoords; // テクスチャ座標
-    std::string line; // ファイルから読んだ1行を格納するもの
+bool Model::LoadMeshCache(const std::string& cachePath) {
+    MeshCache cache;
+    if (!cache.Open(cachePath) || cache.GetMaterialCount() == 0) {
+        return false;
+    }
+
+    // 頂点とインデックスはマップしたファイルからアップロード用のバッファへ直接書き込み、CPU側には写さない
+    // 書き込みが終わるまではcacheを閉じない（閉じるとspanが無効になる）
+    std::span<const VertexData> vertices = cache.GetVertices();
+    std::span<const uint32_t> indices = cache.GetIndices();
+    CreateBuffers(vertices, indices);
+
+    // 描画範囲とマテリアル、境界は小さいのでコピーしておく
+    std::span<const SubMeshData> subMeshes = cache.GetSubMeshes();
+    modelData_.subMeshes.assign(subMeshes.begin(), subMeshes.end());
+    modelData_.materials.clear();
+    for (uint32_t i = 0; i < cache.GetMaterialCount(); ++i) {
+        modelData_.materials.push_back(cache.GetMaterial(i));
+    }
+    localAABB_ = cache.GetLocalAABB();
+    localBoundingSphere_ = cache.GetLocalBoundingSphere();
+
+    // 元ファイルの更新日時だけが変わっていた場合は、次回ハッシュを計算しなくて済むように書き直す
+    // マップしたままでは上書きできないので、この場合だけは頂点とインデックスを写してから閉じる
+    bool isStampChanged = cache.IsSourceStampChanged();
+    if (isStampChanged) {
+        modelData_.vertices.assign(vertices.begin(), vertices.end());
+        modelData_.indices.assign(indices.begin(), indices.end());
+    }
+    else {
+        modelData_.vertices.clear();
+        modelData_.indices.clear();
+    }
+    std::vector<std::string> sourcePaths = cache.GetSourcePaths();
+    cache.Close();
+    if (isStampChanged) {
+        WriteMeshCache(cachePath, sourcePaths);
+    }
+    meshCachePath_ = cachePath;
 
-    // ファイル読み込み
-    std::ifstream file(directoryPath + "/" + filename); // fileを開く
-    assert(file.is_open()); // 開けなかったら止める
+    OutputDebugStringA(("Model: Loaded from mesh cache: " + cachePath + "\n").c_str());
+    return true;
+}
 
-    OutputDebugStringA(("Model: Loading OBJ file: " + directoryPath + "/" + filename + "\n").c_str());
+void Model::WriteMeshCache(const std::string& cachePath, const std::vector<std::string>& sourcePaths) {
+    MeshCache::Contents contents;
+    contents.vertices = modelData_.vertices;
+    contents.indices = modelData_.indices;
+    contents.materials = modelData_.materials;
+    contents.subMeshes = modelData_.subMeshes;
+    contents.localAABB = localAABB_;
+    contents.localBoundingSphere = localBoundingSphere_;
+    if (MeshCache::Write(cachePath, sourcePaths, contents)) {
+        OutputDebugStringA(("Model: Wrote mesh cache: " + cachePath + "\n").c_str());
+    }
+}
 
-    while (std::getline(file, line)) {
-        std::string identifier;
-        std::istringstream s(line);
-        s >> identifier; // 先頭の識別子を読む
-
-        if (identifier == "v") {
-            Vector4 position;
-            s >> position.x >> position.y >> position.z;
-            position.w = 1.0f;
-            position.x *= -1;
-            positions.push_back(position);
-        }
-        else if (identifier == "vt") {
-            Vector2 texcoord;
-            s >> texcoord.x >> texcoord.y;
-            texcoord.y = 1 - texcoord.y;
-            texcoords.push_back(texcoord);
+// 頂点から境界ボックスと境界球を計算
+void Model::CalculateBounds() {
+    std::vector<Vector3> positions;
+    positions.reserve(modelData_.vertices.size());
+    for (const VertexData& vertex : modelData_.vertices) {
+        positions.push_back({ vertex.position.x, vertex.position.y, vertex.position.z });
+    }
+    localAABB_ = MakeAABB(positions);
+    localBoundingSphere_ = MakeBoundingSphere(positions);
+}
+
+const TriangleMesh& Model::GetTriangleMesh() {
+    if (!isTriangleMeshBuilt_) {
+        // キャッシュから読み込んだ場合はCPU側に頂点を持っていないので、キャッシュをもう一度マップして読む
+        MeshCache cache;
+        std::span<const VertexData> vertices = modelData_.vertices;
+        std::span<const uint32_t> indices = modelData_.indices;
+        if (vertices.empty() && !meshCachePath_.empty()) {
+            if (cache.Open(meshCachePath_)) {
+                vertices = cache.GetVertices();
+                indices = cache.GetIndices();
+            }
+            else {
+                OutputDebugStringA(("WARNING: Model: Failed to reopen mesh cache for raycast - " + meshCachePath_ + "\n").c_str());
+            }
         }
-        else if (identifier == "vn") {
-            Vector3 normal;
-            s >> normal.x >> normal.y >> normal.z;
-            normal.x *= -1;
-            normals.push_back(normal);
+
+        // インデックスをたどって三角形リストの位置に展開する
+        std::vector<Vector3> positions;
+        positions.reserve(indices.size());
+        for (uint32_t index : indices) {
+            const Vector4& position = vertices[index].position;
+            positions.push_back({ position.x, position.y, position.z });
         }
-        else if (identifier == "f") {
-            VertexData triangle[3];
-            // 面は三角形限定。その他は未対応
-            for (int32_t faceVertex = 0; faceVertex < 3; ++faceVertex) {
-                std::string vertexDefinition;
-                s >> vertexDefinition;
-                // 頂点の要素へのIndexは「位置・UV・法線」で格納されているので、分解してIndexを取得する
-                std::istringstream v(vertexDefinition);
-                uint32_t elementIndices[3];
-                for (int32_t element = 0; element < 3; ++element) {
-                    std::string index;
-                    std::getline(v, index, '/'); // 区切りでインデックスを読んでいく
-                    elementIndices[element] = std::stoi(index);
-                }
-                // 要素へのIndexから、実際の要素の値を取得して、頂点を構築する
-                Vector4 position = positions[elementIndices[0] - 1];
-                Vector2 texcoord = texcoords[elementIndices[1] - 1];
-                Vector3 normal = normals[elementIndices[2] - 1];
+        triangleMesh_.Build(positions);
+        isTriangleMeshBuilt_ = true;
+    }
+    return triangleMesh_;
+}
 
-                triangle[faceVertex] = { position, texcoord, normal };
+bool Model::Raycast(const Ray& ray, float maxDistance, MeshRayHit& hit) {
+    return GetTriangleMesh().Raycast(ray, maxDistance, hit);
+}
+
+bool Model::RaycastAny(const Ray& ray, float maxDistance) {
+    return GetTriangleMesh().RaycastAny(ray, maxDistance);
+}
+
+ModelData Model::LoadObjFile(const std::string& directoryPath, const std::string& filename, std::vector<std::string>& outSourcePaths) {
+    ModelData modelData; // 構築するModelData
+
+    OutputDebugStringA(("Model: Loading OBJ file: " + directoryPath + "/" + filename + "\n").c_str());
+
+    // ファイル読み込み（ファイル全体を読み込んでから解析する）
+    ObjFile objFile;
+    bool isLoaded = objFile.Load(directoryPath + "/" + filename);
+    assert(isLoaded); // 開けなかったら止める
+    modelData.vertices = std::move(objFile.GetVertices());
+    outSourcePaths.push_back(directoryPath + "/" + filename);
+
+    std::vector<MaterialData> materialLibrary;
+    const std::string& materialFilename = objFile.GetMaterialLibrary();
+    if (!materialFilename.empty()) {
+        // MTLファイル名をログに出力
+        OutputDebugStringA(("Model: Found MTL reference: " + materialFilename + "\n").c_str());
+
+        // 基本的にobjファイルと同一階層にmtlは存在させるので、ディレクトリ名とファイル名を渡す
+        materialLibrary = LoadMaterialTemplateFile(directoryPath, materialFilename);
+        outSourcePaths.push_back(directoryPath + "/" + materialFilename);
+    }
+
+    // グループごとにサブメッシュを作り、使われたマテリアルを最初に使われた順に登録する
+    for (const ObjFile::Group& group : objFile.GetGroups()) {
+        uint32_t materialIndex = 0;
+        while (materialIndex < modelData.materials.size() && modelData.materials[materialIndex].name != group.materialName) {
+            ++materialIndex;
+        }
+        if (materialIndex == modelData.materials.size()) {
+            // usemtlの指定がなければMTLの最初のマテリアルを使い、MTLに無い名前ならデフォルトの値にする
+            auto found = std::find_if(materialLibrary.begin(), materialLibrary.end(), [&group](const MaterialData& material) {
+                return material.name == group.materialName;
+            });
+            MaterialData material;
+            if (found != materialLibrary.end()) {
+                material = *found;
+            }
+            else if (group.materialName.empty() && !materialLibrary.empty()) {
+                material = materialLibrary.front();
+            }
+            else {
+                OutputDebugStringA(("WARNING: Model: Material not found in MTL file - " + group.materialName + "\n").c_str());
             }
-            // 頂点を逆順で登録することで、周り順を逆にする
-            modelData.vertices.push_back(triangle[2]);
-            modelData.vertices.push_back(triangle[1]);
-            modelData.vertices.push_back(triangle[0]);
+            material.name = group.materialName;
+            modelData.materials.push_back(material);
         }
-        else if (identifier == "mtllib") {
-            // materialTemplateLibraryファイルの名前を取得する
-            std::string materialFilename;
-            s >> materialFilename;
+        modelData.subMeshes.push_back({ group.vertexStart, group.vertexCount, materialIndex });
 
-            // MTLファイル名をログに出力
-            OutputDebugStringA(("Model: Found MTL reference: " + materialFilename + "\n").c_str());
+        OutputDebugStringA(("Model: Group \"" + group.name + "\" uses material \"" + group.materialName + "\" (" +
+            std::to_string(group.vertexCount / 3) + " triangles)\n").c_str());
+    }
 
-            // 基本的にobjファイルと同一階層にmtlは存在させるので、ディレクトリ名とファイル名を渡す
-            modelData.material = LoadMaterialTemplateFile(directoryPath, materialFilename);
-        }
+    // 面が1つもなくても描画用のマテリアルは1つ用意しておく
+    if (modelData.materials.empty()) {
+        modelData.materials.push_back(materialLibrary.empty() ? MaterialData() : materialLibrary.front());
     }
     return modelData;
 }
 
-MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename) {
-    MaterialData materialData; // 構築するMaterialData
+std::vector<MaterialData> Model::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename) {
+    std::vector<MaterialData> materials; // 構築するMaterialDataの一覧（newmtlごとに1つ）
     std::string line; // ファイルから読んだ1行を格納するもの
 
     // ファイルのフルパス
@@ -382,7 +456,7 @@ MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, c
     // ファイルが開けなかった場合は警告を出力して、デフォルト値を返す
     if (!file.is_open()) {
         OutputDebugStringA(("WARNING: Failed to open MTL file - " + mtlPath + "\n").c_str());
-        return materialData;
+        return materials;
     }
 
     OutputDebugStringA(("Model: Successfully opened MTL file - " + mtlPath + "\n").c_str());
@@ -392,6 +466,22 @@ MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, c
         std::stringstream s(line);
         s >> identifier;
 
+        // newmtlで新しいマテリアルを始める（名前には空白が含まれることがあるので行の残りを名前とする）
+        if (identifier == "newmtl") {
+            MaterialData newMaterial;
+            std::getline(s >> std::ws, newMaterial.name);
+            while (!newMaterial.name.empty() && std::isspace(static_cast<unsigned char>(newMaterial.name.back()))) {
+                newMaterial.name.pop_back();
+            }
+            materials.push_back(newMaterial);
+            continue;
+        }
+        // newmtlより前の行（コメントなど）は読み飛ばす
+        if (materials.empty()) {
+            continue;
+        }
+        MaterialData& materialData = materials.back();
+
         // identifierの応じた処理
         if (identifier == "map_Kd") {
             std::string textureFilename;
@@ -438,5 +528,5 @@ MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, c
         }
     }
 
-    return materialData;
+    return materials;
 }
\ No newline at end of file
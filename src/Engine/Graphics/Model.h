@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <string>
 #include <vector>
 #include "Vector2.h"
@@ -9,6 +10,8 @@
 #include <wrl.h>
 #include "DirectXCommon.h"
 #include "Mymath.h"
+#include "Bounds.h"
+#include "TriangleMesh.h"
 
 // モデルデータクラス
 class Model {
@@ -25,28 +28,77 @@ public:
     void LoadFromObj(const std::string& directoryPath, const std::string& filename);
 
     // アクセサ
+    // 頂点とインデックスの配列はOBJから読み込んだときだけCPU側に残る（キャッシュから読み込んだ場合は空、数はGPUのバッファのもの）
     const std::vector<VertexData>& GetVertices() const { return modelData_.vertices; }
-    uint32_t GetVertexCount() const { return static_cast<uint32_t>(modelData_.vertices.size()); }
-    const MaterialData& GetMaterial() const { return modelData_.material; }
-    const std::string& GetTextureFilePath() const { return modelData_.material.textureFilePath; }
+    uint32_t GetVertexCount() const { return vertexCount_; }
+    const std::vector<uint32_t>& GetIndices() const { return modelData_.indices; }
+    uint32_t GetIndexCount() const { return indexCount_; }
+    const std::vector<MaterialData>& GetMaterials() const { return modelData_.materials; }
+    uint32_t GetMaterialCount() const { return static_cast<uint32_t>(modelData_.materials.size()); }
+    const MaterialData& GetMaterial(uint32_t index) const { return modelData_.materials[index]; }
+    // マテリアルごとの描画範囲（1つの頂点バッファとインデックスバッファを共有する）
+    const std::vector<SubMeshData>& GetSubMeshes() const { return modelData_.subMeshes; }
     const D3D12_VERTEX_BUFFER_VIEW& GetVBView() const { return vertexBufferView_; }
     ID3D12Resource* GetVertexResource() const { return vertexResource_.Get(); }
+    const D3D12_INDEX_BUFFER_VIEW& GetIBView() const { return indexBufferView_; }
+
+    // ローカル空間での境界（読み込み時に計算する）
+    const AABB& GetLocalAABB() const { return localAABB_; }
+    const Sphere& GetLocalBoundingSphere() const { return localBoundingSphere_; }
+
+    // レイキャスト用の三角形メッシュ（初めて使うときに頂点から構築する）
+    const TriangleMesh& GetTriangleMesh();
+
+    // ローカル空間のレイで最も近い交点を求める（マウスでの選択など）
+    bool Raycast(const Ray& ray, float maxDistance, MeshRayHit& hit);
+
+    // ローカル空間のレイがmaxDistance以内で当たるか（視線や射線の遮蔽判定など）
+    bool RaycastAny(const Ray& ray, float maxDistance);
 
 private:
     // モデルデータの最適化（UV球など改善のため）
     void OptimizeTriangles(ModelData& modelData, const std::string& filename);
 
-    // モデルデータの読み込み
-    ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename);
-    // マテリアルデータの読み込み
-    MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
+    // マテリアルのテクスチャの読み込み
+    void LoadMaterialTexture(MaterialData& material, const std::string& directoryPath);
+
+    // 頂点から境界を計算
+    void CalculateBounds();
+
+    // 頂点バッファとインデックスバッファの作成と書き込み
+    void CreateBuffers(std::span<const VertexData> vertices, std::span<const uint32_t> indices);
+
+    // キャッシュからの読み込み（使えるキャッシュがなければfalse）
+    bool LoadMeshCache(const std::string& cachePath);
+    // キャッシュの書き出し
+    void WriteMeshCache(const std::string& cachePath, const std::vector<std::string>& sourcePaths);
+
+    // モデルデータの読み込み（読み込んだOBJとMTLのパスをoutSourcePathsに追加する）
+    ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename, std::vector<std::string>& outSourcePaths);
+    // マテリアルデータの読み込み（MTLファイルのすべてのマテリアル）
+    std::vector<MaterialData> LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
 
     // モデルデータ
     ModelData modelData_;
+    // ローカル空間での境界
+    AABB localAABB_ = {};
+    Sphere localBoundingSphere_ = {};
+    // キャッシュから読み込んだ場合のキャッシュのパス（レイキャスト用のメッシュを作るときに開き直す）
+    std::string meshCachePath_;
+    // GPUのバッファの頂点数とインデックス数
+    uint32_t vertexCount_ = 0;
+    uint32_t indexCount_ = 0;
+    // レイキャスト用の三角形メッシュ
+    TriangleMesh triangleMesh_;
+    bool isTriangleMeshBuilt_ = false;
     // 頂点バッファ
     Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource_;
     // 頂点バッファビュー
     D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+    // インデックスバッファ
+    Microsoft::WRL::ComPtr<ID3D12Resource> indexResource_;
+    // インデックスバッファビュー
+    D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
     // DirectXCommon
     DirectXCommon* dxCommon_;
 };
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include "ObjFile.h"
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include "Logger.h"
+
+namespace
+{
+    // 行内の空白（改行は含まない）
+    bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // 行内の空白を読み飛ばす
+    void SkipSpaces(const char*& p, const char* end) {
+        while (p < end && IsSpace(*p)) {
+            ++p;
+        }
+    }
+
+    // 次の行の先頭まで進める
+    void SkipLine(const char*& p, const char* end) {
+        while (p < end && *p != '\n') {
+            ++p;
+        }
+        if (p < end) {
+            ++p;
+        }
+    }
+
+    // 空白までの1語を読む
+    std::string_view ReadToken(const char*& p, const char* end) {
+        SkipSpaces(p, end);
+        const char* begin = p;
+        while (p < end && !IsSpace(*p) && *p != '\n') {
+            ++p;
+        }
+        return std::string_view(begin, p - begin);
+    }
+
+    // 行末までを1つの名前として読む（ファイル名やマテリアル名には空白が含まれることがある、前後の空白は除く）
+    std::string_view ReadRestOfLine(const char*& p, const char* end) {
+        SkipSpaces(p, end);
+        const char* begin = p;
+        const char* last = p;
+        while (p < end && *p != '\n') {
+            if (!IsSpace(*p)) {
+                last = p + 1;
+            }
+            ++p;
+        }
+        return std::string_view(begin, last - begin);
+    }
+
+    // 10の累乗（floatで正確に表せる範囲）
+    const float kPowersOf10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+    // 小数を1つ読む（読めなければ0）
+    float ReadFloat(const char*& p, const char* end) {
+        SkipSpaces(p, end);
+        // from_charsは先頭の'+'を受け付けないので飛ばしておく
+        if (p < end && *p == '+') {
+            ++p;
+        }
+
+        // 指数表記のない短い小数（OBJのほとんどの数値）は整数部と小数部を1つの整数として読み、10の累乗で割る
+        // 仮数が2^24以下、割る数が10^10以下ならどちらもfloatで正確に表せるので、1回の除算で正しく丸められた値になる
+        const char* q = p;
+        bool isNegative = q < end && *q == '-';
+        q += isNegative;
+        uint32_t mantissa = 0;
+        int32_t digitCount = 0;
+        int32_t fractionCount = 0;
+        bool isFraction = false;
+        for (; q < end; ++q) {
+            if (*q >= '0' && *q <= '9') {
+                mantissa = mantissa * 10 + uint32_t(*q - '0');
+                ++digitCount;
+                fractionCount += isFraction;
+                if (mantissa > (1u << 24)) {
+                    break;
+                }
+            }
+            else if (*q == '.' && !isFraction) {
+                isFraction = true;
+            }
+            else {
+                break;
+            }
+        }
+        bool isSimple = digitCount > 0 && mantissa <= (1u << 24) && fractionCount <= 10 &&
+            (q >= end || (*q != 'e' && *q != 'E' && !(*q >= '0' && *q <= '9')));
+        if (isSimple) {
+            p = q;
+            float value = static_cast<float>(mantissa) / kPowersOf10[fractionCount];
+            return isNegative ? -value : value;
+        }
+
+        // それ以外（桁数が多い、指数表記など）は標準ライブラリで読む
+        float value = 0.0f;
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec == std::errc()) {
+            p = result.ptr;
+        }
+        return value;
+    }
+
+    // 整数を1つ読む（読めなければ0、OBJのインデックスは1始まりなので0は「指定なし」を表す）
+    int32_t ReadIndex(const char*& p, const char* end) {
+        bool isNegative = p < end && *p == '-';
+        const char* q = p + isNegative;
+        int64_t value = 0;
+        for (; q < end && *q >= '0' && *q <= '9' && value <= INT32_MAX; ++q) {
+            value = value * 10 + (*q - '0');
+        }
+        if (q == p + isNegative || value > INT32_MAX) {
+            return 0;
+        }
+        p = q;
+        return static_cast<int32_t>(isNegative ? -value : value);
+    }
+
+    // OBJのインデックスを配列の添字にする（負なら末尾からの相対位置、範囲外なら-1）
+    int32_t ResolveIndex(int32_t index, size_t count) {
+        int64_t resolved = index > 0 ? int64_t(index) - 1 : int64_t(count) + index;
+        if (index == 0 || resolved < 0 || resolved >= int64_t(count)) {
+            return -1;
+        }
+        return static_cast<int32_t>(resolved);
+    }
+}
+
+bool ObjFile::Load(const std::string& filePath) {
+    // ファイル全体を1回で読み込む
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        Logger::Log("ObjFile: Failed to open file - " + filePath + "\n");
+        return false;
+    }
+    std::string text(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0, std::ios::beg);
+    file.read(text.data(), text.size());
+
+    Parse(text);
+
+    if (statistics_.skippedFaceCount > 0) {
+        Logger::Log("WARNING: ObjFile: Skipped " + std::to_string(statistics_.skippedFaceCount) +
+            " faces with invalid indices - " + filePath + "\n");
+    }
+    return true;
+}
+
+void ObjFile::Parse(std::string_view text) {
+    positions_.clear();
+    texcoords_.clear();
+    normals_.clear();
+    vertices_.clear();
+    materialLibrary_.clear();
+    groups_.clear();
+    groups_.push_back(Group());
+    statistics_ = {};
+
+    // 配列の再確保と中身のコピーを避けるため、先に行の種類を数えて領域を確保しておく
+    size_t positionCount = 0;
+    size_t texcoordCount = 0;
+    size_t normalCount = 0;
+    size_t faceCount = 0;
+    for (size_t i = 0; i + 1 < text.size(); ++i) {
+        if (i == 0 || text[i - 1] == '\n') {
+            if (text[i] == 'v') {
+                char next = text[i + 1];
+                positionCount += IsSpace(next);
+                texcoordCount += next == 't';
+                normalCount += next == 'n';
+            }
+            else if (text[i] == 'f') {
+                faceCount += IsSpace(text[i + 1]);
+            }
+        }
+    }
+    positions_.reserve(positionCount);
+    texcoords_.reserve(texcoordCount);
+    normals_.reserve(normalCount);
+    vertices_.reserve(faceCount * 3);
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        std::string_view identifier = ReadToken(p, end);
+
+        if (identifier == "v") {
+            Vector4 position;
+            position.x = -ReadFloat(p, end);
+            position.y = ReadFloat(p, end);
+            position.z = ReadFloat(p, end);
+            position.w = 1.0f;
+            positions_.push_back(position);
+        }
+        else if (identifier == "vt") {
+            Vector2 texcoord;
+            texcoord.x = ReadFloat(p, end);
+            texcoord.y = 1.0f - ReadFloat(p, end);
+            texcoords_.push_back(texcoord);
+        }
+        else if (identifier == "vn") {
+            Vector3 normal;
+            normal.x = -ReadFloat(p, end);
+            normal.y = ReadFloat(p, end);
+            normal.z = ReadFloat(p, end);
+            normals_.push_back(normal);
+        }
+        else if (identifier == "f") {
+            AddFace(p, end);
+        }
+        else if (identifier == "usemtl") {
+            std::string_view materialName = ReadRestOfLine(p, end);
+            BeginGroup(groups_.back().name, materialName);
+        }
+        else if (identifier == "o" || identifier == "g") {
+            std::string_view name = ReadRestOfLine(p, end);
+            BeginGroup(name, groups_.back().materialName);
+        }
+        else if (identifier == "mtllib") {
+            std::string_view materialLibrary = ReadRestOfLine(p, end);
+            if (materialLibrary_.empty()) {
+                materialLibrary_ = materialLibrary;
+            }
+        }
+        // 読んだ要素の残り（vの頂点カラーやvtの3要素目など）やコメント、未対応の行は読み飛ばす
+        SkipLine(p, end);
+    }
+
+    // 最後のグループを閉じて、頂点のないグループを除く
+    groups_.back().vertexCount = static_cast<uint32_t>(vertices_.size()) - groups_.back().vertexStart;
+    std::erase_if(groups_, [](const Group& group) { return group.vertexCount == 0; });
+
+    statistics_.positionCount = static_cast<uint32_t>(positions_.size());
+    statistics_.texcoordCount = static_cast<uint32_t>(texcoords_.size());
+    statistics_.normalCount = static_cast<uint32_t>(normals_.size());
+}
+
+void ObjFile::AddFace(const char*& p, const char* end) {
+    faceVertices_.clear();
+    bool isValid = true;
+
+    // 行末まで「位置/UV/法線」の組を読む（UVと法線は省略できる）
+    while (true) {
+        SkipSpaces(p, end);
+        if (p >= end || *p == '\n' || *p == '#') {
+            break;
+        }
+        int32_t elementIndices[3] = { 0, 0, 0 };
+        for (int32_t element = 0; element < 3; ++element) {
+            elementIndices[element] = ReadIndex(p, end);
+            if (p >= end || *p != '/') {
+                break;
+            }
+            ++p;
+        }
+        // 区切りの後に数字以外が続いた場合などは、その語の残りを読み飛ばす
+        while (p < end && !IsSpace(*p) && *p != '\n') {
+            ++p;
+        }
+
+        VertexData vertex = { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+        int32_t position = ResolveIndex(elementIndices[0], positions_.size());
+        if (position < 0) {
+            isValid = false;
+            continue;
+        }
+        vertex.position = positions_[position];
+        if (elementIndices[1] != 0) {
+            int32_t texcoord = ResolveIndex(elementIndices[1], texcoords_.size());
+            if (texcoord < 0) {
+                isValid = false;
+                continue;
+            }
+            vertex.texcoord = texcoords_[texcoord];
+        }
+        if (elementIndices[2] != 0) {
+            int32_t normal = ResolveIndex(elementIndices[2], normals_.size());
+            if (normal < 0) {
+                isValid = false;
+                continue;
+            }
+            vertex.normal = normals_[normal];
+        }
+        faceVertices_.push_back(vertex);
+    }
+
+    if (!isValid || faceVertices_.size() < 3) {
+        ++statistics_.skippedFaceCount;
+        return;
+    }
+    ++statistics_.faceCount;
+
+    // 1頂点目を中心に扇形に分割し、頂点を逆順で登録することで周り順を逆にする
+    for (size_t i = 1; i + 1 < faceVertices_.size(); ++i) {
+        vertices_.push_back(faceVertices_[i + 1]);
+        vertices_.push_back(faceVertices_[i]);
+        vertices_.push_back(faceVertices_[0]);
+    }
+}
+
+void ObjFile::BeginGroup(std::string_view name, std::string_view materialName) {
+    // 引数が今のグループの文字列を指していることがあるので、先にコピーしておく
+    Group group;
+    group.name = name;
+    group.materialName = materialName;
+    group.vertexStart = static_cast<uint32_t>(vertices_.size());
+
+    Group& current = groups_.back();
+    if (current.name == group.name && current.materialName == group.materialName) {
+        return;
+    }
+    if (current.vertexStart == group.vertexStart) {
+        current = std::move(group);
+        return;
+    }
+    current.vertexCount = group.vertexStart - current.vertexStart;
+    groups_.push_back(std::move(group));
+}
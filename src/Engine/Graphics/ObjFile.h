@@ -0,0 +1,76 @@
+#pragma once
+#include "Mymath.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// OBJファイルクラス
+// ファイル全体を1つのバッファに読み込み、行ごとのストリームを作らずに直接解析する（数値はstd::from_charsで読む）
+// 面は「v」「v/vt」「v//vn」「v/vt/vn」の形式と負のインデックス（末尾からの相対位置）に対応し、
+// 4頂点以上の面は1頂点目を中心とした扇形に三角形分割する
+// 座標系はこれまでのModelの読み込みと同じで、位置と法線のxを反転、テクスチャ座標のvを反転し、三角形の周り順を逆にする
+// 「o」「g」「usemtl」が現れるたびに頂点の範囲（グループ）を区切り、どのマテリアルで描画するかを記録する
+class ObjFile {
+public:
+    // オブジェクト（o）またはグループ（g）とマテリアル（usemtl）が同じ、連続した三角形の範囲
+    struct Group {
+        // oまたはgの名前（最後に指定されたもの）
+        std::string name;
+        // usemtlのマテリアル名（指定がなければ空）
+        std::string materialName;
+        // GetVerticesでの最初の頂点の位置と頂点の数
+        uint32_t vertexStart = 0;
+        uint32_t vertexCount = 0;
+    };
+
+    // 読み込み結果の統計
+    struct Statistics {
+        uint32_t positionCount = 0;
+        uint32_t texcoordCount = 0;
+        uint32_t normalCount = 0;
+        uint32_t faceCount = 0;
+        // インデックスが範囲外などで読み飛ばした面の数
+        uint32_t skippedFaceCount = 0;
+    };
+
+    // ファイルの読み込み（開けなければfalse）
+    bool Load(const std::string& filePath);
+
+    // メモリ上のテキストの解析（前回の結果は破棄する）
+    void Parse(std::string_view text);
+
+    // 三角形リストの頂点（呼び出し側でmoveして受け取れるように非constで返す）
+    std::vector<VertexData>& GetVertices() { return vertices_; }
+
+    // 三角形の範囲（頂点のないグループは含まない）
+    const std::vector<Group>& GetGroups() const { return groups_; }
+
+    // mtllibで指定されたマテリアルファイル名（指定がなければ空）
+    const std::string& GetMaterialLibrary() const { return materialLibrary_; }
+
+    // 統計の取得
+    const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+    // 1つの面を三角形に分割して頂点を追加する
+    void AddFace(const char*& p, const char* end);
+
+    // 新しいグループを始める（今のグループに頂点がなければ名前とマテリアルを置き換える）
+    void BeginGroup(std::string_view name, std::string_view materialName);
+
+    // 読み込み中の要素
+    std::vector<Vector4> positions_;
+    std::vector<Vector2> texcoords_;
+    std::vector<Vector3> normals_;
+    // 三角形リストの頂点
+    std::vector<VertexData> vertices_;
+    // 三角形の範囲
+    std::vector<Group> groups_;
+    // 面の頂点（分割前の一時領域）
+    std::vector<VertexData> faceVertices_;
+    // mtllibのファイル名
+    std::string materialLibrary_;
+    // 統計
+    Statistics statistics_;
+};
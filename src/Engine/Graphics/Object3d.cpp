@@ -4,15 +4,19 @@
 #include "SpriteCommon.h"
 #include "Math.h"
 #include "TextureManager.h"
+#include "TransformBatch.h"
 
+namespace
+{
+    // マテリアルごとの定数バッファの間隔（定数バッファの場所は256バイト境界でなければならない）
+    const uint32_t kMaterialStride = (sizeof(Material) + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1) &
+        ~(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1);
+}
 
 Object3d::Object3d() : model_(nullptr), dxCommon_(nullptr), spriteCommon_(nullptr),
-materialData_(nullptr), transformationMatrixData_(nullptr), directionalLightData_(nullptr),
+transformationMatrixData_(nullptr), directionalLightData_(nullptr),
 camera_(nullptr) {
-    // 初期値設定
-    transform_.scale = { 1.0f, 1.0f, 1.0f };
-    transform_.rotate = { 0.0f, 0.0f, 0.0f };
-    transform_.translate = { 0.0f, 0.0f, 0.0f };
+    // トランスフォームの初期値（スケール1、回転0、平行移動0）はTransformComponentで設定される
 }
 
 Object3d::~Object3d() {}
@@ -23,13 +27,8 @@ void Object3d::Initialize(DirectXCommon* dxCommon, SpriteCommon* spriteCommon) {
     dxCommon_ = dxCommon;
     spriteCommon_ = spriteCommon;
 
-    // マテリアルリソースの作成
-    materialResource_ = dxCommon_->CreateBufferResource(sizeof(Material));
-    // マテリアルデータの書き込み
-    materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
-    materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
-    materialData_->enableLighting = true;
-    materialData_->uvTransform = MakeIdentity4x4();
+    // マテリアルリソースの作成（モデルを設定したときにマテリアルの数に合わせて作り直す）
+    CreateMaterialResource(1);
 
     // 変換行列リソースの作成
     transformationMatrixResource_ = dxCommon_->CreateBufferResource(sizeof(TransformationMatrix));
@@ -51,42 +50,81 @@ void Object3d::SetModel(Model* model) {
     model_ = model;
 
     // モデルのマテリアル情報をシェーダーに設定
-    if (model_ && materialData_) {
-        const MaterialData& modelMaterial = model_->GetMaterial();
-
-        // マテリアルデータをシェーダーのMaterial構造体に反映
-        // シェーダーのcolor変数にdiffuse色を設定
-        materialData_->color = modelMaterial.diffuse;
-
-        // アルファ値も設定
-        materialData_->color.w = modelMaterial.alpha;
-
-        // モデルのテクスチャパスの確認
-        std::string texturePath = model_->GetTextureFilePath();
-        OutputDebugStringA(("Object3d::SetModel - Model texture path: " + texturePath + "\n").c_str());
+    if (model_ && !materialData_.empty()) {
+        // マテリアルの数が変わる場合は定数バッファを作り直す
+        if (model_->GetMaterialCount() != materialData_.size()) {
+            CreateMaterialResource(model_->GetMaterialCount());
+        }
 
-        if (!texturePath.empty()) {
-            // テクスチャが未ロードなら読み込む
-            if (!TextureManager::GetInstance()->IsTextureExists(texturePath)) {
-                OutputDebugStringA(("Object3d::SetModel - Loading texture: " + texturePath + "\n").c_str());
-                TextureManager::GetInstance()->LoadTexture(texturePath);
+        for (uint32_t i = 0; i < model_->GetMaterialCount(); ++i) {
+            const MaterialData& modelMaterial = model_->GetMaterial(i);
+            Material* materialData = materialData_[i];
+
+            // マテリアルデータをシェーダーのMaterial構造体に反映
+            // シェーダーのcolor変数にdiffuse色を設定
+            materialData->color = modelMaterial.diffuse;
+
+            // アルファ値も設定
+            materialData->color.w = modelMaterial.alpha;
+
+            // モデルのテクスチャパスの確認
+            const std::string& texturePath = modelMaterial.textureFilePath;
+            OutputDebugStringA(("Object3d::SetModel - Material \"" + modelMaterial.name + "\" texture path: " + texturePath + "\n").c_str());
+
+            if (!texturePath.empty()) {
+                // テクスチャが未ロードなら読み込む
+                if (!TextureManager::GetInstance()->IsTextureExists(texturePath)) {
+                    OutputDebugStringA(("Object3d::SetModel - Loading texture: " + texturePath + "\n").c_str());
+                    TextureManager::GetInstance()->LoadTexture(texturePath);
+                }
+                else {
+                    OutputDebugStringA(("Object3d::SetModel - Texture already loaded: " + texturePath + "\n").c_str());
+                }
             }
             else {
-                OutputDebugStringA(("Object3d::SetModel - Texture already loaded: " + texturePath + "\n").c_str());
+                OutputDebugStringA("Object3d::SetModel - No texture path provided by model\n");
             }
+
+            // デバッグ情報
+            OutputDebugStringA(("Object3d::SetModel - Material information (" + modelMaterial.name + "):\n").c_str());
+            OutputDebugStringA(("  - Diffuse (RGBA): " +
+                std::to_string(materialData->color.x) + ", " +
+                std::to_string(materialData->color.y) + ", " +
+                std::to_string(materialData->color.z) + ", " +
+                std::to_string(materialData->color.w) + "\n").c_str());
+            OutputDebugStringA(("  - Texture: " + (texturePath.empty() ? "None" : texturePath) + "\n").c_str());
         }
-        else {
-            OutputDebugStringA("Object3d::SetModel - No texture path provided by model\n");
-        }
+    }
+}
 
-        // デバッグ情報
-        OutputDebugStringA("Object3d::SetModel - Material information:\n");
-        OutputDebugStringA(("  - Diffuse (RGBA): " +
-            std::to_string(materialData_->color.x) + ", " +
-            std::to_string(materialData_->color.y) + ", " +
-            std::to_string(materialData_->color.z) + ", " +
-            std::to_string(materialData_->color.w) + "\n").c_str());
-        OutputDebugStringA(("  - Texture: " + (texturePath.empty() ? "None" : texturePath) + "\n").c_str());
+void Object3d::SetColor(const Vector4& color) {
+    for (Material* materialData : materialData_) {
+        materialData->color = color;
+    }
+}
+
+void Object3d::SetEnableLighting(bool enable) {
+    for (Material* materialData : materialData_) {
+        materialData->enableLighting = enable ? 1 : 0;
+    }
+}
+
+void Object3d::CreateMaterialResource(uint32_t materialCount) {
+    assert(materialCount > 0);
+    // 作り直す前のライトの設定（最初は有効）
+    int32_t enableLighting = materialData_.empty() ? 1 : materialData_[0]->enableLighting;
+
+    materialResource_ = dxCommon_->CreateBufferResource(static_cast<size_t>(kMaterialStride) * materialCount);
+
+    // マテリアルデータの書き込み
+    uint8_t* mappedData = nullptr;
+    materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
+    materialData_.resize(materialCount);
+    for (uint32_t i = 0; i < materialCount; ++i) {
+        materialData_[i] = reinterpret_cast<Material*>(mappedData + static_cast<size_t>(kMaterialStride) * i);
+        materialData_[i]->color = { 1.0f, 1.0f, 1.0f, 1.0f };
+        materialData_[i]->enableLighting = enableLighting;
+        materialData_[i]->uvTransform = MakeIdentity4x4();
     }
 }
 
@@ -94,8 +132,8 @@ void Object3d::SetModel(Model* model) {
 void Object3d::Update(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix) {
     assert(transformationMatrixData_);
 
-    // ワールド行列の計算
-    Matrix4x4 worldMatrix = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+    // ワールド行列の取得（トランスフォームが変わったときだけ作り直される）
+    const Matrix4x4& worldMatrix = transform_.GetWorldMatrix();
 
     // WVP行列の計算
     Matrix4x4 worldViewProjectionMatrix = Multiply(worldMatrix, Multiply(viewMatrix, projectionMatrix));
@@ -103,6 +141,9 @@ void Object3d::Update(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMa
     // 行列の更新
     transformationMatrixData_->WVP = worldViewProjectionMatrix;
     transformationMatrixData_->World = worldMatrix;
+
+    // 外部から渡された行列は変化を追えないので、次のカメラ版Updateでは必ず書き込む
+    isMatrixWritten_ = false;
 }
 
 // カメラセッター
@@ -128,8 +169,13 @@ void Object3d::Update() {
     // カメラが有効かチェック
     assert(useCamera);
 
-    // ワールド行列の計算
-    Matrix4x4 worldMatrix = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+    // トランスフォームもカメラも変わっていなければ、書き込み済みの行列をそのまま使う
+    if (!NeedsMatrixUpdate(useCamera)) {
+        return;
+    }
+
+    // ワールド行列の取得（トランスフォームが変わったときだけ作り直される）
+    const Matrix4x4& worldMatrix = transform_.GetWorldMatrix();
 
     // WVP行列の計算（カメラからビュープロジェクション行列を取得）
     Matrix4x4 worldViewProjectionMatrix = Multiply(worldMatrix, useCamera->GetViewProjectionMatrix());
@@ -137,6 +183,117 @@ void Object3d::Update() {
     // 行列の更新
     transformationMatrixData_->WVP = worldViewProjectionMatrix;
     transformationMatrixData_->World = worldMatrix;
+    MarkMatrixWritten(useCamera);
+}
+
+bool Object3d::NeedsMatrixUpdate(const Camera* camera) const {
+    return !isMatrixWritten_ ||
+        writtenTransformVersion_ != transform_.GetVersion() ||
+        writtenCamera_ != camera ||
+        writtenViewProjectionVersion_ != camera->GetViewProjectionVersion();
+}
+
+void Object3d::MarkMatrixWritten(const Camera* camera) {
+    isMatrixWritten_ = true;
+    writtenTransformVersion_ = transform_.GetVersion();
+    writtenCamera_ = camera;
+    writtenViewProjectionVersion_ = camera->GetViewProjectionVersion();
+}
+
+// 複数のオブジェクトをまとめて更新
+void Object3d::UpdateBatch(std::span<Object3d* const> objects, const Camera* camera) {
+    if (objects.empty()) {
+        return;
+    }
+
+    // カメラが指定されていない場合はデフォルトカメラを使用
+    if (!camera) {
+        camera = Object3dCommon::GetDefaultCamera();
+    }
+    assert(camera);
+
+    // 毎フレームの確保を避けるため作業用配列は使い回す（メインスレッドからのみ呼ぶこと）
+    static TransformSoA transforms;
+    static std::vector<TransformationMatrix*> destinations;
+    transforms.Clear();
+    destinations.clear();
+
+    // トランスフォームかカメラが変わったものだけ集める
+    for (Object3d* object : objects) {
+        assert(object->transformationMatrixData_);
+        if (!object->NeedsMatrixUpdate(camera)) {
+            continue;
+        }
+        transforms.Add(object->transform_.GetTransform());
+        destinations.push_back(object->transformationMatrixData_);
+        object->MarkMatrixWritten(camera);
+    }
+
+    // 行列の計算（Map済みの定数バッファへ直接書き込む）
+    ComputeWorldWVP(transforms, camera->GetViewProjectionMatrix(), std::span<TransformationMatrix* const>(destinations));
+}
+
+Sphere Object3d::GetWorldBoundingSphere() {
+    assert(model_);
+    return TransformSphere(model_->GetLocalBoundingSphere(), transform_.GetWorldMatrix());
+}
+
+AABB Object3d::GetWorldAABB() {
+    assert(model_);
+    return TransformAABB(model_->GetLocalAABB(), transform_.GetWorldMatrix());
+}
+
+bool Object3d::Raycast(const Ray& ray, float maxDistance, MeshRayHit& hit) {
+    if (!model_) {
+        return false;
+    }
+    // 方向を正規化し直さないので、ローカル空間での交差距離がそのままワールド空間での距離になる
+    Ray localRay = TransformRay(ray, InverseAffine(transform_.GetWorldMatrix()));
+    return model_->Raycast(localRay, maxDistance, hit);
+}
+
+bool Object3d::RaycastAny(const Ray& ray, float maxDistance) {
+    if (!model_) {
+        return false;
+    }
+    Ray localRay = TransformRay(ray, InverseAffine(transform_.GetWorldMatrix()));
+    return model_->RaycastAny(localRay, maxDistance);
+}
+
+bool Object3d::IsVisible(const Frustum& frustum) {
+    // モデルがなければ境界がわからないので、カリングしない
+    if (!model_) {
+        return true;
+    }
+    return IsSphereInFrustum(frustum, GetWorldBoundingSphere());
+}
+
+void Object3d::CullObjects(std::span<Object3d* const> objects, const Frustum& frustum, std::vector<Object3d*>& visibleObjects) {
+    visibleObjects.clear();
+
+    // 毎フレームの確保を避けるため作業用配列は使い回す（メインスレッドからのみ呼ぶこと）
+    static std::vector<Sphere> spheres;
+    static std::vector<uint32_t> sphereOwners;
+    static std::vector<uint32_t> visibleIndices;
+    spheres.clear();
+    sphereOwners.clear();
+
+    // モデルのないオブジェクトはそのまま可視とし、それ以外の境界球を集める
+    for (uint32_t i = 0; i < objects.size(); ++i) {
+        if (!objects[i]->model_) {
+            visibleObjects.push_back(objects[i]);
+            continue;
+        }
+        spheres.push_back(objects[i]->GetWorldBoundingSphere());
+        sphereOwners.push_back(i);
+    }
+
+    // まとめて判定
+    visibleIndices.resize(spheres.size());
+    uint32_t visibleCount = CullSpheres(frustum, spheres, visibleIndices);
+    for (uint32_t i = 0; i < visibleCount; ++i) {
+        visibleObjects.push_back(objects[sphereOwners[visibleIndices[i]]]);
+    }
 }
 
 void Object3d::Draw() {
@@ -146,17 +303,36 @@ void Object3d::Draw() {
     // 共通描画設定
     spriteCommon_->CommonDraw();
 
-    // モデルの頂点バッファをセット
+    // モデルの頂点バッファとインデックスバッファをセット
     dxCommon_->GetCommandList()->IASetVertexBuffers(0, 1, &model_->GetVBView());
-
-    // マテリアルCBufferの場所を設定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+    dxCommon_->GetCommandList()->IASetIndexBuffer(&model_->GetIBView());
 
     // 変換行列CBufferの場所を設定
     dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, transformationMatrixResource_->GetGPUVirtualAddress());
 
-    // テクスチャの場所を設定
-    std::string texturePath = model_->GetTextureFilePath();
+    // ライトCBufferの場所を設定
+    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(3, directionalLightResource_->GetGPUVirtualAddress());
+
+    // マテリアルごとに定数バッファとテクスチャを切り替えて、その範囲のインデックスを描画する
+    for (const SubMeshData& subMesh : model_->GetSubMeshes()) {
+        assert(subMesh.materialIndex < materialData_.size());
+
+        // マテリアルCBufferの場所を設定
+        dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0,
+            materialResource_->GetGPUVirtualAddress() + static_cast<UINT64>(kMaterialStride) * subMesh.materialIndex);
+
+        // テクスチャをセット（必ずテクスチャがセットされることを保証）
+        std::string texturePath = ResolveTexturePath(model_->GetMaterial(subMesh.materialIndex).textureFilePath);
+        dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2,
+            TextureManager::GetInstance()->GetSrvHandleGPU(texturePath));
+
+        // 描画
+        dxCommon_->GetCommandList()->DrawIndexedInstanced(subMesh.indexCount, 1, subMesh.indexStart, 0, 0);
+    }
+}
+
+std::string Object3d::ResolveTexturePath(const std::string& materialTexturePath) {
+    std::string texturePath = materialTexturePath;
     OutputDebugStringA(("Object3d::Draw - Using texture path: " + texturePath + "\n").c_str());
 
     // テクスチャが空または存在しない場合の詳細なチェック
@@ -196,13 +372,5 @@ void Object3d::Draw() {
         OutputDebugStringA(("Object3d::Draw - Using valid texture: " + texturePath + "\n").c_str());
     }
 
-    // テクスチャをセット（必ずテクスチャがセットされることを保証）
-    dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2,
-        TextureManager::GetInstance()->GetSrvHandleGPU(texturePath));
-
-    // ライトCBufferの場所を設定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(3, directionalLightResource_->GetGPUVirtualAddress());
-
-    // 描画
-    dxCommon_->GetCommandList()->DrawInstanced(model_->GetVertexCount(), 1, 0, 0);
-}
\ No newline at end of file
+    return texturePath;
+}
@@ -4,10 +4,13 @@
 #include "Vector3.h"
 #include "math.h"
 #include "Camera.h"
+#include "TransformComponent.h"
 
 #include <d3d12.h>
 #include <wrl.h>
 #include <memory>
+#include <span>
+#include <vector>
 
 class DirectXCommon;
 class SpriteCommon;
@@ -25,6 +28,8 @@ public:
     void Initialize(DirectXCommon* dxCommon, SpriteCommon* spriteCommon);
     // モデルのセット
     void SetModel(Model* model);
+    // モデルの取得（未設定ならnullptr）
+    Model* GetModel() const { return model_; }
     // 更新処理（従来のメソッド - 後方互換性のため残す）
     void Update(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix);
     // 描画処理
@@ -37,31 +42,66 @@ public:
     // カメラを使用するUpdateメソッド
     void Update();
 
+    // 複数のオブジェクトをまとめて更新（全オブジェクトで同じカメラを使う、nullptrならデフォルトカメラ）
+    // 行列は各オブジェクトの定数バッファに直接書き込む
+    static void UpdateBatch(std::span<Object3d* const> objects, const Camera* camera = nullptr);
+
+    // ワールド空間での境界球（モデルのローカル境界球をワールド行列で変換したもの）
+    Sphere GetWorldBoundingSphere();
+
+    // ワールド空間でのAABB（モデルのローカルAABBをワールド行列で変換したもの、BVHの登録用）
+    AABB GetWorldAABB();
+
+    // ワールド空間のレイで最も近い交点を求める（モデルが未設定なら当たらない）
+    // レイをローカル空間に変換して判定するので、hit.distanceはワールド空間での距離になる
+    bool Raycast(const Ray& ray, float maxDistance, MeshRayHit& hit);
+
+    // ワールド空間のレイがmaxDistance以内でモデルに当たるか
+    bool RaycastAny(const Ray& ray, float maxDistance);
+
+    // 視錐台と重なるか（モデルが未設定なら常にtrue）
+    bool IsVisible(const Frustum& frustum);
+
+    // 視錐台と重なるオブジェクトだけをvisibleObjectsに集める（境界球を4個ずつSIMDで判定する）
+    // 全オブジェクトを調べるので、数が多い場面ではObject3dBvhで絞り込む
+    static void CullObjects(std::span<Object3d* const> objects, const Frustum& frustum, std::vector<Object3d*>& visibleObjects);
+
     // 座標の設定
-    void SetPosition(const Vector3& position) { transform_.translate = position; }
-    const Vector3& GetPosition() const { return transform_.translate; }
+    void SetPosition(const Vector3& position) { transform_.SetTranslate(position); }
+    const Vector3& GetPosition() const { return transform_.GetTranslate(); }
 
     // 回転の設定
-    void SetRotation(const Vector3& rotation) { transform_.rotate = rotation; }
-    const Vector3& GetRotation() const { return transform_.rotate; }
+    void SetRotation(const Vector3& rotation) { transform_.SetRotate(rotation); }
+    const Vector3& GetRotation() const { return transform_.GetRotate(); }
 
     // スケールの設定
-    void SetScale(const Vector3& scale) { transform_.scale = scale; }
-    const Vector3& GetScale() const { return transform_.scale; }
+    void SetScale(const Vector3& scale) { transform_.SetScale(scale); }
+    const Vector3& GetScale() const { return transform_.GetScale(); }
 
-    // カラーの設定
-    void SetColor(const Vector4& color) { materialData_->color = color; }
-    const Vector4& GetColor() const { return materialData_->color; }
+    // カラーの設定（モデルのすべてのマテリアルに設定する、取得は最初のマテリアルの値）
+    void SetColor(const Vector4& color);
+    const Vector4& GetColor() const { return materialData_[0]->color; }
 
-    // ライトを有効にするか
-    void SetEnableLighting(bool enable) { materialData_->enableLighting = enable ? 1 : 0; }
-    bool GetEnableLighting() const { return materialData_->enableLighting != 0; }
+    // ライトを有効にするか（モデルのすべてのマテリアルに設定する）
+    void SetEnableLighting(bool enable);
+    bool GetEnableLighting() const { return materialData_[0]->enableLighting != 0; }
 
     // ライトの設定
     void SetDirectionalLight(const DirectionalLight& light) { *directionalLightData_ = light; }
     const DirectionalLight& GetDirectionalLight() const { return *directionalLightData_; }
 
 private:
+    // 前回書き込んだ行列から、トランスフォームかカメラが変わっているか
+    bool NeedsMatrixUpdate(const Camera* camera) const;
+    // 行列を書き込んだときのトランスフォームとカメラの状態を記録
+    void MarkMatrixWritten(const Camera* camera);
+
+    // マテリアルごとの定数バッファを作り直す（ライトの設定は引き継ぐ）
+    void CreateMaterialResource(uint32_t materialCount);
+
+    // 描画に使うテクスチャのパス（空や読み込めない場合はデフォルトテクスチャ）
+    std::string ResolveTexturePath(const std::string& materialTexturePath);
+
     // モデル
     Model* model_;
 
@@ -70,10 +110,10 @@ private:
     // SpriteCommon
     SpriteCommon* spriteCommon_;
 
-    // マテリアルリソース
+    // マテリアルリソース（モデルのマテリアルごとの定数バッファを1つのリソースに並べる）
     Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
-    // マテリアルデータ
-    Material* materialData_;
+    // マテリアルデータ（各要素は定数バッファの配置の境界に置く）
+    std::vector<Material*> materialData_;
 
     // 変換行列リソース
     Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource_;
@@ -86,7 +126,13 @@ private:
     DirectionalLight* directionalLightData_;
 
     // トランスフォーム
-    Transform transform_;
+    TransformComponent transform_;
+
+    // 定数バッファに書き込んだ行列の元になった状態（変化がなければ書き込みを省く）
+    bool isMatrixWritten_ = false;
+    uint32_t writtenTransformVersion_ = 0;
+    const Camera* writtenCamera_ = nullptr;
+    uint32_t writtenViewProjectionVersion_ = 0;
 
     // カメラへの参照
     Camera* camera_ = nullptr;
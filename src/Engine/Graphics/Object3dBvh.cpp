@@ -0,0 +1,91 @@
+#include "Object3dBvh.h"
+#include "Object3d.h"
+
+namespace
+{
+    bool IsSameAABB(const AABB& a, const AABB& b) {
+        return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+            a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+    }
+}
+
+void Object3dBvh::Build(std::span<Object3d* const> objects) {
+    Clear();
+    for (Object3d* object : objects) {
+        if (!object->GetModel()) {
+            unboundedObjects_.push_back(object);
+            continue;
+        }
+        objects_.push_back(object);
+        bounds_.push_back(object->GetWorldAABB());
+    }
+    bvh_.Build(bounds_);
+    builtCost_ = bvh_.ComputeCost();
+}
+
+void Object3dBvh::Clear() {
+    objects_.clear();
+    unboundedObjects_.clear();
+    bounds_.clear();
+    bvh_.Clear();
+    builtCost_ = 0.0f;
+}
+
+void Object3dBvh::Refit() {
+    bool isMoved = false;
+    for (uint32_t i = 0; i < objects_.size(); ++i) {
+        AABB bounds = objects_[i]->GetWorldAABB();
+        if (IsSameAABB(bounds, bounds_[i])) {
+            continue;
+        }
+        bounds_[i] = bounds;
+        bvh_.UpdateItem(i, bounds);
+        isMoved = true;
+    }
+    if (!isMoved) {
+        return;
+    }
+    bvh_.Refit();
+
+    // 境界を広げ続けると検索で調べるノードが増えていくので、悪化したら同じオブジェクトで作り直す
+    if (bvh_.ComputeCost() > builtCost_ * kRebuildCostRatio) {
+        bvh_.Build(bounds_);
+        builtCost_ = bvh_.ComputeCost();
+    }
+}
+
+void Object3dBvh::Cull(const Frustum& frustum, std::vector<Object3d*>& visibleObjects) {
+    visibleObjects.clear();
+    visibleObjects.insert(visibleObjects.end(), unboundedObjects_.begin(), unboundedObjects_.end());
+
+    queryItems_.clear();
+    bvh_.QueryFrustum(frustum, queryItems_);
+    for (uint32_t item : queryItems_) {
+        visibleObjects.push_back(objects_[item]);
+    }
+}
+
+bool Object3dBvh::Raycast(const Ray& ray, float maxDistance, Object3d*& hitObject, MeshRayHit& hit) const {
+    // BVHはmaxDistanceをこれまでで最も近い距離に縮めながら呼ぶので、当たったときの結果がそのまま最も近いものになる
+    BvhRayHit bvhHit;
+    bool isHit = bvh_.Raycast(ray, maxDistance, bvhHit, [&](uint32_t item, const Ray& itemRay, float itemMaxDistance, float& outDistance) {
+        MeshRayHit meshHit;
+        if (!objects_[item]->Raycast(itemRay, itemMaxDistance, meshHit)) {
+            return false;
+        }
+        outDistance = meshHit.distance;
+        hit = meshHit;
+        return true;
+    });
+    if (isHit) {
+        hitObject = objects_[bvhHit.item];
+    }
+    return isHit;
+}
+
+bool Object3dBvh::RaycastAny(const Ray& ray, float maxDistance) const {
+    return bvh_.RaycastAny(ray, maxDistance, [&](uint32_t item, const Ray& itemRay, float itemMaxDistance, float& outDistance) {
+        outDistance = 0.0f;
+        return objects_[item]->RaycastAny(itemRay, itemMaxDistance);
+    });
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "BoundingVolumeHierarchy.h"
+#include "Frustum.h"
+#include "TriangleMesh.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Object3d;
+
+// Object3dの視錐台カリングとレイキャストをBVHで絞り込むクラス
+// 登録したオブジェクトのワールドAABBでBVHを作り、毎フレームRefitで動いたオブジェクトの境界だけを更新する
+// オブジェクトが数百個以上ある場面向け（少なければObject3d::CullObjectsの総当たりで十分速い）
+class Object3dBvh {
+public:
+    // オブジェクトを登録してBVHを作る（モデルのないオブジェクトは境界がないので、常に可視として別に持つ）
+    void Build(std::span<Object3d* const> objects);
+
+    // 全削除
+    void Clear();
+
+    // 動いたオブジェクトの境界を更新する（トランスフォームを変えた後、Cull・Raycastの前に呼ぶ）
+    // 木の品質が構築直後より大きく悪化していたら作り直す
+    void Refit();
+
+    // 視錐台と重なるオブジェクトだけをvisibleObjectsに集める
+    void Cull(const Frustum& frustum, std::vector<Object3d*>& visibleObjects);
+
+    // ワールド空間のレイで最も近い交点を求める（AABBで絞り込んだオブジェクトのメッシュだけを判定する）
+    bool Raycast(const Ray& ray, float maxDistance, Object3d*& hitObject, MeshRayHit& hit) const;
+
+    // ワールド空間のレイがmaxDistance以内でいずれかのオブジェクトに当たるか
+    bool RaycastAny(const Ray& ray, float maxDistance) const;
+
+    // 登録したオブジェクトの数
+    uint32_t GetObjectCount() const { return static_cast<uint32_t>(objects_.size() + unboundedObjects_.size()); }
+
+private:
+    // 構築直後のSAHコストの何倍になったら作り直すか
+    static constexpr float kRebuildCostRatio = 2.0f;
+
+    // BVHに入れたオブジェクト（BVHのアイテム番号の順）
+    std::vector<Object3d*> objects_;
+    // モデルのないオブジェクト
+    std::vector<Object3d*> unboundedObjects_;
+    // BVHに登録した境界（変わったオブジェクトだけUpdateItemするために持っておく）
+    std::vector<AABB> bounds_;
+    // BVH
+    BoundingVolumeHierarchy bvh_;
+    // 構築直後のSAHコスト
+    float builtCost_ = 0.0f;
+    // 検索結果の作業用配列（毎フレームの確保を避ける）
+    std::vector<uint32_t> queryItems_;
+};
@@ -35,6 +35,93 @@ Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearCilp
 }
 
 
+Matrix4x4 MakePerspectiveFovMatrixReverseZ(float fovY, float aspectRatio, float nearClip, float farClip)
+{
+	Matrix4x4 ans;
+
+	ans.m[0][0] = Cot(fovY / 2) / aspectRatio;
+	ans.m[0][1] = 0;
+	ans.m[0][2] = 0;
+	ans.m[0][3] = 0;
+
+	ans.m[1][0] = 0;
+	ans.m[1][1] = Cot(fovY / 2);
+	ans.m[1][2] = 0;
+	ans.m[1][3] = 0;
+
+	// 通常の透視投影の深度dを1-dに置き換えたもの
+	ans.m[2][0] = 0;
+	ans.m[2][1] = 0;
+	ans.m[2][2] = nearClip / (nearClip - farClip);
+	ans.m[2][3] = 1;
+
+	ans.m[3][0] = 0;
+	ans.m[3][1] = 0;
+	ans.m[3][2] = (nearClip * farClip) / (farClip - nearClip);
+	ans.m[3][3] = 0;
+
+	return ans;
+}
+
+
+Matrix4x4 MakePerspectiveFovMatrixInfinite(float fovY, float aspectRatio, float nearClip)
+{
+	Matrix4x4 ans;
+
+	ans.m[0][0] = Cot(fovY / 2) / aspectRatio;
+	ans.m[0][1] = 0;
+	ans.m[0][2] = 0;
+	ans.m[0][3] = 0;
+
+	ans.m[1][0] = 0;
+	ans.m[1][1] = Cot(fovY / 2);
+	ans.m[1][2] = 0;
+	ans.m[1][3] = 0;
+
+	// 通常の式でfarClipを無限大にした極限（深度は1-nearClip/z）
+	ans.m[2][0] = 0;
+	ans.m[2][1] = 0;
+	ans.m[2][2] = 1;
+	ans.m[2][3] = 1;
+
+	ans.m[3][0] = 0;
+	ans.m[3][1] = 0;
+	ans.m[3][2] = -nearClip;
+	ans.m[3][3] = 0;
+
+	return ans;
+}
+
+
+Matrix4x4 MakePerspectiveFovMatrixInfiniteReverseZ(float fovY, float aspectRatio, float nearClip)
+{
+	Matrix4x4 ans;
+
+	ans.m[0][0] = Cot(fovY / 2) / aspectRatio;
+	ans.m[0][1] = 0;
+	ans.m[0][2] = 0;
+	ans.m[0][3] = 0;
+
+	ans.m[1][0] = 0;
+	ans.m[1][1] = Cot(fovY / 2);
+	ans.m[1][2] = 0;
+	ans.m[1][3] = 0;
+
+	// reverse-Zの式でfarClipを無限大にした極限
+	ans.m[2][0] = 0;
+	ans.m[2][1] = 0;
+	ans.m[2][2] = 0;
+	ans.m[2][3] = 1;
+
+	ans.m[3][0] = 0;
+	ans.m[3][1] = 0;
+	ans.m[3][2] = nearClip;
+	ans.m[3][3] = 0;
+
+	return ans;
+}
+
+
 Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottm, float nearCip, float farCip)
 {
 	Matrix4x4 ans;
@@ -63,6 +150,18 @@ Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottm
 }
 
 
+Matrix4x4 MakeOrthographicMatrixReverseZ(float left, float top, float right, float bottom, float nearClip, float farClip)
+{
+	Matrix4x4 ans = MakeOrthographicMatrix(left, top, right, bottom, nearClip, farClip);
+
+	// 深度dを1-dに置き換える
+	ans.m[2][2] = 1 / (nearClip - farClip);
+	ans.m[3][2] = farClip / (farClip - nearClip);
+
+	return ans;
+}
+
+
 Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth)
 {
 	Matrix4x4 ans;
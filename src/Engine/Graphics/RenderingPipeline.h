@@ -8,8 +8,21 @@ float Cot(float theta);
 //透視投影行列
 Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearCilp, float farClip);
 
+//透視投影行列（reverse-Z、ニアクリップで深度1・ファークリップで深度0）
+//浮動小数点の深度バッファと組み合わせると、遠くまで深度の精度が均等に近くなる
+Matrix4x4 MakePerspectiveFovMatrixReverseZ(float fovY, float aspectRatio, float nearClip, float farClip);
+
+//透視投影行列（ファークリップなし、無限遠で深度1）
+Matrix4x4 MakePerspectiveFovMatrixInfinite(float fovY, float aspectRatio, float nearClip);
+
+//透視投影行列（reverse-Z・ファークリップなし、深度はnearClip/zになり無限遠で0）
+Matrix4x4 MakePerspectiveFovMatrixInfiniteReverseZ(float fovY, float aspectRatio, float nearClip);
+
 //正射影行列
 Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottm, float nearCip, float farCip);
 
+//正射影行列（reverse-Z、ニアクリップで深度1・ファークリップで深度0）
+Matrix4x4 MakeOrthographicMatrixReverseZ(float left, float top, float right, float bottom, float nearClip, float farClip);
+
 //ビューポート変換行列
 Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
\ No newline at end of file
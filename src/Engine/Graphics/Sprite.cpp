@@ -3,6 +3,7 @@
 #include "MyMath.h"
 #include "RenderingPipeline.h"
 #include "TextureManager.h"
+#include "TransformBatch.h"
 
 void Sprite::Initialize(SpriteCommon* spriteCommon, std::string textureFilePath)
 {
@@ -54,6 +55,46 @@ void Sprite::Initialize(SpriteCommon* spriteCommon, std::string textureFilePath)
 
 
 void Sprite::Update()
+{
+	UpdateVertices();
+
+	Matrix4x4 worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+	transformationMatrixData->WVP = Multiply(worldMatrix, MakeProjectionMatrix());
+	transformationMatrixData->World = worldMatrix;
+}
+
+void Sprite::UpdateBatch(std::span<Sprite* const> sprites)
+{
+	if (sprites.empty()) {
+		return;
+	}
+
+	// 毎フレームの確保を避けるため作業用配列は使い回す（メインスレッドからのみ呼ぶこと）
+	static TransformSoA transforms;
+	static std::vector<TransformationMatrix*> destinations;
+	transforms.Clear();
+	destinations.clear();
+
+	for (Sprite* sprite : sprites) {
+		assert(sprite->transformationMatrixData);
+		sprite->UpdateVertices();
+		transforms.Add({ sprite->transform.scale, sprite->transform.rotate, sprite->transform.translate });
+		destinations.push_back(sprite->transformationMatrixData);
+	}
+
+	// 行列の計算（Map済みの定数バッファへ直接書き込む）
+	ComputeWorldWVP(transforms, sprites.front()->MakeProjectionMatrix(), std::span<TransformationMatrix* const>(destinations));
+}
+
+Matrix4x4 Sprite::MakeProjectionMatrix() const
+{
+	//reverse-Zのときは深度の向きを合わせる（z=0のスプライトが最も手前になるように）
+	return spriteCommon_->GetDxCommon()->IsReverseZ() ?
+		MakeOrthographicMatrixReverseZ(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f) :
+		MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f);
+}
+
+void Sprite::UpdateVertices()
 {
 	transform.rotate = { 0.0f,0.0f,rotation };
 	transform.translate = { position.x,position.y,0.0f };
@@ -103,13 +144,6 @@ void Sprite::Update()
 	indexResource->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
 	indexData[0] = 0; indexData[1] = 1; indexData[2] = 2;
 	indexData[3] = 1; indexData[4] = 3; indexData[5] = 2;
-
-	Matrix4x4 worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
-	Matrix4x4 viewMatrix = MakeIdentity4x4();
-	Matrix4x4 projectionMatrix = MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f);
-	Matrix4x4 worldViewProjectionMatrix = Multiply(worldMatrix, Multiply(viewMatrix, projectionMatrix));
-	transformationMatrixData->WVP = worldViewProjectionMatrix;
-	transformationMatrixData->World = worldMatrix;
 }
 
 
@@ -4,9 +4,11 @@
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "Mymath.h"
 #include <assert.h>
 #include <cmath>
 #include <stdio.h>
+#include <span>
 #include <string>
 #include <wrl/client.h>
 #include <d3d12.h>
@@ -29,12 +31,6 @@ class Sprite
 		Matrix4x4 uvTransform;
 	};
 
-	struct TransformationMatrix
-	{
-		Matrix4x4 WVP;
-		Matrix4x4 World;
-	};
-
 	struct Transform {
 		Vector3 scale;
 		Vector3 rotate;
@@ -50,6 +46,10 @@ public:
 	// 更新
 	void Update();
 
+	// 複数のスプライトをまとめて更新（全スプライトで同じSpriteCommonを使う）
+	// 行列はTransformBatchでまとめて計算し、各スプライトの定数バッファに直接書き込む
+	static void UpdateBatch(std::span<Sprite* const> sprites);
+
 	// 描画
 	void Draw();
 
@@ -94,6 +94,12 @@ private:
 	//テクスチャサイズをイメージに合わせる
 	void AdjustTextureSize();
 
+	// SRTと頂点の更新（行列以外）
+	void UpdateVertices();
+
+	// スプライト用の正射影行列（ビュー行列は単位行列なのでこれがそのままviewProjectionになる）
+	Matrix4x4 MakeProjectionMatrix() const;
+
 	SpriteCommon* spriteCommon_ = nullptr;
 
 	// バッファリソース
@@ -110,6 +116,7 @@ private:
 	VertexData* vertexData = nullptr;
 	uint32_t* indexData = nullptr;
 	Material* materialData = nullptr;
+	// TransformBatchの出力先にできるよう、Mymath.hのTransformationMatrixを使う
 	TransformationMatrix* transformationMatrixData = nullptr;
 
 	// vertexResourceSprite頂点バッファーを作成する
@@ -118,8 +118,8 @@ void SpriteCommon::GraphicsPipelineInitialize()
 	depthStencilDesc.DepthEnable = true;
 	//深度値を書き込む
 	depthStencilDesc.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
-	//比較関数はLessEqual（手前にあるものを優先的に描画）
-	depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+	//比較関数はLessEqual（手前にあるものを優先的に描画、reverse-ZならGreaterEqual）
+	depthStencilDesc.DepthFunc = dxCommon_->GetDepthComparisonFunc();
 	//PSOを生成する
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsPipelineStateDesc{};
 	graphicsPipelineStateDesc.pRootSignature = rootSignature.Get();//RootSignature
@@ -141,7 +141,7 @@ void SpriteCommon::GraphicsPipelineInitialize()
 	graphicsPipelineStateDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 	//DepthStencilの設定
 	graphicsPipelineStateDesc.DepthStencilState = depthStencilDesc;
-	graphicsPipelineStateDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+	graphicsPipelineStateDesc.DSVFormat = dxCommon_->GetDepthFormat();
 	//実際に生成
 	HRESULT hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc,
 		IID_PPV_ARGS(&graphicsPipelineState));
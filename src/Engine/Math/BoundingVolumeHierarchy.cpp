@@ -0,0 +1,480 @@
+#include "BoundingVolumeHierarchy.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+
+namespace {
+	// 無効なノード番号
+	const uint32_t kInvalidNode = UINT32_MAX;
+	// SAHで分割位置を探すときのビンの数
+	const uint32_t kBinCount = 16;
+
+	// AABBの中心（空なら原点）
+	Vector3 GetCentroid(const AABB& aabb) {
+		if (IsEmptyAABB(aabb)) {
+			return { 0.0f, 0.0f, 0.0f };
+		}
+		return GetAABBCenter(aabb);
+	}
+
+	float GetAxis(const Vector3& v, uint32_t axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	// aにbを含める（構築中の内側のループで使うので、MergeAABBを呼ばずにここで展開する）
+	inline void GrowAABB(AABB& a, const AABB& b) {
+		a.min.x = (std::min)(a.min.x, b.min.x);
+		a.min.y = (std::min)(a.min.y, b.min.y);
+		a.min.z = (std::min)(a.min.z, b.min.z);
+		a.max.x = (std::max)(a.max.x, b.max.x);
+		a.max.y = (std::max)(a.max.y, b.max.y);
+		a.max.z = (std::max)(a.max.z, b.max.z);
+	}
+
+	bool IsSameAABB(const AABB& a, const AABB& b) {
+		return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+			a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+	}
+
+	// 平面の表側にAABBがどれだけ入っているか（0:完全に裏、1:平面をまたぐ、2:完全に表）
+	int ClassifyAABB(const Plane& plane, const AABB& aabb) {
+		// 法線方向に最も進んだ頂点と最も戻った頂点
+		Vector3 positive = {
+			plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+			plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+			plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z,
+		};
+		Vector3 negative = {
+			plane.normal.x >= 0.0f ? aabb.min.x : aabb.max.x,
+			plane.normal.y >= 0.0f ? aabb.min.y : aabb.max.y,
+			plane.normal.z >= 0.0f ? aabb.min.z : aabb.max.z,
+		};
+		if (plane.normal.x * positive.x + plane.normal.y * positive.y + plane.normal.z * positive.z + plane.distance < 0.0f) {
+			return 0;
+		}
+		if (plane.normal.x * negative.x + plane.normal.y * negative.y + plane.normal.z * negative.z + plane.distance >= 0.0f) {
+			return 2;
+		}
+		return 1;
+	}
+}
+
+#pragma region 構築
+void BoundingVolumeHierarchy::Build(std::span<const AABB> itemBounds) {
+	Clear();
+	if (itemBounds.empty()) {
+		return;
+	}
+
+	uint32_t itemCount = static_cast<uint32_t>(itemBounds.size());
+	itemBounds_.assign(itemBounds.begin(), itemBounds.end());
+	itemIndices_.resize(itemCount);
+	itemLeaves_.resize(itemCount);
+	std::vector<Vector3> centroids(itemCount);
+	for (uint32_t i = 0; i < itemCount; ++i) {
+		itemIndices_[i] = i;
+		centroids[i] = GetCentroid(itemBounds[i]);
+	}
+
+	// ノード数は最大でアイテム数*2-1
+	nodes_.reserve(itemCount * 2);
+	parents_.reserve(itemCount * 2);
+	BuildNode(0, itemCount, kInvalidNode, 0, centroids);
+
+	isLeafDirty_.assign(nodes_.size(), 0);
+}
+
+void BoundingVolumeHierarchy::Clear() {
+	nodes_.clear();
+	parents_.clear();
+	itemIndices_.clear();
+	itemBounds_.clear();
+	itemLeaves_.clear();
+	dirtyLeaves_.clear();
+	isLeafDirty_.clear();
+}
+
+uint32_t BoundingVolumeHierarchy::BuildNode(uint32_t begin, uint32_t end, uint32_t parent, uint32_t depth, std::vector<Vector3>& centroids) {
+	uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+	nodes_.push_back({});
+	parents_.push_back(parent);
+
+	// 境界と中心点の範囲
+	AABB bounds = MakeEmptyAABB();
+	AABB centroidBounds = MakeEmptyAABB();
+	for (uint32_t i = begin; i < end; ++i) {
+		uint32_t item = itemIndices_[i];
+		GrowAABB(bounds, itemBounds_[item]);
+		ExpandAABB(centroidBounds, centroids[item]);
+	}
+	nodes_[nodeIndex].bounds = bounds;
+
+	uint32_t count = end - begin;
+	auto makeLeaf = [&]() {
+		nodes_[nodeIndex].offset = begin;
+		nodes_[nodeIndex].count = count;
+		for (uint32_t i = begin; i < end; ++i) {
+			itemLeaves_[itemIndices_[i]] = nodeIndex;
+		}
+		return nodeIndex;
+	};
+	if (count <= 1) {
+		return makeLeaf();
+	}
+
+	// 最も長い軸
+	Vector3 centroidExtent = {
+		centroidBounds.max.x - centroidBounds.min.x,
+		centroidBounds.max.y - centroidBounds.min.y,
+		centroidBounds.max.z - centroidBounds.min.z,
+	};
+	uint32_t longestAxis = 0;
+	if (centroidExtent.y > GetAxis(centroidExtent, longestAxis)) {
+		longestAxis = 1;
+	}
+	if (centroidExtent.z > GetAxis(centroidExtent, longestAxis)) {
+		longestAxis = 2;
+	}
+
+	// 中心点がすべて同じ位置なら分割できない
+	if (GetAxis(centroidExtent, longestAxis) <= 0.0f) {
+		if (count <= kMaxLeafItems) {
+			return makeLeaf();
+		}
+		// 上限を超える分は並び順のまま半分に分ける
+		uint32_t middle = begin + count / 2;
+		BuildNode(begin, middle, nodeIndex, depth + 1, centroids);
+		nodes_[nodeIndex].offset = BuildNode(middle, end, nodeIndex, depth + 1, centroids);
+		nodes_[nodeIndex].count = 0;
+		return nodeIndex;
+	}
+
+	uint32_t splitAxis = longestAxis;
+	uint32_t middle = begin;
+
+	if (depth < kMaxSahDepth) {
+		// 各軸の中心点の範囲をビンに分け、ビンの境目で分けたときのSAHコストが最小になる位置を探す
+		// コスト = 左の表面積 * 左の数 + 右の表面積 * 右の数（親の表面積と判定コストの定数は比較に影響しないので省く）
+		// アイテムがビンより少ないノードでは、ビンの走査がアイテムの走査より重くなるので数をアイテム数までに減らす
+		uint32_t binCount = (std::min)(kBinCount, count);
+		float bestCost = FLT_MAX;
+		uint32_t bestAxis = 0;
+		uint32_t bestBin = 0;
+		for (uint32_t axis = 0; axis < 3; ++axis) {
+			float axisMin = GetAxis(centroidBounds.min, axis);
+			float axisExtent = GetAxis(centroidExtent, axis);
+			if (axisExtent <= 0.0f) {
+				continue;
+			}
+			float binScale = binCount / axisExtent;
+
+			AABB binBounds[kBinCount];
+			uint32_t binCounts[kBinCount] = {};
+			for (uint32_t b = 0; b < binCount; ++b) {
+				binBounds[b] = MakeEmptyAABB();
+			}
+			for (uint32_t i = begin; i < end; ++i) {
+				uint32_t item = itemIndices_[i];
+				uint32_t bin = (std::min)(static_cast<uint32_t>((GetAxis(centroids[item], axis) - axisMin) * binScale), binCount - 1);
+				GrowAABB(binBounds[bin], itemBounds_[item]);
+				++binCounts[bin];
+			}
+
+			// 右から累積した表面積と数
+			float rightAreas[kBinCount];
+			uint32_t rightCounts[kBinCount];
+			AABB accumulated = MakeEmptyAABB();
+			uint32_t accumulatedCount = 0;
+			for (uint32_t b = binCount - 1; b > 0; --b) {
+				GrowAABB(accumulated, binBounds[b]);
+				accumulatedCount += binCounts[b];
+				rightAreas[b] = GetAABBSurfaceArea(accumulated);
+				rightCounts[b] = accumulatedCount;
+			}
+
+			// 左から累積しながら、ビンb-1とbの境目で分けたコストを求める
+			accumulated = MakeEmptyAABB();
+			accumulatedCount = 0;
+			for (uint32_t b = 1; b < binCount; ++b) {
+				GrowAABB(accumulated, binBounds[b - 1]);
+				accumulatedCount += binCounts[b - 1];
+				if (accumulatedCount == 0 || rightCounts[b] == 0) {
+					continue;
+				}
+				float cost = GetAABBSurfaceArea(accumulated) * accumulatedCount + rightAreas[b] * rightCounts[b];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = b;
+				}
+			}
+		}
+
+		// 分けない場合のコスト（全員を判定する）が、子をたどる分を足したコスト以下で、葉に収まるなら葉にする
+		float area = GetAABBSurfaceArea(bounds);
+		if (count <= kMaxLeafItems && area * count <= area + bestCost) {
+			return makeLeaf();
+		}
+
+		if (bestCost < FLT_MAX) {
+			splitAxis = bestAxis;
+			float axisMin = GetAxis(centroidBounds.min, splitAxis);
+			float binScale = binCount / GetAxis(centroidExtent, splitAxis);
+			auto it = std::partition(itemIndices_.begin() + begin, itemIndices_.begin() + end, [&](uint32_t item) {
+				uint32_t bin = (std::min)(static_cast<uint32_t>((GetAxis(centroids[item], splitAxis) - axisMin) * binScale), binCount - 1);
+				return bin < bestBin;
+			});
+			middle = static_cast<uint32_t>(it - itemIndices_.begin());
+		}
+	} else if (count <= kMaxLeafItems) {
+		return makeLeaf();
+	}
+
+	// SAHで分けられなかった（深すぎる・偏りすぎる）ときは、最も長い軸の中央値で分ける
+	if (middle <= begin || middle >= end) {
+		splitAxis = longestAxis;
+		middle = begin + count / 2;
+		std::nth_element(itemIndices_.begin() + begin, itemIndices_.begin() + middle, itemIndices_.begin() + end,
+			[&](uint32_t a, uint32_t b) { return GetAxis(centroids[a], splitAxis) < GetAxis(centroids[b], splitAxis); });
+	}
+
+	// 左の子は直後に置かれる
+	BuildNode(begin, middle, nodeIndex, depth + 1, centroids);
+	nodes_[nodeIndex].offset = BuildNode(middle, end, nodeIndex, depth + 1, centroids);
+	nodes_[nodeIndex].count = 0;
+	return nodeIndex;
+}
+#pragma endregion
+
+#pragma region 更新
+void BoundingVolumeHierarchy::UpdateItem(uint32_t item, const AABB& bounds) {
+	assert(item < itemBounds_.size());
+	itemBounds_[item] = bounds;
+
+	uint32_t leaf = itemLeaves_[item];
+	if (!isLeafDirty_[leaf]) {
+		isLeafDirty_[leaf] = 1;
+		dirtyLeaves_.push_back(leaf);
+	}
+}
+
+void BoundingVolumeHierarchy::Refit() {
+	for (uint32_t leaf : dirtyLeaves_) {
+		isLeafDirty_[leaf] = 0;
+
+		AABB bounds = ComputeLeafBounds(nodes_[leaf]);
+		if (IsSameAABB(bounds, nodes_[leaf].bounds)) {
+			continue;
+		}
+		nodes_[leaf].bounds = bounds;
+
+		// 親をたどって子2つから境界を作り直す（変わらなくなったらそれより上も変わらない）
+		for (uint32_t node = parents_[leaf]; node != kInvalidNode; node = parents_[node]) {
+			AABB merged = MergeAABB(nodes_[node + 1].bounds, nodes_[nodes_[node].offset].bounds);
+			if (IsSameAABB(merged, nodes_[node].bounds)) {
+				break;
+			}
+			nodes_[node].bounds = merged;
+		}
+	}
+	dirtyLeaves_.clear();
+}
+
+void BoundingVolumeHierarchy::Refit(std::span<const AABB> itemBounds) {
+	assert(itemBounds.size() == itemBounds_.size());
+	itemBounds_.assign(itemBounds.begin(), itemBounds.end());
+
+	for (uint32_t leaf : dirtyLeaves_) {
+		isLeafDirty_[leaf] = 0;
+	}
+	dirtyLeaves_.clear();
+
+	// 子は必ず親より後ろにあるので、後ろから順に計算すれば子の境界は確定している
+	for (size_t i = nodes_.size(); i-- > 0;) {
+		Node& node = nodes_[i];
+		if (node.IsLeaf()) {
+			node.bounds = ComputeLeafBounds(node);
+		} else {
+			node.bounds = MergeAABB(nodes_[i + 1].bounds, nodes_[node.offset].bounds);
+		}
+	}
+}
+
+AABB BoundingVolumeHierarchy::ComputeLeafBounds(const Node& leaf) const {
+	AABB bounds = MakeEmptyAABB();
+	for (uint32_t i = 0; i < leaf.count; ++i) {
+		bounds = MergeAABB(bounds, itemBounds_[itemIndices_[leaf.offset + i]]);
+	}
+	return bounds;
+}
+
+float BoundingVolumeHierarchy::ComputeCost() const {
+	if (nodes_.empty()) {
+		return 0.0f;
+	}
+	float rootArea = GetAABBSurfaceArea(nodes_[0].bounds);
+	if (rootArea <= 0.0f) {
+		return static_cast<float>(itemBounds_.size());
+	}
+
+	// 節は子2つの判定、葉はアイテム数分の判定が、表面積の比の確率で起きるとして合計する
+	float cost = 0.0f;
+	for (const Node& node : nodes_) {
+		float probability = GetAABBSurfaceArea(node.bounds) / rootArea;
+		cost += probability * (node.IsLeaf() ? static_cast<float>(node.count) : 2.0f);
+	}
+	return cost;
+}
+#pragma endregion
+
+#pragma region 検索
+void BoundingVolumeHierarchy::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& outItems) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	// ノードと、まだ調べる必要のある平面のビットマスクを積む
+	// 親が完全に表側にある平面は、子も表側にあるので調べなくてよい
+	const uint32_t kAllPlanes = (1u << Frustum::kPlaneCount) - 1;
+	uint32_t stack[kStackSize];
+	uint32_t stackMask[kStackSize];
+	uint32_t stackCount = 0;
+	stack[stackCount] = 0;
+	stackMask[stackCount++] = kAllPlanes;
+
+	while (stackCount > 0) {
+		--stackCount;
+		uint32_t nodeIndex = stack[stackCount];
+		uint32_t mask = stackMask[stackCount];
+		const Node& node = nodes_[nodeIndex];
+
+		bool isOutside = false;
+		for (uint32_t p = 0; p < Frustum::kPlaneCount; ++p) {
+			if (!(mask & (1u << p))) {
+				continue;
+			}
+			int result = ClassifyAABB(frustum.planes[p], node.bounds);
+			if (result == 0) {
+				isOutside = true;
+				break;
+			}
+			if (result == 2) {
+				mask &= ~(1u << p);
+			}
+		}
+		if (isOutside) {
+			continue;
+		}
+
+		// 完全に内側なら部分木をまるごと追加
+		if (mask == 0) {
+			CollectItems(nodeIndex, outItems);
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			// 葉の中はアイテムごとに判定する
+			for (uint32_t i = 0; i < node.count; ++i) {
+				uint32_t item = itemIndices_[node.offset + i];
+				bool isItemOutside = false;
+				for (uint32_t p = 0; p < Frustum::kPlaneCount; ++p) {
+					if ((mask & (1u << p)) && ClassifyAABB(frustum.planes[p], itemBounds_[item]) == 0) {
+						isItemOutside = true;
+						break;
+					}
+				}
+				if (!isItemOutside) {
+					outItems.push_back(item);
+				}
+			}
+			continue;
+		}
+
+		stack[stackCount] = node.offset;
+		stackMask[stackCount++] = mask;
+		stack[stackCount] = nodeIndex + 1;
+		stackMask[stackCount++] = mask;
+	}
+}
+
+void BoundingVolumeHierarchy::QuerySphere(const Sphere& sphere, std::vector<uint32_t>& outItems) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	uint32_t stack[kStackSize];
+	uint32_t stackCount = 0;
+	stack[stackCount++] = 0;
+
+	while (stackCount > 0) {
+		uint32_t nodeIndex = stack[--stackCount];
+		const Node& node = nodes_[nodeIndex];
+		if (!IsSphereAABBOverlap(sphere, node.bounds)) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			for (uint32_t i = 0; i < node.count; ++i) {
+				uint32_t item = itemIndices_[node.offset + i];
+				if (IsSphereAABBOverlap(sphere, itemBounds_[item])) {
+					outItems.push_back(item);
+				}
+			}
+			continue;
+		}
+		stack[stackCount++] = node.offset;
+		stack[stackCount++] = nodeIndex + 1;
+	}
+}
+
+void BoundingVolumeHierarchy::QueryAABB(const AABB& aabb, std::vector<uint32_t>& outItems) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	uint32_t stack[kStackSize];
+	uint32_t stackCount = 0;
+	stack[stackCount++] = 0;
+
+	while (stackCount > 0) {
+		uint32_t nodeIndex = stack[--stackCount];
+		const Node& node = nodes_[nodeIndex];
+		if (!IsAABBOverlap(aabb, node.bounds)) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			for (uint32_t i = 0; i < node.count; ++i) {
+				uint32_t item = itemIndices_[node.offset + i];
+				if (IsAABBOverlap(aabb, itemBounds_[item])) {
+					outItems.push_back(item);
+				}
+			}
+			continue;
+		}
+		stack[stackCount++] = node.offset;
+		stack[stackCount++] = nodeIndex + 1;
+	}
+}
+
+bool BoundingVolumeHierarchy::Raycast(const Ray& ray, float maxDistance, BvhRayHit& hit) const {
+	Vector3 inverseDirection = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+	return Raycast(ray, maxDistance, hit, [&](uint32_t item, const Ray& itemRay, float itemMaxDistance, float& outDistance) {
+		return IntersectRayAABB(itemRay, inverseDirection, itemBounds_[item], itemMaxDistance, outDistance);
+	});
+}
+
+void BoundingVolumeHierarchy::CollectItems(uint32_t nodeIndex, std::vector<uint32_t>& outItems) const {
+	// 部分木のノードは深さ優先で連続しているので、葉のアイテムも連続した範囲になる
+	// 最初の葉（左端）と最後の葉（右端）を探せば、その間のアイテムがすべて含まれる
+	uint32_t first = nodeIndex;
+	while (!nodes_[first].IsLeaf()) {
+		first = first + 1;
+	}
+	uint32_t last = nodeIndex;
+	while (!nodes_[last].IsLeaf()) {
+		last = nodes_[last].offset;
+	}
+	uint32_t begin = nodes_[first].offset;
+	uint32_t end = nodes_[last].offset + nodes_[last].count;
+	outItems.insert(outItems.end(), itemIndices_.begin() + begin, itemIndices_.begin() + end);
+}
+#pragma endregion
@@ -0,0 +1,224 @@
+#pragma once
+#include "Bounds.h"
+#include "Frustum.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// レイキャストの結果
+struct BvhRayHit {
+	// 当たったアイテムの番号（Buildに渡した配列の添字）
+	uint32_t item;
+	// 始点からの距離
+	float distance;
+};
+
+// AABBの配列に対する境界ボリューム階層（BVH）
+// SAH（表面積ヒューリスティック）で構築し、アイテムが動いたら木の形は変えずに境界だけを更新（Refit）する
+// ノードは深さ優先の順に1つの配列に並べる（左の子は親の直後、右の子の位置だけを持つ）
+class BoundingVolumeHierarchy {
+public:
+	// ノード（32バイト）
+	struct Node {
+		// 子孫のアイテム全体を含むAABB
+		AABB bounds;
+		// 葉なら先頭アイテムの位置（itemIndices_の添字）、節なら右の子のノード番号
+		uint32_t offset;
+		// 葉ならアイテム数、節なら0
+		uint32_t count;
+
+		bool IsLeaf() const { return count > 0; }
+	};
+
+	// 葉に入れるアイテム数の上限
+	static const uint32_t kMaxLeafItems = 4;
+
+	// 構築（itemBounds[i]がアイテムiの境界になる）
+	void Build(std::span<const AABB> itemBounds);
+
+	// 全削除
+	void Clear();
+
+	// アイテムの境界を差し替える（木への反映はRefitを呼んだとき）
+	void UpdateItem(uint32_t item, const AABB& bounds);
+
+	// UpdateItemしたアイテムを含む葉から根までの境界を更新する（動いたアイテムの数と木の深さに比例する）
+	void Refit();
+
+	// 全アイテムの境界を差し替えて、全ノードの境界を更新する（ほとんどのアイテムが動いたとき用）
+	void Refit(std::span<const AABB> itemBounds);
+
+	// 木の品質（SAHコスト、根の表面積を1としたときの期待判定回数）
+	// Refitを繰り返すと悪化していくので、構築直後の値から大きく離れたらBuildし直す目安にする
+	float ComputeCost() const;
+
+	// 視錐台と重なるアイテムをoutItemsに追加する（完全に内側に入った部分木は判定を省く）
+	void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& outItems) const;
+
+	// 境界球と重なるアイテムをoutItemsに追加する
+	void QuerySphere(const Sphere& sphere, std::vector<uint32_t>& outItems) const;
+
+	// AABBと重なるアイテムをoutItemsに追加する
+	void QueryAABB(const AABB& aabb, std::vector<uint32_t>& outItems) const;
+
+	// 半直線が最初に当たるアイテムのAABBを求める（maxDistanceより遠いものは無視する）
+	bool Raycast(const Ray& ray, float maxDistance, BvhRayHit& hit) const;
+
+	// AABBで絞り込んだアイテムをitemTestで詳しく判定し、最も近いものを求める
+	// itemTestは bool(uint32_t item, const Ray& ray, float maxDistance, float& outDistance) の形で、
+	// maxDistance以内で当たったときだけtrueを返す
+	template<typename ItemTest>
+	bool Raycast(const Ray& ray, float maxDistance, BvhRayHit& hit, ItemTest&& itemTest) const;
+
+	// maxDistance以内でitemTestが当たるアイテムが1つでもあるか（最初に見つかった時点で打ち切る、遮蔽判定用）
+	template<typename ItemTest>
+	bool RaycastAny(const Ray& ray, float maxDistance, ItemTest&& itemTest) const;
+
+	// アイテム数の取得
+	uint32_t GetItemCount() const { return static_cast<uint32_t>(itemBounds_.size()); }
+
+	// ノード配列の取得
+	std::span<const Node> GetNodes() const { return nodes_; }
+
+	// 葉の順に並べたアイテム番号の取得（葉のoffsetとcountはこの配列の範囲を指す）
+	std::span<const uint32_t> GetLeafItems() const { return itemIndices_; }
+
+	// アイテムの境界の取得
+	const AABB& GetItemBounds(uint32_t item) const { return itemBounds_[item]; }
+
+private:
+	// 探索用スタックの大きさ（構築時にこの深さを超えないようにする）
+	static const uint32_t kStackSize = 64;
+	// この深さを超えたらSAHをやめて中央で分割する
+	static const uint32_t kMaxSahDepth = 24;
+
+	// [begin, end)のアイテムからノードを作り、そのノード番号を返す
+	uint32_t BuildNode(uint32_t begin, uint32_t end, uint32_t parent, uint32_t depth, std::vector<Vector3>& centroids);
+
+	// 葉の境界をアイテムから計算し直す
+	AABB ComputeLeafBounds(const Node& leaf) const;
+
+	// 部分木の全アイテムをoutItemsに追加する
+	void CollectItems(uint32_t nodeIndex, std::vector<uint32_t>& outItems) const;
+
+	// ノード配列
+	std::vector<Node> nodes_;
+	// 各ノードの親（根は無効値）
+	std::vector<uint32_t> parents_;
+	// 葉の順に並べたアイテム番号
+	std::vector<uint32_t> itemIndices_;
+	// アイテムごとの境界
+	std::vector<AABB> itemBounds_;
+	// アイテムごとの所属する葉
+	std::vector<uint32_t> itemLeaves_;
+	// UpdateItem後に境界の更新が必要な葉
+	std::vector<uint32_t> dirtyLeaves_;
+	std::vector<uint8_t> isLeafDirty_;
+};
+
+template<typename ItemTest>
+bool BoundingVolumeHierarchy::Raycast(const Ray& ray, float maxDistance, BvhRayHit& hit, ItemTest&& itemTest) const {
+	if (nodes_.empty()) {
+		return false;
+	}
+
+	Vector3 inverseDirection = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+	float closest = maxDistance;
+	bool isHit = false;
+
+	float distance;
+	if (!IntersectRayAABB(ray, inverseDirection, nodes_[0].bounds, closest, distance)) {
+		return false;
+	}
+
+	// スタックにはノード番号と、そのノードに入る距離を積む
+	uint32_t stack[kStackSize];
+	float stackDistance[kStackSize];
+	uint32_t stackCount = 0;
+	stack[stackCount] = 0;
+	stackDistance[stackCount] = distance;
+	++stackCount;
+
+	while (stackCount > 0) {
+		--stackCount;
+		// 積んだ後により近い当たりが見つかっていれば調べなくてよい
+		if (stackDistance[stackCount] > closest) {
+			continue;
+		}
+		const Node& node = nodes_[stack[stackCount]];
+
+		if (node.IsLeaf()) {
+			for (uint32_t i = 0; i < node.count; ++i) {
+				uint32_t item = itemIndices_[node.offset + i];
+				float itemDistance;
+				if (itemTest(item, ray, closest, itemDistance) && itemDistance <= closest) {
+					closest = itemDistance;
+					hit.item = item;
+					hit.distance = itemDistance;
+					isHit = true;
+				}
+			}
+			continue;
+		}
+
+		// 近い子を先に調べるため、遠い子から積む
+		uint32_t left = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+		uint32_t right = node.offset;
+		float leftDistance, rightDistance;
+		bool isLeftHit = IntersectRayAABB(ray, inverseDirection, nodes_[left].bounds, closest, leftDistance);
+		bool isRightHit = IntersectRayAABB(ray, inverseDirection, nodes_[right].bounds, closest, rightDistance);
+		if (isLeftHit && isRightHit) {
+			if (leftDistance > rightDistance) {
+				stack[stackCount] = left;
+				stackDistance[stackCount++] = leftDistance;
+				stack[stackCount] = right;
+				stackDistance[stackCount++] = rightDistance;
+			} else {
+				stack[stackCount] = right;
+				stackDistance[stackCount++] = rightDistance;
+				stack[stackCount] = left;
+				stackDistance[stackCount++] = leftDistance;
+			}
+		} else if (isLeftHit) {
+			stack[stackCount] = left;
+			stackDistance[stackCount++] = leftDistance;
+		} else if (isRightHit) {
+			stack[stackCount] = right;
+			stackDistance[stackCount++] = rightDistance;
+		}
+	}
+	return isHit;
+}
+
+template<typename ItemTest>
+bool BoundingVolumeHierarchy::RaycastAny(const Ray& ray, float maxDistance, ItemTest&& itemTest) const {
+	if (nodes_.empty()) {
+		return false;
+	}
+
+	Vector3 inverseDirection = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+	uint32_t stack[kStackSize];
+	uint32_t stackCount = 0;
+	stack[stackCount++] = 0;
+
+	while (stackCount > 0) {
+		uint32_t nodeIndex = stack[--stackCount];
+		const Node& node = nodes_[nodeIndex];
+		float distance;
+		if (!IntersectRayAABB(ray, inverseDirection, node.bounds, maxDistance, distance)) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			for (uint32_t i = 0; i < node.count; ++i) {
+				float itemDistance;
+				if (itemTest(itemIndices_[node.offset + i], ray, maxDistance, itemDistance)) {
+					return true;
+				}
+			}
+			continue;
+		}
+		stack[stackCount++] = node.offset;
+		stack[stackCount++] = nodeIndex + 1;
+	}
+	return false;
+}
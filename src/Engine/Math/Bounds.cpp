@@ -0,0 +1,168 @@
+#include "Bounds.h"
+#include "Mymath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#pragma region AABB
+AABB MakeEmptyAABB() {
+	return { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+}
+
+bool IsEmptyAABB(const AABB& aabb) {
+	return aabb.min.x > aabb.max.x || aabb.min.y > aabb.max.y || aabb.min.z > aabb.max.z;
+}
+
+void ExpandAABB(AABB& aabb, const Vector3& point) {
+	aabb.min.x = (std::min)(aabb.min.x, point.x);
+	aabb.min.y = (std::min)(aabb.min.y, point.y);
+	aabb.min.z = (std::min)(aabb.min.z, point.z);
+	aabb.max.x = (std::max)(aabb.max.x, point.x);
+	aabb.max.y = (std::max)(aabb.max.y, point.y);
+	aabb.max.z = (std::max)(aabb.max.z, point.z);
+}
+
+AABB MergeAABB(const AABB& a, const AABB& b) {
+	AABB result = a;
+	ExpandAABB(result, b.min);
+	ExpandAABB(result, b.max);
+	return result;
+}
+
+Vector3 GetAABBCenter(const AABB& aabb) {
+	return { (aabb.min.x + aabb.max.x) * 0.5f, (aabb.min.y + aabb.max.y) * 0.5f, (aabb.min.z + aabb.max.z) * 0.5f };
+}
+
+Vector3 GetAABBExtent(const AABB& aabb) {
+	return { (aabb.max.x - aabb.min.x) * 0.5f, (aabb.max.y - aabb.min.y) * 0.5f, (aabb.max.z - aabb.min.z) * 0.5f };
+}
+
+float GetAABBSurfaceArea(const AABB& aabb) {
+	if (IsEmptyAABB(aabb)) {
+		return 0.0f;
+	}
+	float dx = aabb.max.x - aabb.min.x;
+	float dy = aabb.max.y - aabb.min.y;
+	float dz = aabb.max.z - aabb.min.z;
+	return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+bool IsAABBOverlap(const AABB& a, const AABB& b) {
+	return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+		a.min.y <= b.max.y && b.min.y <= a.max.y &&
+		a.min.z <= b.max.z && b.min.z <= a.max.z;
+}
+
+bool IsSphereAABBOverlap(const Sphere& sphere, const AABB& aabb) {
+	// ボックス上の最近点までの距離を半径と比べる
+	float dx = sphere.center.x - (std::clamp)(sphere.center.x, aabb.min.x, aabb.max.x);
+	float dy = sphere.center.y - (std::clamp)(sphere.center.y, aabb.min.y, aabb.max.y);
+	float dz = sphere.center.z - (std::clamp)(sphere.center.z, aabb.min.z, aabb.max.z);
+	return dx * dx + dy * dy + dz * dz <= sphere.radius * sphere.radius;
+}
+
+bool IntersectRayAABB(const Ray& ray, const Vector3& inverseDirection, const AABB& aabb, float maxDistance, float& outDistance) {
+	// 各軸のスラブに入る距離と出る距離を求め、全軸で重なる区間があれば交差
+	float t1 = (aabb.min.x - ray.origin.x) * inverseDirection.x;
+	float t2 = (aabb.max.x - ray.origin.x) * inverseDirection.x;
+	float tMin = (std::min)(t1, t2);
+	float tMax = (std::max)(t1, t2);
+
+	t1 = (aabb.min.y - ray.origin.y) * inverseDirection.y;
+	t2 = (aabb.max.y - ray.origin.y) * inverseDirection.y;
+	tMin = (std::max)(tMin, (std::min)(t1, t2));
+	tMax = (std::min)(tMax, (std::max)(t1, t2));
+
+	t1 = (aabb.min.z - ray.origin.z) * inverseDirection.z;
+	t2 = (aabb.max.z - ray.origin.z) * inverseDirection.z;
+	tMin = (std::max)(tMin, (std::min)(t1, t2));
+	tMax = (std::min)(tMax, (std::max)(t1, t2));
+
+	tMin = (std::max)(tMin, 0.0f);
+	if (tMin > tMax || tMin > maxDistance) {
+		return false;
+	}
+	outDistance = tMin;
+	return true;
+}
+
+AABB MakeAABB(std::span<const Vector3> points) {
+	AABB result = MakeEmptyAABB();
+	for (const Vector3& point : points) {
+		ExpandAABB(result, point);
+	}
+	return result;
+}
+
+AABB MakeAABB(const Sphere& sphere) {
+	return {
+		{ sphere.center.x - sphere.radius, sphere.center.y - sphere.radius, sphere.center.z - sphere.radius },
+		{ sphere.center.x + sphere.radius, sphere.center.y + sphere.radius, sphere.center.z + sphere.radius },
+	};
+}
+
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix) {
+	// 各軸の成分ごとに、最小・最大のどちらの端が小さくなるかを選ぶ（8頂点を変換しなくてよい）
+	AABB result;
+	float* resultMin = &result.min.x;
+	float* resultMax = &result.max.x;
+	const float* aabbMin = &aabb.min.x;
+	const float* aabbMax = &aabb.max.x;
+	for (int j = 0; j < 3; j++) {
+		resultMin[j] = matrix.m[3][j];
+		resultMax[j] = matrix.m[3][j];
+		for (int i = 0; i < 3; i++) {
+			float a = matrix.m[i][j] * aabbMin[i];
+			float b = matrix.m[i][j] * aabbMax[i];
+			resultMin[j] += (std::min)(a, b);
+			resultMax[j] += (std::max)(a, b);
+		}
+	}
+	return result;
+}
+#pragma endregion
+
+#pragma region 境界球
+Sphere MakeBoundingSphere(std::span<const Vector3> points) {
+	if (points.empty()) {
+		return { { 0.0f, 0.0f, 0.0f }, 0.0f };
+	}
+
+	Sphere result;
+	result.center = GetAABBCenter(MakeAABB(points));
+	float radiusSq = 0.0f;
+	for (const Vector3& point : points) {
+		float dx = point.x - result.center.x;
+		float dy = point.y - result.center.y;
+		float dz = point.z - result.center.z;
+		radiusSq = (std::max)(radiusSq, dx * dx + dy * dy + dz * dz);
+	}
+	result.radius = std::sqrt(radiusSq);
+	return result;
+}
+
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix) {
+	// 中心は点として変換する
+	Sphere result;
+	result.center = TransformPoint(sphere.center, matrix);
+
+	// 半径は各軸の拡大率のうち最大のものを掛ける（不均一スケールでも球が収まる）
+	float scaleSq = 0.0f;
+	for (int i = 0; i < 3; i++) {
+		float lengthSq = matrix.m[i][0] * matrix.m[i][0] + matrix.m[i][1] * matrix.m[i][1] + matrix.m[i][2] * matrix.m[i][2];
+		scaleSq = (std::max)(scaleSq, lengthSq);
+	}
+	result.radius = sphere.radius * std::sqrt(scaleSq);
+	return result;
+}
+#pragma endregion
+
+#pragma region Ray
+Ray TransformRay(const Ray& ray, const Matrix4x4& matrix) {
+	// 始点は点として、方向は平行移動を含めずに変換する
+	Ray result;
+	result.origin = TransformPoint(ray.origin, matrix);
+	result.direction = TransformVector(ray.direction, matrix);
+	return result;
+}
+#pragma endregion
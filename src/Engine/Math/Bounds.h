@@ -0,0 +1,69 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <span>
+
+// 境界球（16バイトなのでSIMDでそのまま4個ずつ読める）
+struct Sphere {
+	Vector3 center;
+	float radius;
+};
+
+// 軸平行境界ボックス
+struct AABB {
+	Vector3 min;
+	Vector3 max;
+};
+
+// 半直線（directionが正規化されていれば、交差判定で求まる距離がそのまま長さになる）
+struct Ray {
+	Vector3 origin;
+	Vector3 direction;
+};
+
+// 空のAABB（どの点を加えてもその点だけを含むようになる）
+AABB MakeEmptyAABB();
+
+// 空のAABBか
+bool IsEmptyAABB(const AABB& aabb);
+
+// 点を含むように広げる
+void ExpandAABB(AABB& aabb, const Vector3& point);
+
+// 2つのAABBを含むAABB
+AABB MergeAABB(const AABB& a, const AABB& b);
+
+// 中心と半分の大きさ
+Vector3 GetAABBCenter(const AABB& aabb);
+Vector3 GetAABBExtent(const AABB& aabb);
+
+// 表面積（SAHのコスト計算用、空なら0）
+float GetAABBSurfaceArea(const AABB& aabb);
+
+// 2つのAABBが重なるか
+bool IsAABBOverlap(const AABB& a, const AABB& b);
+
+// 境界球とAABBが重なるか
+bool IsSphereAABBOverlap(const Sphere& sphere, const AABB& aabb);
+
+// 半直線とAABBの交差（スラブ法）。交差すればtrueで、入る距離をoutDistanceに入れる（始点が内側なら0）
+// inverseDirectionは1/directionを成分ごとに求めたもの（多数のボックスと判定するときに使い回す）
+bool IntersectRayAABB(const Ray& ray, const Vector3& inverseDirection, const AABB& aabb, float maxDistance, float& outDistance);
+
+// 点群のAABB
+AABB MakeAABB(std::span<const Vector3> points);
+
+// 点群を含む境界球（AABBの中心から最も遠い点までを半径にする）
+Sphere MakeBoundingSphere(std::span<const Vector3> points);
+
+// 境界球を含むAABB
+AABB MakeAABB(const Sphere& sphere);
+
+// アフィン行列で変換した境界球（拡大縮小は最も大きい軸に合わせる）
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix);
+
+// アフィン行列で変換したAABBを含むAABB
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix);
+
+// アフィン行列で変換した半直線（方向は正規化し直さないので、交差距離は変換前と同じ値のまま使える）
+Ray TransformRay(const Ray& ray, const Matrix4x4& matrix);
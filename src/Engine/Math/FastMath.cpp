@@ -0,0 +1,160 @@
+#include "FastMath.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+	// 2/π
+	const float kTwoOverPi = 0.636619772f;
+	// π/2を3分割した定数（上位の項ほど仮数部の下位ビットが0なので、折り返し回数との積が丸められない）
+	const float kHalfPi0 = 1.5703125f;
+	const float kHalfPi1 = 4.837512969970703125e-4f;
+	const float kHalfPi2 = 7.54978995489188216e-8f;
+
+	// sin(r) ≒ r + r^3 * (s1 + r^2 * (s2 + r^2 * s3))（|r| <= π/4）
+	const float kSin1 = -1.6666654611e-1f;
+	const float kSin2 = 8.3321608736e-3f;
+	const float kSin3 = -1.9515295891e-4f;
+
+	// cos(r) ≒ 1 - r^2 / 2 + r^4 * (c1 + r^2 * (c2 + r^2 * c3))（|r| <= π/4）
+	const float kCos1 = 4.166664568298827e-2f;
+	const float kCos2 = -1.388731625493765e-3f;
+	const float kCos3 = 2.443315711809948e-5f;
+}
+
+#pragma region 逆平方根
+float FastMath::Rsqrt(float x) {
+#if defined(MATRIX_SIMD_SSE)
+	return _mm_cvtss_f32(Rsqrt(_mm_set_ss(x)));
+#else
+	return 1.0f / std::sqrt(x);
+#endif
+}
+#pragma endregion
+
+#pragma region sinとcos
+void FastMath::SinCos(float x, float& outSin, float& outCos) {
+#if defined(MATRIX_SIMD_SSE)
+	// 象限による分岐を避けるため、SIMD版の1要素目だけを使う
+	__m128 s, c;
+	SinCos(_mm_set_ss(x), s, c);
+	outSin = _mm_cvtss_f32(s);
+	outCos = _mm_cvtss_f32(c);
+#else
+	// 最も近い整数に丸めた折り返し回数（0から遠い側に丸める）
+	float scaled = x * kTwoOverPi;
+	int32_t quadrant = static_cast<int32_t>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+	float q = static_cast<float>(quadrant);
+	float r = x - q * kHalfPi0;
+	r -= q * kHalfPi1;
+	r -= q * kHalfPi2;
+	float r2 = r * r;
+
+	float s = r + r2 * r * (kSin1 + r2 * (kSin2 + r2 * kSin3));
+	float c = 1.0f - r2 * 0.5f + r2 * r2 * (kCos1 + r2 * (kCos2 + r2 * kCos3));
+
+	// 折り返し回数が奇数ならsinとcosを入れ替え、象限に応じて符号を反転する
+	if (quadrant & 1) {
+		float temp = s;
+		s = c;
+		c = temp;
+	}
+	outSin = (quadrant & 2) ? -s : s;
+	outCos = ((quadrant + 1) & 2) ? -c : c;
+#endif
+}
+
+#if defined(MATRIX_SIMD_SSE)
+void FastMath::SinCos(__m128 x, __m128& outSin, __m128& outCos) {
+	// 折り返し回数（最も近い整数に丸める）とπ/2を3分割した定数による剰余
+	__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(kTwoOverPi)));
+	__m128 q = _mm_cvtepi32_ps(quadrant);
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(kHalfPi0)));
+	r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(kHalfPi1)));
+	r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(kHalfPi2)));
+	__m128 r2 = _mm_mul_ps(r, r);
+
+	__m128 s = MatrixSimd::MulAdd(r2, _mm_set1_ps(kSin3), _mm_set1_ps(kSin2));
+	s = MatrixSimd::MulAdd(r2, s, _mm_set1_ps(kSin1));
+	s = MatrixSimd::MulAdd(_mm_mul_ps(r2, r), s, r);
+
+	__m128 c = MatrixSimd::MulAdd(r2, _mm_set1_ps(kCos3), _mm_set1_ps(kCos2));
+	c = MatrixSimd::MulAdd(r2, c, _mm_set1_ps(kCos1));
+	c = MatrixSimd::MulAdd(_mm_mul_ps(r2, r2), c, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))));
+
+	// 折り返し回数が奇数ならsinとcosを入れ替え、象限に応じて符号を反転する
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sinValue = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+	__m128 cosValue = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+	__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	outSin = _mm_xor_ps(sinValue, sinSign);
+	outCos = _mm_xor_ps(cosValue, cosSign);
+}
+#endif
+
+void FastMath::SinCos(std::span<const float> x, std::span<float> outSin, std::span<float> outCos) {
+	assert(outSin.size() >= x.size() && outCos.size() >= x.size());
+	size_t count = x.size();
+	size_t i = 0;
+#if defined(MATRIX_SIMD_SSE)
+	for (; i + 4 <= count; i += 4) {
+		__m128 s, c;
+		SinCos(_mm_loadu_ps(&x[i]), s, c);
+		_mm_storeu_ps(&outSin[i], s);
+		_mm_storeu_ps(&outCos[i], c);
+	}
+#endif
+	for (; i < count; ++i) {
+		SinCos(x[i], outSin[i], outCos[i]);
+	}
+}
+#pragma endregion
+
+#pragma region 正規化
+void FastMath::Normalize(std::span<Vector3> vectors) {
+	size_t count = vectors.size();
+	size_t i = 0;
+#if defined(MATRIX_SIMD_SSE)
+	// 4個（12要素）を3レジスタに読み込む：a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+	float* data = reinterpret_cast<float*>(vectors.data());
+	const __m128 minLengthSq = _mm_set1_ps(kNormalizeMinLengthSq);
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4) {
+		float* p = data + i * 3;
+		__m128 a = _mm_loadu_ps(p);
+		__m128 b = _mm_loadu_ps(p + 4);
+		__m128 c = _mm_loadu_ps(p + 8);
+		__m128 aa = _mm_mul_ps(a, a);
+		__m128 bb = _mm_mul_ps(b, b);
+		__m128 cc = _mm_mul_ps(c, c);
+
+		// 成分ごとの2乗をベクトルごとに並べ替えて足す
+		__m128 xx = _mm_shuffle_ps(aa, _mm_shuffle_ps(bb, cc, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		__m128 yy = _mm_shuffle_ps(_mm_shuffle_ps(aa, bb, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(bb, cc, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 zz = _mm_shuffle_ps(_mm_shuffle_ps(aa, bb, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(cc, cc, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 lengthSq = _mm_add_ps(_mm_add_ps(xx, yy), zz);
+
+		// 短すぎるベクトルは倍率1にして変更しない
+		__m128 isLongEnough = _mm_cmpgt_ps(lengthSq, minLengthSq);
+		__m128 scale = _mm_or_ps(_mm_and_ps(isLongEnough, Rsqrt(lengthSq)), _mm_andnot_ps(isLongEnough, one));
+
+		// 倍率を元の並びに展開して掛ける：(s0 s0 s0 s1), (s1 s1 s2 s2), (s2 s3 s3 s3)
+		_mm_storeu_ps(p, _mm_mul_ps(a, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 0, 0, 0))));
+		_mm_storeu_ps(p + 4, _mm_mul_ps(b, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 1, 1))));
+		_mm_storeu_ps(p + 8, _mm_mul_ps(c, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(3, 3, 3, 2))));
+	}
+#endif
+	for (; i < count; ++i) {
+		Vector3& v = vectors[i];
+		float lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+		if (lengthSq > kNormalizeMinLengthSq) {
+			float scale = Rsqrt(lengthSq);
+			v.x *= scale;
+			v.y *= scale;
+			v.z *= scale;
+		}
+	}
+}
+#pragma endregion
@@ -0,0 +1,42 @@
+#pragma once
+#include "MatrixSimd.h"
+#include "Vector3.h"
+#include <span>
+
+// 近似計算による高速な数学関数
+// 標準ライブラリより精度を少し落として速くしたもの。誤差の上限は関数ごとに記す（倍精度で求めた値との比較で確認したもの）
+// ロード時のメッシュ処理や毎フレームのトランスフォーム計算など、大量の要素をまとめて処理する場面で使う
+namespace FastMath
+{
+	// Normalizeで正規化しない長さの2乗の上限（長さ0.0001以下のベクトルはそのまま残す）
+	const float kNormalizeMinLengthSq = 1.0e-8f;
+
+	// 1 / sqrt(x)（x > 0、近似値にニュートン法を1回適用する）
+	// 相対誤差は最大3e-7（1/std::sqrtは9e-8）。x <= 0 のときの結果は不定
+	float Rsqrt(float x);
+
+	// sinとcosを同時に求める（π/2単位で[-π/4, π/4]に折り返してから多項式近似する）
+	// |x| <= 8192 で絶対誤差は最大1e-7（std::sin, std::cosは4e-8）。それより大きいと折り返しの誤差が増える
+	void SinCos(float x, float& outSin, float& outCos);
+
+	// まとめてsinとcosを求める（outSin, outCosはxと同じ数以上の領域が必要、誤差はSinCosと同じ）
+	void SinCos(std::span<const float> x, std::span<float> outSin, std::span<float> outCos);
+
+	// ベクトルの配列をまとめて正規化する（4個ずつSIMDで処理し、長さの逆数はRsqrtで求める）
+	// 正規化後の長さと1との差は最大3e-7。長さの2乗がkNormalizeMinLengthSq以下のベクトルは変更しない
+	void Normalize(std::span<Vector3> vectors);
+
+#if defined(MATRIX_SIMD_SSE)
+	// 4要素分の1 / sqrt(x)
+	// rsqrtps（相対誤差1.5 * 2^-12以下）の結果y0にニュートン法 y1 = y0 * (1.5 - 0.5 * x * y0^2) を1回適用する
+	inline __m128 Rsqrt(__m128 x) {
+		__m128 y = _mm_rsqrt_ps(x);
+		__m128 halfX = _mm_mul_ps(x, _mm_set1_ps(0.5f));
+		__m128 yy = _mm_mul_ps(y, y);
+		return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfX, yy)));
+	}
+
+	// 4要素分のsinとcos
+	void SinCos(__m128 x, __m128& outSin, __m128& outCos);
+#endif
+};
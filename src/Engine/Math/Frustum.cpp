@@ -0,0 +1,121 @@
+#include "Frustum.h"
+#include "MatrixSimd.h"
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+	// 平面を作って正規化する（法線が0になる平面は常に表側として扱う）
+	Plane MakePlane(float a, float b, float c, float d) {
+		float length = std::sqrt(a * a + b * b + c * c);
+		if (length < 1e-6f) {
+			// 無限遠の遠平面など、どの点も外側にならない平面
+			return { { 0.0f, 0.0f, 0.0f }, FLT_MAX };
+		}
+		float recpLength = 1.0f / length;
+		return { { a * recpLength, b * recpLength, c * recpLength }, d * recpLength };
+	}
+
+	// 平面との符号付き距離
+	float DistanceToPlane(const Plane& plane, const Vector3& point) {
+		return plane.normal.x * point.x + plane.normal.y * point.y + plane.normal.z * point.z + plane.distance;
+	}
+}
+
+Frustum MakeFrustum(const Matrix4x4& viewProjection) {
+	// クリップ座標 clip = (p, 1) * VP の各成分はVPの列との内積になる
+	// -w <= x <= w、-w <= y <= w、0 <= z <= w の各条件が1枚の平面になる
+	const auto& m = viewProjection.m;
+	Frustum frustum;
+	frustum.planes[Frustum::kLeft] = MakePlane(m[0][3] + m[0][0], m[1][3] + m[1][0], m[2][3] + m[2][0], m[3][3] + m[3][0]);
+	frustum.planes[Frustum::kRight] = MakePlane(m[0][3] - m[0][0], m[1][3] - m[1][0], m[2][3] - m[2][0], m[3][3] - m[3][0]);
+	frustum.planes[Frustum::kBottom] = MakePlane(m[0][3] + m[0][1], m[1][3] + m[1][1], m[2][3] + m[2][1], m[3][3] + m[3][1]);
+	frustum.planes[Frustum::kTop] = MakePlane(m[0][3] - m[0][1], m[1][3] - m[1][1], m[2][3] - m[2][1], m[3][3] - m[3][1]);
+	frustum.planes[Frustum::kNear] = MakePlane(m[0][2], m[1][2], m[2][2], m[3][2]);
+	frustum.planes[Frustum::kFar] = MakePlane(m[0][3] - m[0][2], m[1][3] - m[1][2], m[2][3] - m[2][2], m[3][3] - m[3][2]);
+	return frustum;
+}
+
+bool IsSphereInFrustum(const Frustum& frustum, const Sphere& sphere) {
+	for (const Plane& plane : frustum.planes) {
+		if (DistanceToPlane(plane, sphere.center) < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IsAABBInFrustum(const Frustum& frustum, const AABB& aabb) {
+	for (const Plane& plane : frustum.planes) {
+		// 法線方向に最も進んだ頂点が裏側なら、ボックス全体が裏側
+		Vector3 positive = {
+			plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+			plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+			plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z,
+		};
+		if (DistanceToPlane(plane, positive) < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t CullSpheres(const Frustum& frustum, std::span<const Sphere> spheres, std::span<uint32_t> visibleIndices) {
+	assert(visibleIndices.size() >= spheres.size());
+	uint32_t sphereCount = static_cast<uint32_t>(spheres.size());
+	uint32_t visibleCount = 0;
+	uint32_t i = 0;
+
+#if defined(MATRIX_SIMD_SSE)
+	// 平面の係数を全レーンに展開しておく
+	__m128 planeX[Frustum::kPlaneCount];
+	__m128 planeY[Frustum::kPlaneCount];
+	__m128 planeZ[Frustum::kPlaneCount];
+	__m128 planeW[Frustum::kPlaneCount];
+	for (int p = 0; p < Frustum::kPlaneCount; p++) {
+		planeX[p] = _mm_set1_ps(frustum.planes[p].normal.x);
+		planeY[p] = _mm_set1_ps(frustum.planes[p].normal.y);
+		planeZ[p] = _mm_set1_ps(frustum.planes[p].normal.z);
+		planeW[p] = _mm_set1_ps(frustum.planes[p].distance);
+	}
+
+	for (; i + 4 <= sphereCount; i += 4) {
+		// 4個分を読み込んで中心x・y・zと半径ごとに並べ替える
+		__m128 centerX = _mm_loadu_ps(&spheres[i].center.x);
+		__m128 centerY = _mm_loadu_ps(&spheres[i + 1].center.x);
+		__m128 centerZ = _mm_loadu_ps(&spheres[i + 2].center.x);
+		__m128 radius = _mm_loadu_ps(&spheres[i + 3].center.x);
+		_MM_TRANSPOSE4_PS(centerX, centerY, centerZ, radius);
+		__m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+		// どれか1枚の平面で完全に裏側にあれば見えない
+		__m128 outside = _mm_setzero_ps();
+		for (int p = 0; p < Frustum::kPlaneCount; p++) {
+			__m128 distance = MatrixSimd::MulAdd(planeX[p], centerX, planeW[p]);
+			distance = MatrixSimd::MulAdd(planeY[p], centerY, distance);
+			distance = MatrixSimd::MulAdd(planeZ[p], centerZ, distance);
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+		}
+
+		// 見えるレーンのインデックスを詰めて書き込む
+		int visibleMask = ~_mm_movemask_ps(outside) & 0xF;
+		while (visibleMask) {
+			int lane = 0;
+			while (!(visibleMask & (1 << lane))) {
+				lane++;
+			}
+			visibleIndices[visibleCount++] = i + lane;
+			visibleMask &= visibleMask - 1;
+		}
+	}
+#endif
+
+	// 端数（SIMDがない場合は全部）を1個ずつ判定する
+	for (; i < sphereCount; i++) {
+		if (IsSphereInFrustum(frustum, spheres[i])) {
+			visibleIndices[visibleCount++] = i;
+		}
+	}
+	return visibleCount;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Bounds.h"
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <span>
+
+// 平面（dot(normal, p) + distance >= 0 の側を表とする）
+struct Plane {
+	Vector3 normal;
+	float distance;
+};
+
+// 視錐台（6枚の平面の内側が可視範囲）
+struct Frustum {
+	enum PlaneIndex {
+		kLeft,
+		kRight,
+		kBottom,
+		kTop,
+		kNear,
+		kFar,
+		kPlaneCount,
+	};
+	Plane planes[kPlaneCount];
+};
+
+// ビュープロジェクション行列から視錐台を作る（行ベクトル形式、クリップ空間の深度は0～1）
+// 平面の法線は正規化済みなので、平面との距離がそのままワールド空間の距離になる
+// reverse-Zの行列ではkNearとkFarが入れ替わる（無限遠の行列では遠い側の平面が常に表になる）。どちらも判定結果は変わらない
+Frustum MakeFrustum(const Matrix4x4& viewProjection);
+
+// 境界球が視錐台と重なるか（完全に外側の平面が1枚でもあれば見えない）
+bool IsSphereInFrustum(const Frustum& frustum, const Sphere& sphere);
+
+// AABBが視錐台と重なるか（各平面の法線方向に最も進んだ頂点だけを調べる）
+bool IsAABBInFrustum(const Frustum& frustum, const AABB& aabb);
+
+// 境界球をまとめて判定し、見えるもののインデックスをvisibleIndicesの先頭から詰めて書き込む（見える数を返す）
+// 4個ずつSIMDで判定する。visibleIndicesはspheresと同じ数以上の領域が必要
+uint32_t CullSpheres(const Frustum& frustum, std::span<const Sphere> spheres, std::span<uint32_t> visibleIndices);
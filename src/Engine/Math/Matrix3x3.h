@@ -1,4 +1,6 @@
 #pragma once
 struct Matrix3x3 final {
 	float m[3][3];
+
+	constexpr bool operator==(const Matrix3x3&) const = default;
 };
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
 struct Matrix4x4 {
 	float m[4][4];
+
+	constexpr bool operator==(const Matrix4x4&) const = default;
 };
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "MatrixSimd.h"
+
+namespace MatrixSimd
+{
+#pragma region スカラー版
+	Matrix4x4 MultiplyScalar(const Matrix4x4& m1, const Matrix4x4& m2) {
+		Matrix4x4 result;
+		for (int i = 0; i < 4; i++) {
+			// 結果のi行目は、m2の各行をm1[i]の各要素で重み付けした和
+			for (int j = 0; j < 4; j++) {
+				result.m[i][j] =
+					m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] +
+					m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+			}
+		}
+		return result;
+	}
+
+	Matrix4x4 TransposeScalar(const Matrix4x4& m) {
+		Matrix4x4 result;
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				result.m[i][j] = m.m[j][i];
+			}
+		}
+		return result;
+	}
+
+	Matrix4x4 InverseScalar(const Matrix4x4& m) {
+		// 上2行と下2行の2x2小行列式を先に求めて使い回す（余因子展開より乗算が少ない）
+		float s0 = m.m[0][0] * m.m[1][1] - m.m[1][0] * m.m[0][1];
+		float s1 = m.m[0][0] * m.m[1][2] - m.m[1][0] * m.m[0][2];
+		float s2 = m.m[0][0] * m.m[1][3] - m.m[1][0] * m.m[0][3];
+		float s3 = m.m[0][1] * m.m[1][2] - m.m[1][1] * m.m[0][2];
+		float s4 = m.m[0][1] * m.m[1][3] - m.m[1][1] * m.m[0][3];
+		float s5 = m.m[0][2] * m.m[1][3] - m.m[1][2] * m.m[0][3];
+
+		float c5 = m.m[2][2] * m.m[3][3] - m.m[3][2] * m.m[2][3];
+		float c4 = m.m[2][1] * m.m[3][3] - m.m[3][1] * m.m[2][3];
+		float c3 = m.m[2][1] * m.m[3][2] - m.m[3][1] * m.m[2][2];
+		float c2 = m.m[2][0] * m.m[3][3] - m.m[3][0] * m.m[2][3];
+		float c1 = m.m[2][0] * m.m[3][2] - m.m[3][0] * m.m[2][2];
+		float c0 = m.m[2][0] * m.m[3][1] - m.m[3][0] * m.m[2][1];
+
+		float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		float recpDeterminant = 1.0f / determinant;
+
+		Matrix4x4 result;
+		result.m[0][0] = (m.m[1][1] * c5 - m.m[1][2] * c4 + m.m[1][3] * c3) * recpDeterminant;
+		result.m[0][1] = (-m.m[0][1] * c5 + m.m[0][2] * c4 - m.m[0][3] * c3) * recpDeterminant;
+		result.m[0][2] = (m.m[3][1] * s5 - m.m[3][2] * s4 + m.m[3][3] * s3) * recpDeterminant;
+		result.m[0][3] = (-m.m[2][1] * s5 + m.m[2][2] * s4 - m.m[2][3] * s3) * recpDeterminant;
+
+		result.m[1][0] = (-m.m[1][0] * c5 + m.m[1][2] * c2 - m.m[1][3] * c1) * recpDeterminant;
+		result.m[1][1] = (m.m[0][0] * c5 - m.m[0][2] * c2 + m.m[0][3] * c1) * recpDeterminant;
+		result.m[1][2] = (-m.m[3][0] * s5 + m.m[3][2] * s2 - m.m[3][3] * s1) * recpDeterminant;
+		result.m[1][3] = (m.m[2][0] * s5 - m.m[2][2] * s2 + m.m[2][3] * s1) * recpDeterminant;
+
+		result.m[2][0] = (m.m[1][0] * c4 - m.m[1][1] * c2 + m.m[1][3] * c0) * recpDeterminant;
+		result.m[2][1] = (-m.m[0][0] * c4 + m.m[0][1] * c2 - m.m[0][3] * c0) * recpDeterminant;
+		result.m[2][2] = (m.m[3][0] * s4 - m.m[3][1] * s2 + m.m[3][3] * s0) * recpDeterminant;
+		result.m[2][3] = (-m.m[2][0] * s4 + m.m[2][1] * s2 - m.m[2][3] * s0) * recpDeterminant;
+
+		result.m[3][0] = (-m.m[1][0] * c3 + m.m[1][1] * c1 - m.m[1][2] * c0) * recpDeterminant;
+		result.m[3][1] = (m.m[0][0] * c3 - m.m[0][1] * c1 + m.m[0][2] * c0) * recpDeterminant;
+		result.m[3][2] = (-m.m[3][0] * s3 + m.m[3][1] * s1 - m.m[3][2] * s0) * recpDeterminant;
+		result.m[3][3] = (m.m[2][0] * s3 - m.m[2][1] * s1 + m.m[2][2] * s0) * recpDeterminant;
+		return result;
+	}
+
+	Matrix4x4 InverseAffineScalar(const Matrix4x4& m) {
+		// 3x3部分の逆行列は、各行の外積を列に並べたものを行列式で割ったもの
+		const float* r0 = m.m[0];
+		const float* r1 = m.m[1];
+		const float* r2 = m.m[2];
+		float c0[3] = { r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0] };
+		float c1[3] = { r2[1] * r0[2] - r2[2] * r0[1], r2[2] * r0[0] - r2[0] * r0[2], r2[0] * r0[1] - r2[1] * r0[0] };
+		float c2[3] = { r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2], r0[0] * r1[1] - r0[1] * r1[0] };
+		float recpDeterminant = 1.0f / (r0[0] * c0[0] + r0[1] * c0[1] + r0[2] * c0[2]);
+
+		Matrix4x4 result;
+		for (int i = 0; i < 3; i++) {
+			result.m[i][0] = c0[i] * recpDeterminant;
+			result.m[i][1] = c1[i] * recpDeterminant;
+			result.m[i][2] = c2[i] * recpDeterminant;
+			result.m[i][3] = 0.0f;
+		}
+
+		// 平行移動は逆回転・逆スケールを掛けて打ち消す
+		const float* t = m.m[3];
+		for (int j = 0; j < 3; j++) {
+			result.m[3][j] = -(t[0] * result.m[0][j] + t[1] * result.m[1][j] + t[2] * result.m[2][j]);
+		}
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+#pragma endregion
+
+#if defined(MATRIX_SIMD_SSE)
+#pragma region SSE版
+	// 要素の並べ替え（_MM_SHUFFLEと逆順に、結果の先頭から要素番号を指定する）
+#define MATRIX_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps((a), (b), _MM_SHUFFLE((w), (z), (y), (x)))
+#define MATRIX_SWIZZLE(v, x, y, z, w) MATRIX_SHUFFLE((v), (v), (x), (y), (z), (w))
+
+	// 4要素の総和を全要素に入れる
+	inline __m128 HorizontalSum(__m128 v) {
+		v = _mm_add_ps(v, MATRIX_SWIZZLE(v, 2, 3, 0, 1));
+		return _mm_add_ps(v, MATRIX_SWIZZLE(v, 1, 0, 3, 2));
+	}
+
+	// 2x2行列（行優先で1レジスタに格納）の積 A * B
+	inline __m128 Mat2Mul(__m128 a, __m128 b) {
+		return _mm_add_ps(_mm_mul_ps(a, MATRIX_SWIZZLE(b, 0, 3, 0, 3)),
+			_mm_mul_ps(MATRIX_SWIZZLE(a, 1, 0, 3, 2), MATRIX_SWIZZLE(b, 2, 1, 2, 1)));
+	}
+
+	// 2x2行列の余因子行列との積 adj(A) * B
+	inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+		return _mm_sub_ps(_mm_mul_ps(MATRIX_SWIZZLE(a, 3, 3, 0, 0), b),
+			_mm_mul_ps(MATRIX_SWIZZLE(a, 1, 1, 2, 2), MATRIX_SWIZZLE(b, 2, 3, 0, 1)));
+	}
+
+	// 2x2行列と余因子行列の積 A * adj(B)
+	inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+		return _mm_sub_ps(_mm_mul_ps(a, MATRIX_SWIZZLE(b, 3, 0, 3, 0)),
+			_mm_mul_ps(MATRIX_SWIZZLE(a, 1, 0, 3, 2), MATRIX_SWIZZLE(b, 2, 1, 2, 1)));
+	}
+
+	// 3要素の外積（w要素は0になる）
+	inline __m128 Cross(__m128 a, __m128 b) {
+		return _mm_sub_ps(
+			_mm_mul_ps(MATRIX_SWIZZLE(a, 1, 2, 0, 3), MATRIX_SWIZZLE(b, 2, 0, 1, 3)),
+			_mm_mul_ps(MATRIX_SWIZZLE(a, 2, 0, 1, 3), MATRIX_SWIZZLE(b, 1, 2, 0, 3)));
+	}
+
+	const char* GetBackendName() {
+#if defined(MATRIX_SIMD_FMA)
+		return "SSE+FMA";
+#else
+		return "SSE";
+#endif
+	}
+
+	Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+		__m128 b0 = _mm_loadu_ps(m2.m[0]);
+		__m128 b1 = _mm_loadu_ps(m2.m[1]);
+		__m128 b2 = _mm_loadu_ps(m2.m[2]);
+		__m128 b3 = _mm_loadu_ps(m2.m[3]);
+
+		Matrix4x4 result;
+		for (int i = 0; i < 4; i++) {
+			// 結果のi行目 = m1[i][0]*b0 + m1[i][1]*b1 + m1[i][2]*b2 + m1[i][3]*b3
+			__m128 a = _mm_loadu_ps(m1.m[i]);
+			__m128 row = _mm_mul_ps(MATRIX_SWIZZLE(a, 0, 0, 0, 0), b0);
+			row = MulAdd(MATRIX_SWIZZLE(a, 1, 1, 1, 1), b1, row);
+			row = MulAdd(MATRIX_SWIZZLE(a, 2, 2, 2, 2), b2, row);
+			row = MulAdd(MATRIX_SWIZZLE(a, 3, 3, 3, 3), b3, row);
+			_mm_storeu_ps(result.m[i], row);
+		}
+		return result;
+	}
+
+	Matrix4x4 Transpose(const Matrix4x4& m) {
+		__m128 r0 = _mm_loadu_ps(m.m[0]);
+		__m128 r1 = _mm_loadu_ps(m.m[1]);
+		__m128 r2 = _mm_loadu_ps(m.m[2]);
+		__m128 r3 = _mm_loadu_ps(m.m[3]);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		Matrix4x4 result;
+		_mm_storeu_ps(result.m[0], r0);
+		_mm_storeu_ps(result.m[1], r1);
+		_mm_storeu_ps(result.m[2], r2);
+		_mm_storeu_ps(result.m[3], r3);
+		return result;
+	}
+
+	Matrix4x4 Inverse(const Matrix4x4& m) {
+		// 2x2のブロック行列 | A B |
+		//                   | C D | に分けて、ブロックごとの余因子から逆行列を求める
+		__m128 r0 = _mm_loadu_ps(m.m[0]);
+		__m128 r1 = _mm_loadu_ps(m.m[1]);
+		__m128 r2 = _mm_loadu_ps(m.m[2]);
+		__m128 r3 = _mm_loadu_ps(m.m[3]);
+
+		__m128 a = _mm_movelh_ps(r0, r1);
+		__m128 b = _mm_movehl_ps(r1, r0);
+		__m128 c = _mm_movelh_ps(r2, r3);
+		__m128 d = _mm_movehl_ps(r3, r2);
+
+		// 各ブロックの行列式（|A| |B| |C| |D|）
+		__m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(MATRIX_SHUFFLE(r0, r2, 0, 2, 0, 2), MATRIX_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+			_mm_mul_ps(MATRIX_SHUFFLE(r0, r2, 1, 3, 1, 3), MATRIX_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+		__m128 detA = MATRIX_SWIZZLE(detSub, 0, 0, 0, 0);
+		__m128 detB = MATRIX_SWIZZLE(detSub, 1, 1, 1, 1);
+		__m128 detC = MATRIX_SWIZZLE(detSub, 2, 2, 2, 2);
+		__m128 detD = MATRIX_SWIZZLE(detSub, 3, 3, 3, 3);
+
+		// adj(D)*C と adj(A)*B
+		__m128 adjDC = Mat2AdjMul(d, c);
+		__m128 adjAB = Mat2AdjMul(a, b);
+
+		// 逆行列の各ブロックの余因子
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, adjDC));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, adjAB));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, adjAB));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, adjDC));
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 trace = HorizontalSum(_mm_mul_ps(adjAB, MATRIX_SWIZZLE(adjDC, 0, 2, 1, 3)));
+		__m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+		// 余因子行列の符号をまとめて掛ける
+		__m128 recpDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+		x = _mm_mul_ps(x, recpDeterminant);
+		y = _mm_mul_ps(y, recpDeterminant);
+		z = _mm_mul_ps(z, recpDeterminant);
+		w = _mm_mul_ps(w, recpDeterminant);
+
+		// 余因子行列の並べ替えと格納を同時に行う
+		Matrix4x4 result;
+		_mm_storeu_ps(result.m[0], MATRIX_SHUFFLE(x, y, 3, 1, 3, 1));
+		_mm_storeu_ps(result.m[1], MATRIX_SHUFFLE(x, y, 2, 0, 2, 0));
+		_mm_storeu_ps(result.m[2], MATRIX_SHUFFLE(z, w, 3, 1, 3, 1));
+		_mm_storeu_ps(result.m[3], MATRIX_SHUFFLE(z, w, 2, 0, 2, 0));
+		return result;
+	}
+
+	Matrix4x4 InverseAffine(const Matrix4x4& m) {
+		// w要素を0にした1～3行目
+		__m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		__m128 r0 = _mm_and_ps(_mm_loadu_ps(m.m[0]), mask);
+		__m128 r1 = _mm_and_ps(_mm_loadu_ps(m.m[1]), mask);
+		__m128 r2 = _mm_and_ps(_mm_loadu_ps(m.m[2]), mask);
+
+		// 3x3部分の逆行列は、各行の外積を列に並べたものを行列式で割ったもの
+		__m128 c0 = Cross(r1, r2);
+		__m128 c1 = Cross(r2, r0);
+		__m128 c2 = Cross(r0, r1);
+		__m128 c3 = _mm_setzero_ps();
+		__m128 recpDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), HorizontalSum(_mm_mul_ps(r0, c0)));
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		c0 = _mm_mul_ps(c0, recpDeterminant);
+		c1 = _mm_mul_ps(c1, recpDeterminant);
+		c2 = _mm_mul_ps(c2, recpDeterminant);
+
+		// 平行移動は逆回転・逆スケールを掛けて打ち消す
+		__m128 t = _mm_loadu_ps(m.m[3]);
+		__m128 translate = _mm_mul_ps(MATRIX_SWIZZLE(t, 0, 0, 0, 0), c0);
+		translate = MulAdd(MATRIX_SWIZZLE(t, 1, 1, 1, 1), c1, translate);
+		translate = MulAdd(MATRIX_SWIZZLE(t, 2, 2, 2, 2), c2, translate);
+		translate = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translate);
+
+		Matrix4x4 result;
+		_mm_storeu_ps(result.m[0], c0);
+		_mm_storeu_ps(result.m[1], c1);
+		_mm_storeu_ps(result.m[2], c2);
+		_mm_storeu_ps(result.m[3], translate);
+		return result;
+	}
+
+#undef MATRIX_SWIZZLE
+#undef MATRIX_SHUFFLE
+#pragma endregion
+#elif defined(MATRIX_SIMD_NEON)
+#pragma region NEON版
+	const char* GetBackendName() {
+		return "NEON";
+	}
+
+	Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+		float32x4_t b0 = vld1q_f32(m2.m[0]);
+		float32x4_t b1 = vld1q_f32(m2.m[1]);
+		float32x4_t b2 = vld1q_f32(m2.m[2]);
+		float32x4_t b3 = vld1q_f32(m2.m[3]);
+
+		Matrix4x4 result;
+		for (int i = 0; i < 4; i++) {
+			float32x4_t row = vmulq_n_f32(b0, m1.m[i][0]);
+			row = vmlaq_n_f32(row, b1, m1.m[i][1]);
+			row = vmlaq_n_f32(row, b2, m1.m[i][2]);
+			row = vmlaq_n_f32(row, b3, m1.m[i][3]);
+			vst1q_f32(result.m[i], row);
+		}
+		return result;
+	}
+
+	Matrix4x4 Transpose(const Matrix4x4& m) {
+		// 4要素おきに読み込むと列がそのまま取り出せる
+		float32x4x4_t columns = vld4q_f32(&m.m[0][0]);
+		Matrix4x4 result;
+		vst1q_f32(result.m[0], columns.val[0]);
+		vst1q_f32(result.m[1], columns.val[1]);
+		vst1q_f32(result.m[2], columns.val[2]);
+		vst1q_f32(result.m[3], columns.val[3]);
+		return result;
+	}
+
+	// 逆行列はシャッフルの多いSSE版の移植より、スカラー版のほうがNEONでは素直に速い
+	Matrix4x4 Inverse(const Matrix4x4& m) {
+		return InverseScalar(m);
+	}
+
+	Matrix4x4 InverseAffine(const Matrix4x4& m) {
+		return InverseAffineScalar(m);
+	}
+#pragma endregion
+#else
+#pragma region SIMDなし
+	const char* GetBackendName() {
+		return "Scalar";
+	}
+
+	Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+		return MultiplyScalar(m1, m2);
+	}
+
+	Matrix4x4 Transpose(const Matrix4x4& m) {
+		return TransposeScalar(m);
+	}
+
+	Matrix4x4 Inverse(const Matrix4x4& m) {
+		return InverseScalar(m);
+	}
+
+	Matrix4x4 InverseAffine(const Matrix4x4& m) {
+		return InverseAffineScalar(m);
+	}
+#pragma endregion
+#endif
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "Matrix4x4.h"
+
+// 使用するSIMD命令セットの判定
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MATRIX_SIMD_SSE
+#include <immintrin.h>
+#if defined(__FMA__) || defined(__AVX2__)
+#define MATRIX_SIMD_FMA
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define MATRIX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// 4x4行列演算のSIMD実装
+// x86/x64ではSSE（FMAが使える構成ならFMA）、ARMではNEON、それ以外はスカラー版を使う
+// ただしNEONでSIMD化しているのは積と転置だけで、InverseとInverseAffineはスカラー版をそのまま呼ぶ（結果もスカラー版と同じ）
+// 行列は行優先・行ベクトル形式（v * M）で、Mymath.hの関数はここに処理を委譲する
+// ただし積と転置はスカラー版でも同じ命令列に自動ベクトル化されて速度差がないため、Mymath.hからはスカラー版を呼ぶ
+namespace MatrixSimd
+{
+	// 使用中の実装の名前（"SSE" / "SSE+FMA" / "NEON" / "Scalar"）
+	const char* GetBackendName();
+
+	// 行列の積（m1 * m2）
+	Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+
+	// 転置行列
+	Matrix4x4 Transpose(const Matrix4x4& m);
+
+	// 逆行列（一般の4x4行列、NEONではスカラー版）
+	Matrix4x4 Inverse(const Matrix4x4& m);
+
+	// 逆行列（4列目が(0,0,0,1)のアフィン行列専用、3x3部分の逆行列と平行移動の打ち消しだけで求める、NEONではスカラー版）
+	Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+	// スカラー版（検証・比較用）
+	Matrix4x4 MultiplyScalar(const Matrix4x4& m1, const Matrix4x4& m2);
+	Matrix4x4 TransposeScalar(const Matrix4x4& m);
+	Matrix4x4 InverseScalar(const Matrix4x4& m);
+	Matrix4x4 InverseAffineScalar(const Matrix4x4& m);
+
+#if defined(MATRIX_SIMD_SSE)
+	// a * b + c（FMAが使えれば1命令で計算する）
+	inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(MATRIX_SIMD_FMA)
+		return _mm_fmadd_ps(a, b, c);
+#else
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+	}
+#endif
+};
@@ -1,60 +1,41 @@
-#include "MyMath.h"
+#include "Mymath.h"
+#include "FastMath.h"
+#include "MatrixSimd.h"
 
 //float Cot(float theta)
 //{
 //	return 1 / std::tan(theta);
 //}
 
-#pragma region 単位行列
-Matrix4x4 MakeIdentity4x4() {
-	Matrix4x4 result = {
-		1,0,0,0,
-		0,1,0,0,
-		0,0,1,0,
-		0,0,0,1
-	};
-	return result;
+#pragma region 4x4Matrix同士の乗算
+// SSE版は行のブロードキャスト積和で書いてあるが、スカラー版もコンパイラが同じ命令列に自動ベクトル化するため速度差がない
+// 委譲先はスカラー版にしておく（SIMD版はMatrixSimdBenchでの比較用に残す）
+Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	return MatrixSimd::MultiplyScalar(m1, m2);
 }
 #pragma endregion
 
-#pragma region 4x4Matrix同士の乗算
-Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
-	Matrix4x4 result = {};
-	for (int i = 0; i < 4; i++) {
-		for (int j = 0; j < 4; j++) {
-			for (int k = 0; k < 4; k++) {
-				result.m[i][j] += m1.m[i][k] * m2.m[k][j];
-			}
-		}
-	}
-	return result;
+#pragma region 転置行列の作成
+// 転置も_MM_TRANSPOSE4_PS版とスカラー版で速度差がないため、スカラー版に委譲する
+Matrix4x4 Transpose(const Matrix4x4& m) {
+	return MatrixSimd::TransposeScalar(m);
 }
 #pragma endregion
 
 #pragma region 回転行列の作成
 Matrix4x4 MakeRotateMatrix(const Vector3& rotate) {
-	Matrix4x4 rotateX;
-	rotateX = {
-	1,0,0,0,
-		0,std::cos(rotate.x),std::sin(rotate.x),0,
-		0,-std::sin(rotate.x),std::cos(rotate.x),0,
-		0,0,0,1
-	};
-	Matrix4x4 rotateY;
-	rotateY = {
-	std::cos(rotate.y),0,-std::sin(rotate.y),0,
-		0,1,0,0,
-		std::sin(rotate.y),0,std::cos(rotate.y),
-		0,0,0,0,1
-	};
-	Matrix4x4 rotateZ;
-	rotateZ = {
-	std::cos(rotate.z),std::sin(rotate.z),0,0,
-		-std::sin(rotate.z),std::cos(rotate.z),0,0,
-		0,0,1,0,
-		0,0,0,1
+	// RotateX * RotateY * RotateZ を展開した式（各軸のsin・cosはSinCosで同時に求める）
+	float sx, cx, sy, cy, sz, cz;
+	FastMath::SinCos(rotate.x, sx, cx);
+	FastMath::SinCos(rotate.y, sy, cy);
+	FastMath::SinCos(rotate.z, sz, cz);
+
+	Matrix4x4 result = {
+		cy * cz, cy * sz, -sy, 0,
+		sx * sy * cz - cx * sz, sx * sy * sz + cx * cz, sx * cy, 0,
+		cx * sy * cz + sx * sz, cx * sy * sz - sx * cz, cx * cy, 0,
+		0, 0, 0, 1
 	};
-	Matrix4x4 result = Multiply(rotateX, Multiply(rotateY, rotateZ));
 	return result;
 }
 #pragma endregion
@@ -75,94 +56,12 @@ Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Ve
 
 #pragma region 逆行列の作成
 Matrix4x4 Inverse(const Matrix4x4& m) {
-	float determinant =
-		+m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3]
-		+ m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1]
-		+ m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2]
-
-		- m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1]
-		- m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3]
-		- m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2]
-
-		- m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3]
-		- m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1]
-		- m.m[0][3] * m.m[1][0] * m.m[2][1] * m.m[3][2]
-
-		+ m.m[0][3] * m.m[1][0] * m.m[2][2] * m.m[3][1]
-		+ m.m[0][2] * m.m[1][0] * m.m[2][1] * m.m[3][3]
-		+ m.m[0][1] * m.m[1][0] * m.m[2][3] * m.m[3][2]
-
-		+ m.m[0][1] * m.m[1][2] * m.m[2][0] * m.m[3][3]
-		+ m.m[0][2] * m.m[1][3] * m.m[2][0] * m.m[3][1]
-		+ m.m[0][3] * m.m[1][1] * m.m[2][0] * m.m[3][2]
-
-		- m.m[0][3] * m.m[1][2] * m.m[2][0] * m.m[3][1]
-		- m.m[0][2] * m.m[1][1] * m.m[2][0] * m.m[3][3]
-		- m.m[0][1] * m.m[1][3] * m.m[2][0] * m.m[3][2]
-
-		- m.m[0][1] * m.m[1][2] * m.m[2][3] * m.m[3][0]
-		- m.m[0][2] * m.m[1][3] * m.m[2][1] * m.m[3][0]
-		- m.m[0][3] * m.m[1][1] * m.m[2][2] * m.m[3][0]
-
-		+ m.m[0][3] * m.m[1][2] * m.m[2][1] * m.m[3][0]
-		+ m.m[0][2] * m.m[1][1] * m.m[2][3] * m.m[3][0]
-		+ m.m[0][1] * m.m[1][3] * m.m[2][2] * m.m[3][0];
-
-	Matrix4x4 result = {};
-	float recpDeterminant = 1.0f / determinant;
-	result.m[0][0] = (m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] +
-		m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][3] * m.m[2][2] * m.m[3][1] -
-		m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[1][1] * m.m[2][3] * m.m[3][2]) * recpDeterminant;
-	result.m[0][1] = (-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1] -
-		m.m[0][3] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[2][2] * m.m[3][1] +
-		m.m[0][2] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[2][3] * m.m[3][2]) * recpDeterminant;
-	result.m[0][2] = (m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] +
-		m.m[0][3] * m.m[1][1] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[3][1] -
-		m.m[0][2] * m.m[1][1] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[3][2]) * recpDeterminant;
-	result.m[0][3] = (-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1] -
-		m.m[0][3] * m.m[1][1] * m.m[2][2] + m.m[0][3] * m.m[1][2] * m.m[2][1] +
-		m.m[0][2] * m.m[1][1] * m.m[2][3] + m.m[0][1] * m.m[1][3] * m.m[2][2]) * recpDeterminant;
-
-	result.m[1][0] = (-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0] -
-		m.m[1][3] * m.m[2][0] * m.m[3][2] + m.m[1][3] * m.m[2][2] * m.m[3][0] +
-		m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[1][0] * m.m[2][3] * m.m[3][2]) * recpDeterminant;
-	result.m[1][1] = (m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] +
-		m.m[0][3] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[2][2] * m.m[3][0] -
-		m.m[0][2] * m.m[2][0] * m.m[3][3] - m.m[0][0] * m.m[2][3] * m.m[3][2]) * recpDeterminant;
-	result.m[1][2] = (-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0] -
-		m.m[0][3] * m.m[1][0] * m.m[3][2] + m.m[0][3] * m.m[1][2] * m.m[3][0] +
-		m.m[0][2] * m.m[1][0] * m.m[3][3] + m.m[0][0] * m.m[1][3] * m.m[3][2]) * recpDeterminant;
-	result.m[1][3] = (m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] +
-		m.m[0][3] * m.m[1][0] * m.m[2][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] -
-		m.m[0][2] * m.m[1][0] * m.m[2][3] - m.m[0][0] * m.m[1][3] * m.m[2][2]) * recpDeterminant;
-
-	result.m[2][0] = (m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] +
-		m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][3] * m.m[2][1] * m.m[3][0] -
-		m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[1][0] * m.m[2][3] * m.m[3][1]) * recpDeterminant;
-	result.m[2][1] = (-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0] -
-		m.m[0][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[2][1] * m.m[3][0] +
-		m.m[0][1] * m.m[2][0] * m.m[3][3] + m.m[0][0] * m.m[2][3] * m.m[3][1]) * recpDeterminant;
-	result.m[2][2] = (m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] +
-		m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][3] * m.m[1][1] * m.m[3][0] -
-		m.m[0][1] * m.m[1][0] * m.m[3][3] - m.m[0][0] * m.m[1][3] * m.m[3][1]) * recpDeterminant;
-	result.m[2][3] = (-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] -
-		m.m[0][3] * m.m[1][0] * m.m[2][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] +
-		m.m[0][1] * m.m[1][0] * m.m[2][3] + m.m[0][0] * m.m[1][3] * m.m[2][1]) * recpDeterminant;
-
-	result.m[3][0] = (-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] -
-		m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[2][1] * m.m[3][0] +
-		m.m[1][1] * m.m[2][0] * m.m[3][2] + m.m[1][0] * m.m[2][2] * m.m[3][1]) * recpDeterminant;
-	result.m[3][1] = (m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] +
-		m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[2][1] * m.m[3][0] -
-		m.m[0][1] * m.m[2][0] * m.m[3][2] - m.m[0][0] * m.m[2][2] * m.m[3][1]) * recpDeterminant;
-	result.m[3][2] = (-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] -
-		m.m[0][2] * m.m[1][0] * m.m[3][1] + m.m[0][2] * m.m[1][1] * m.m[3][0] +
-		m.m[0][1] * m.m[1][0] * m.m[3][2] + m.m[0][0] * m.m[1][2] * m.m[3][1]) * recpDeterminant;
-	result.m[3][3] = (m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] +
-		m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] -
-		m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1]) * recpDeterminant;
+	return MatrixSimd::Inverse(m);
+}
 
-	return result;
+// アフィン行列（拡大縮小・回転・平行移動のみ）専用の逆行列
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	return MatrixSimd::InverseAffine(m);
 }
 #pragma endregion
 
@@ -238,34 +137,12 @@ Matrix4x4 Inverse(const Matrix4x4& m) {
 //}
 #pragma endregion
 
-Matrix4x4 MakeScaleMatrix(const Vector3& scale)
-{
-	Matrix4x4 ans;
-
-	ans.m[0][0] = scale.x;
-	ans.m[0][1] = 0;
-	ans.m[0][2] = 0;
-	ans.m[0][3] = 0;
-
-	ans.m[1][0] = 0;
-	ans.m[1][1] = scale.y;
-	ans.m[1][2] = 0;
-	ans.m[1][3] = 0;
-
-	ans.m[2][0] = 0;
-	ans.m[2][1] = 0;
-	ans.m[2][2] = scale.z;
-	ans.m[2][3] = 0;
-
-	ans.m[3][0] = 0;
-	ans.m[3][1] = 0;
-	ans.m[3][2] = 0;
-	ans.m[3][3] = 1;
-	return ans;
-}
 
 Matrix4x4 MakeRotateXMatrix(float radian)
 {
+	float s, c;
+	FastMath::SinCos(radian, s, c);
+
 	Matrix4x4 ans;
 
 	ans.m[0][0] = 1;
@@ -274,13 +151,13 @@ Matrix4x4 MakeRotateXMatrix(float radian)
 	ans.m[0][3] = 0;
 
 	ans.m[1][0] = 0;
-	ans.m[1][1] = std::cos(radian);;
-	ans.m[1][2] = std::sin(radian);;
+	ans.m[1][1] = c;
+	ans.m[1][2] = s;
 	ans.m[1][3] = 0;
 
 	ans.m[2][0] = 0;
-	ans.m[2][1] = -std::sin(radian);;
-	ans.m[2][2] = std::cos(radian);;
+	ans.m[2][1] = -s;
+	ans.m[2][2] = c;
 	ans.m[2][3] = 0;
 
 	ans.m[3][0] = 0;
@@ -293,11 +170,14 @@ Matrix4x4 MakeRotateXMatrix(float radian)
 
 Matrix4x4 MakeRotateYMatrix(float radian)
 {
+	float s, c;
+	FastMath::SinCos(radian, s, c);
+
 	Matrix4x4 ans;
 
-	ans.m[0][0] = std::cos(radian);
+	ans.m[0][0] = c;
 	ans.m[0][1] = 0;
-	ans.m[0][2] = -std::sin(radian);
+	ans.m[0][2] = -s;
 	ans.m[0][3] = 0;
 
 	ans.m[1][0] = 0;
@@ -305,9 +185,9 @@ Matrix4x4 MakeRotateYMatrix(float radian)
 	ans.m[1][2] = 0;
 	ans.m[1][3] = 0;
 
-	ans.m[2][0] = std::sin(radian);;
+	ans.m[2][0] = s;
 	ans.m[2][1] = 0;
-	ans.m[2][2] = std::cos(radian);;
+	ans.m[2][2] = c;
 	ans.m[2][3] = 0;
 
 	ans.m[3][0] = 0;
@@ -320,15 +200,18 @@ Matrix4x4 MakeRotateYMatrix(float radian)
 
 Matrix4x4 MakeRotateZMatrix(float radian)
 {
+	float s, c;
+	FastMath::SinCos(radian, s, c);
+
 	Matrix4x4 ans;
 
-	ans.m[0][0] = std::cos(radian);
-	ans.m[0][1] = std::sin(radian);
+	ans.m[0][0] = c;
+	ans.m[0][1] = s;
 	ans.m[0][2] = 0;
 	ans.m[0][3] = 0;
 
-	ans.m[1][0] = -std::sin(radian);
-	ans.m[1][1] = std::cos(radian);
+	ans.m[1][0] = -s;
+	ans.m[1][1] = c;
 	ans.m[1][2] = 0;
 	ans.m[1][3] = 0;
 
@@ -346,29 +229,43 @@ Matrix4x4 MakeRotateZMatrix(float radian)
 	return ans;
 }
 
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate)
-{
-	Matrix4x4 ans;
-
-	ans.m[0][0] = 1;
-	ans.m[0][1] = 0;
-	ans.m[0][2] = 0;
-	ans.m[0][3] = 0;
-
-	ans.m[1][0] = 0;
-	ans.m[1][1] = 1;
-	ans.m[1][2] = 0;
-	ans.m[1][3] = 0;
-
-	ans.m[2][0] = 0;
-	ans.m[2][1] = 0;
-	ans.m[2][2] = 1;
-	ans.m[2][3] = 0;
-
-	ans.m[3][0] = translate.x;
-	ans.m[3][1] = translate.y;
-	ans.m[3][2] = translate.z;
-	ans.m[3][3] = 1;
-
-	return ans;
-}
\ No newline at end of file
+#pragma region コンパイル時の確認
+// ヘッダーのconstexpr関数と演算子がコンパイル時に評価できることと、その結果を確かめる
+namespace {
+	constexpr Vector3 kTestVector = { 1.0f, 2.0f, 3.0f };
+	static_assert(kTestVector + Vector3{ 1.0f, 1.0f, 1.0f } == Vector3{ 2.0f, 3.0f, 4.0f });
+	static_assert(kTestVector - kTestVector == Vector3{ 0.0f, 0.0f, 0.0f });
+	static_assert(-kTestVector == Vector3{ -1.0f, -2.0f, -3.0f });
+	static_assert(kTestVector * 2.0f == 2.0f * kTestVector);
+	static_assert(kTestVector / 2.0f == Vector3{ 0.5f, 1.0f, 1.5f });
+	static_assert(Dot(kTestVector, kTestVector) == 14.0f);
+	static_assert(Cross(Vector3{ 1.0f, 0.0f, 0.0f }, Vector3{ 0.0f, 1.0f, 0.0f }) == Vector3{ 0.0f, 0.0f, 1.0f });
+	static_assert(Vector2{ 1.0f, 2.0f } * 3.0f == Vector2{ 3.0f, 6.0f });
+	static_assert(Vector4{ 1.0f, 2.0f, 3.0f, 4.0f } - Vector4{ 1.0f, 1.0f, 1.0f, 1.0f } == Vector4{ 0.0f, 1.0f, 2.0f, 3.0f });
+
+	constexpr Vector3 AddAssignTest() {
+		Vector3 v = kTestVector;
+		v += kTestVector;
+		v *= 0.5f;
+		return v;
+	}
+	static_assert(AddAssignTest() == kTestVector);
+
+	constexpr Matrix4x4 kTestScale = MakeScaleMatrix({ 2.0f, 3.0f, 4.0f });
+	constexpr Matrix4x4 kTestTranslate = MakeTranslateMatrix({ 5.0f, 6.0f, 7.0f });
+	static_assert(MakeIdentity4x4() * kTestScale == kTestScale);
+	static_assert(kTestScale * MakeIdentity4x4() == kTestScale);
+
+	// 行ベクトル形式なので、Scale * Translateは拡大縮小の後に平行移動する行列になる
+	constexpr Matrix4x4 kTestScaleTranslate = kTestScale * kTestTranslate;
+	static_assert(kTestScaleTranslate.m[0][0] == 2.0f && kTestScaleTranslate.m[1][1] == 3.0f && kTestScaleTranslate.m[2][2] == 4.0f);
+	static_assert(kTestScaleTranslate.m[3][0] == 5.0f && kTestScaleTranslate.m[3][1] == 6.0f && kTestScaleTranslate.m[3][2] == 7.0f);
+	static_assert(kTestTranslate * kTestScale == Matrix4x4{
+		2.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 3.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 4.0f, 0.0f,
+		10.0f, 18.0f, 28.0f, 1.0f });
+	static_assert(TransformPoint(kTestVector, kTestScaleTranslate) == Vector3{ 7.0f, 12.0f, 19.0f });
+	static_assert(TransformVector(kTestVector, kTestScaleTranslate) == Vector3{ 2.0f, 6.0f, 12.0f });
+}
+#pragma endregion
\ No newline at end of file
@@ -6,25 +6,98 @@
 #include "Vector2.h"
 #include <assert.h>
 #include <cmath>
+#include <cstdint>
 #include <stdio.h>
 #include <vector>
 #include <string>
+#include <type_traits>
 
 //float Cot(float theta);
 
-Matrix4x4 MakeIdentity4x4();
 Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
 Matrix4x4 MakeRotateMatrix(const Vector3& rotate);
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
 Matrix4x4 Inverse(const Matrix4x4& m);
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+Matrix4x4 Transpose(const Matrix4x4& m);
 //Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip);
 //Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearclip, float farclip);
 //Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
-Matrix4x4 MakeScaleMatrix(const Vector3& scale);
 Matrix4x4 MakeRotateXMatrix(float radian);
 Matrix4x4 MakeRotateYMatrix(float radian);
 Matrix4x4 MakeRotateZMatrix(float radian);
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+
+#pragma region constexpr関数
+// 引数が定数ならコンパイル時に計算され、実行時も呼び出し先でインライン展開されるようヘッダーで定義する
+
+// 単位行列
+constexpr Matrix4x4 MakeIdentity4x4() {
+	return {
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 1, 0,
+		0, 0, 0, 1
+	};
+}
+
+// 拡大縮小行列
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	return {
+		scale.x, 0, 0, 0,
+		0, scale.y, 0, 0,
+		0, 0, scale.z, 0,
+		0, 0, 0, 1
+	};
+}
+
+// 平行移動行列
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	return {
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 1, 0,
+		translate.x, translate.y, translate.z, 1
+	};
+}
+
+// 行列の積（m1 * m2）
+// コンパイル時はその場で計算し、実行時はSIMD実装のMultiplyを使う
+constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) {
+	if (std::is_constant_evaluated()) {
+		Matrix4x4 result = {};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+			}
+		}
+		return result;
+	}
+	return Multiply(m1, m2);
+}
+
+constexpr Matrix4x4& operator*=(Matrix4x4& m1, const Matrix4x4& m2) {
+	m1 = m1 * m2;
+	return m1;
+}
+
+// 点の変換（行ベクトル形式、平行移動を含む。アフィン行列用でwでの除算はしない）
+constexpr Vector3 TransformPoint(const Vector3& v, const Matrix4x4& m) {
+	return {
+		v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0],
+		v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1],
+		v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2]
+	};
+}
+
+// 方向ベクトルの変換（平行移動を含めない）
+constexpr Vector3 TransformVector(const Vector3& v, const Matrix4x4& m) {
+	return {
+		v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+		v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+		v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2]
+	};
+}
+#pragma endregion
 
 struct VertexData {
     Vector4 position;
@@ -58,6 +131,7 @@ struct Transform {
 
 // マテリアルデータ構造体の定義
 struct MaterialData {
+    std::string name;             // マテリアル名(newmtl)
     std::string textureFilePath;  // テクスチャファイルパス
     Vector4 ambient = { 0.1f, 0.1f, 0.1f, 1.0f };  // 環境光(Ka)
     Vector4 diffuse = { 0.8f, 0.8f, 0.8f, 1.0f };  // 拡散反射光(Kd)
@@ -66,7 +140,16 @@ struct MaterialData {
     float alpha = 1.0f;                          // 透明度(d)
 };
 
+// サブメッシュ（1つのマテリアルで描画するインデックスの範囲）
+struct SubMeshData {
+    uint32_t indexStart;     // 最初のインデックスの位置
+    uint32_t indexCount;     // インデックスの数
+    uint32_t materialIndex;  // マテリアルの番号（ModelData::materialsの添字）
+};
+
 struct ModelData {
     std::vector<VertexData>vertices;
-    MaterialData material;
+    std::vector<uint32_t> indices;  // 三角形リストのインデックス（verticesの添字）
+    std::vector<MaterialData> materials;  // マテリアルの一覧（OBJで最初に使われた順）
+    std::vector<SubMeshData> subMeshes;   // 描画範囲（最適化後はマテリアルごとに1つにまとめる）
 };
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "Quaternion.h"
+#include "Mymath.h"
+#include "FastMath.h"
+#include "MatrixSimd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#pragma region 基本演算
+Quaternion IdentityQuaternion() {
+	return { 0.0f, 0.0f, 0.0f, 1.0f };
+}
+
+Quaternion Multiply(const Quaternion& lhs, const Quaternion& rhs) {
+	Quaternion result;
+	result.x = lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y;
+	result.y = lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x;
+	result.z = lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w;
+	result.w = lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z;
+	return result;
+}
+
+Quaternion Conjugate(const Quaternion& quaternion) {
+	return { -quaternion.x, -quaternion.y, -quaternion.z, quaternion.w };
+}
+
+float Dot(const Quaternion& q0, const Quaternion& q1) {
+	return q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+}
+
+float Norm(const Quaternion& quaternion) {
+	return std::sqrt(Dot(quaternion, quaternion));
+}
+
+Quaternion Normalize(const Quaternion& quaternion) {
+	float norm = Norm(quaternion);
+	if (norm == 0.0f) {
+		return IdentityQuaternion();
+	}
+	float recpNorm = 1.0f / norm;
+	return { quaternion.x * recpNorm, quaternion.y * recpNorm, quaternion.z * recpNorm, quaternion.w * recpNorm };
+}
+
+Quaternion Inverse(const Quaternion& quaternion) {
+	// 共役をノルムの2乗で割る
+	float recpNormSq = 1.0f / Dot(quaternion, quaternion);
+	Quaternion conjugate = Conjugate(quaternion);
+	return { conjugate.x * recpNormSq, conjugate.y * recpNormSq, conjugate.z * recpNormSq, conjugate.w * recpNormSq };
+}
+#pragma endregion
+
+#pragma region 回転との変換
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle) {
+	float s, c;
+	FastMath::SinCos(angle * 0.5f, s, c);
+	return { axis.x * s, axis.y * s, axis.z * s, c };
+}
+
+Quaternion MakeRotateQuaternion(const Vector3& rotate) {
+	// 行列は X * Y * Z の順に掛けるので、クォータニオンでは Z * Y * X の順になる
+	Quaternion rotateX = MakeRotateAxisAngleQuaternion({ 1.0f, 0.0f, 0.0f }, rotate.x);
+	Quaternion rotateY = MakeRotateAxisAngleQuaternion({ 0.0f, 1.0f, 0.0f }, rotate.y);
+	Quaternion rotateZ = MakeRotateAxisAngleQuaternion({ 0.0f, 0.0f, 1.0f }, rotate.z);
+	return Multiply(rotateZ, Multiply(rotateY, rotateX));
+}
+
+Quaternion MakeRotateQuaternion(const Matrix4x4& matrix) {
+	const auto& m = matrix.m;
+	float trace = m[0][0] + m[1][1] + m[2][2];
+
+	// 誤差が小さくなるように、一番大きくなる成分から求める
+	Quaternion result;
+	if (trace > 0.0f) {
+		float s = std::sqrt(trace + 1.0f) * 2.0f;
+		result.w = 0.25f * s;
+		result.x = (m[1][2] - m[2][1]) / s;
+		result.y = (m[2][0] - m[0][2]) / s;
+		result.z = (m[0][1] - m[1][0]) / s;
+	}
+	else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+		float s = std::sqrt(1.0f + m[0][0] - m[1][1] - m[2][2]) * 2.0f;
+		result.w = (m[1][2] - m[2][1]) / s;
+		result.x = 0.25f * s;
+		result.y = (m[0][1] + m[1][0]) / s;
+		result.z = (m[0][2] + m[2][0]) / s;
+	}
+	else if (m[1][1] > m[2][2]) {
+		float s = std::sqrt(1.0f + m[1][1] - m[0][0] - m[2][2]) * 2.0f;
+		result.w = (m[2][0] - m[0][2]) / s;
+		result.x = (m[0][1] + m[1][0]) / s;
+		result.y = 0.25f * s;
+		result.z = (m[1][2] + m[2][1]) / s;
+	}
+	else {
+		float s = std::sqrt(1.0f + m[2][2] - m[0][0] - m[1][1]) * 2.0f;
+		result.w = (m[0][1] - m[1][0]) / s;
+		result.x = (m[0][2] + m[2][0]) / s;
+		result.y = (m[1][2] + m[2][1]) / s;
+		result.z = 0.25f * s;
+	}
+	return result;
+}
+
+Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion) {
+	float xx = quaternion.x * quaternion.x;
+	float yy = quaternion.y * quaternion.y;
+	float zz = quaternion.z * quaternion.z;
+	float xy = quaternion.x * quaternion.y;
+	float xz = quaternion.x * quaternion.z;
+	float yz = quaternion.y * quaternion.z;
+	float wx = quaternion.w * quaternion.x;
+	float wy = quaternion.w * quaternion.y;
+	float wz = quaternion.w * quaternion.z;
+
+	Matrix4x4 result = {
+		1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+		2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+		2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f
+	};
+	return result;
+}
+
+Vector3 RotateVector(const Vector3& vector, const Quaternion& quaternion) {
+	// q * v * q^-1 を展開した式（t = 2 * (qv × v)、v' = v + w * t + qv × t）
+	float tx = 2.0f * (quaternion.y * vector.z - quaternion.z * vector.y);
+	float ty = 2.0f * (quaternion.z * vector.x - quaternion.x * vector.z);
+	float tz = 2.0f * (quaternion.x * vector.y - quaternion.y * vector.x);
+	return {
+		vector.x + quaternion.w * tx + (quaternion.y * tz - quaternion.z * ty),
+		vector.y + quaternion.w * ty + (quaternion.z * tx - quaternion.x * tz),
+		vector.z + quaternion.w * tz + (quaternion.x * ty - quaternion.y * tx),
+	};
+}
+#pragma endregion
+
+#pragma region 補間
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	// 内積が負なら片方を反転して近い側の経路を通す
+	float sign = Dot(q0, q1) < 0.0f ? -1.0f : 1.0f;
+	Quaternion result = {
+		q0.x + (sign * q1.x - q0.x) * t,
+		q0.y + (sign * q1.y - q0.y) * t,
+		q0.z + (sign * q1.z - q0.z) * t,
+		q0.w + (sign * q1.w - q0.w) * t,
+	};
+	return Normalize(result);
+}
+
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	// 内積が負なら片方を反転して近い側の経路を通す
+	float dot = Dot(q0, q1);
+	float sign = 1.0f;
+	if (dot < 0.0f) {
+		dot = -dot;
+		sign = -1.0f;
+	}
+
+	// ほぼ同じ向きならsinθが0に近く不安定なので線形補間で代用する
+	if (dot > 0.9995f) {
+		return Nlerp(q0, q1, t);
+	}
+
+	float theta = std::acos((std::min)(dot, 1.0f));
+	float recpSinTheta = 1.0f / std::sin(theta);
+	float scale0 = std::sin((1.0f - t) * theta) * recpSinTheta;
+	float scale1 = std::sin(t * theta) * recpSinTheta * sign;
+	return {
+		scale0 * q0.x + scale1 * q1.x,
+		scale0 * q0.y + scale1 * q1.y,
+		scale0 * q0.z + scale1 * q1.z,
+		scale0 * q0.w + scale1 * q1.w,
+	};
+}
+#pragma endregion
+
+#pragma region まとめて補間
+namespace
+{
+	// sin(tθ)/sinθ の級数展開の項数（θ <= π/2 の範囲で誤差1.5e-7程度）
+	const int kSlerpTermCount = 14;
+	// 打ち切った残りの項をまとめて近似するため最後の項に掛ける係数（誤差が最小になるよう数値的に求めた値）
+	const float kSlerpMu = 1.9066f;
+
+	// Eberlyの多項式近似の係数 u[i] = 1 / ((i + 1)(2i + 3))、v[i] = (i + 1) / (2i + 3)
+	struct SlerpCoefficients {
+		float u[kSlerpTermCount];
+		float v[kSlerpTermCount];
+
+		SlerpCoefficients() {
+			for (int i = 0; i < kSlerpTermCount; i++) {
+				u[i] = 1.0f / static_cast<float>((i + 1) * (2 * i + 3));
+				v[i] = static_cast<float>(i + 1) / static_cast<float>(2 * i + 3);
+			}
+			u[kSlerpTermCount - 1] *= kSlerpMu;
+			v[kSlerpTermCount - 1] *= kSlerpMu;
+		}
+	};
+	const SlerpCoefficients kSlerpCoefficients;
+
+#if defined(MATRIX_SIMD_SSE)
+	// 4個分のクォータニオン（成分ごとのレジスタ）
+	struct QuaternionLanes {
+		__m128 x;
+		__m128 y;
+		__m128 z;
+		__m128 w;
+	};
+
+	// 4個分を読み込んで成分ごとに並べ替える
+	QuaternionLanes LoadLanes(const Quaternion* quaternions) {
+		QuaternionLanes lanes = {
+			_mm_loadu_ps(&quaternions[0].x),
+			_mm_loadu_ps(&quaternions[1].x),
+			_mm_loadu_ps(&quaternions[2].x),
+			_mm_loadu_ps(&quaternions[3].x),
+		};
+		_MM_TRANSPOSE4_PS(lanes.x, lanes.y, lanes.z, lanes.w);
+		return lanes;
+	}
+
+	// 成分ごとの並びを元に戻して4個分を書き込む
+	void StoreLanes(Quaternion* quaternions, QuaternionLanes lanes) {
+		_MM_TRANSPOSE4_PS(lanes.x, lanes.y, lanes.z, lanes.w);
+		_mm_storeu_ps(&quaternions[0].x, lanes.x);
+		_mm_storeu_ps(&quaternions[1].x, lanes.y);
+		_mm_storeu_ps(&quaternions[2].x, lanes.z);
+		_mm_storeu_ps(&quaternions[3].x, lanes.w);
+	}
+
+	// 内積の符号でq1を反転し、反転後の内積（0以上）を返す
+	__m128 AlignHemisphere(const QuaternionLanes& q0, QuaternionLanes& q1) {
+		__m128 dot = _mm_mul_ps(q0.x, q1.x);
+		dot = MatrixSimd::MulAdd(q0.y, q1.y, dot);
+		dot = MatrixSimd::MulAdd(q0.z, q1.z, dot);
+		dot = MatrixSimd::MulAdd(q0.w, q1.w, dot);
+		__m128 sign = _mm_and_ps(dot, _mm_set1_ps(-0.0f));
+		q1.x = _mm_xor_ps(q1.x, sign);
+		q1.y = _mm_xor_ps(q1.y, sign);
+		q1.z = _mm_xor_ps(q1.z, sign);
+		q1.w = _mm_xor_ps(q1.w, sign);
+		return _mm_xor_ps(dot, sign);
+	}
+
+	// q0 * scale0 + q1 * scale1
+	QuaternionLanes Blend(const QuaternionLanes& q0, __m128 scale0, const QuaternionLanes& q1, __m128 scale1) {
+		return {
+			MatrixSimd::MulAdd(q1.x, scale1, _mm_mul_ps(q0.x, scale0)),
+			MatrixSimd::MulAdd(q1.y, scale1, _mm_mul_ps(q0.y, scale0)),
+			MatrixSimd::MulAdd(q1.z, scale1, _mm_mul_ps(q0.z, scale0)),
+			MatrixSimd::MulAdd(q1.w, scale1, _mm_mul_ps(q0.w, scale0)),
+		};
+	}
+
+	// 4個分の正規化線形補間
+	QuaternionLanes NlerpLanes(const QuaternionLanes& q0, QuaternionLanes q1, __m128 t) {
+		AlignHemisphere(q0, q1);
+		QuaternionLanes result = Blend(q0, _mm_sub_ps(_mm_set1_ps(1.0f), t), q1, t);
+		__m128 normSq = _mm_mul_ps(result.x, result.x);
+		normSq = MatrixSimd::MulAdd(result.y, result.y, normSq);
+		normSq = MatrixSimd::MulAdd(result.z, result.z, normSq);
+		normSq = MatrixSimd::MulAdd(result.w, result.w, normSq);
+		__m128 recpNorm = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(normSq));
+		return {
+			_mm_mul_ps(result.x, recpNorm),
+			_mm_mul_ps(result.y, recpNorm),
+			_mm_mul_ps(result.z, recpNorm),
+			_mm_mul_ps(result.w, recpNorm),
+		};
+	}
+
+	// sin(tθ)/sinθ を cosθ - 1 の多項式で求める
+	__m128 SlerpScale(__m128 t, __m128 cosThetaMinusOne) {
+		__m128 tSq = _mm_mul_ps(t, t);
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 result = one;
+		for (int i = kSlerpTermCount - 1; i >= 0; i--) {
+			__m128 u = _mm_set1_ps(kSlerpCoefficients.u[i]);
+			__m128 v = _mm_set1_ps(kSlerpCoefficients.v[i]);
+			__m128 b = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, tSq), v), cosThetaMinusOne);
+			result = MatrixSimd::MulAdd(b, result, one);
+		}
+		return _mm_mul_ps(t, result);
+	}
+
+	// 4個分の球面線形補間
+	QuaternionLanes SlerpLanes(const QuaternionLanes& q0, QuaternionLanes q1, __m128 t) {
+		__m128 cosThetaMinusOne = _mm_sub_ps(AlignHemisphere(q0, q1), _mm_set1_ps(1.0f));
+		__m128 scale0 = SlerpScale(_mm_sub_ps(_mm_set1_ps(1.0f), t), cosThetaMinusOne);
+		__m128 scale1 = SlerpScale(t, cosThetaMinusOne);
+		return Blend(q0, scale0, q1, scale1);
+	}
+
+	// 4個ずつ処理する（端数は単位クォータニオンで埋めて同じ計算を通す）
+	template<typename LaneFunc>
+	void ForEachLanes(std::span<const Quaternion> q0, std::span<const Quaternion> q1,
+		std::span<const float> t, std::span<Quaternion> out, LaneFunc laneFunc) {
+		size_t count = q0.size();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			StoreLanes(&out[i], laneFunc(LoadLanes(&q0[i]), LoadLanes(&q1[i]), _mm_loadu_ps(&t[i])));
+		}
+		if (i < count) {
+			Quaternion from[4], to[4], result[4];
+			float rate[4] = {};
+			for (size_t lane = 0; lane < 4; lane++) {
+				bool isValid = i + lane < count;
+				from[lane] = isValid ? q0[i + lane] : IdentityQuaternion();
+				to[lane] = isValid ? q1[i + lane] : IdentityQuaternion();
+				rate[lane] = isValid ? t[i + lane] : 0.0f;
+			}
+			StoreLanes(result, laneFunc(LoadLanes(from), LoadLanes(to), _mm_loadu_ps(rate)));
+			std::copy(result, result + (count - i), &out[i]);
+		}
+	}
+#else
+	// sin(tθ)/sinθ を cosθ - 1 の多項式で求める
+	float SlerpScale(float t, float cosThetaMinusOne) {
+		float tSq = t * t;
+		float result = 1.0f;
+		for (int i = kSlerpTermCount - 1; i >= 0; i--) {
+			result = 1.0f + (kSlerpCoefficients.u[i] * tSq - kSlerpCoefficients.v[i]) * cosThetaMinusOne * result;
+		}
+		return t * result;
+	}
+#endif
+}
+
+void NlerpBatch(std::span<const Quaternion> q0, std::span<const Quaternion> q1,
+	std::span<const float> t, std::span<Quaternion> out) {
+	assert(q1.size() == q0.size() && t.size() == q0.size() && out.size() >= q0.size());
+#if defined(MATRIX_SIMD_SSE)
+	ForEachLanes(q0, q1, t, out, NlerpLanes);
+#else
+	for (size_t i = 0; i < q0.size(); i++) {
+		out[i] = Nlerp(q0[i], q1[i], t[i]);
+	}
+#endif
+}
+
+void SlerpBatch(std::span<const Quaternion> q0, std::span<const Quaternion> q1,
+	std::span<const float> t, std::span<Quaternion> out) {
+	assert(q1.size() == q0.size() && t.size() == q0.size() && out.size() >= q0.size());
+#if defined(MATRIX_SIMD_SSE)
+	ForEachLanes(q0, q1, t, out, SlerpLanes);
+#else
+	for (size_t i = 0; i < q0.size(); i++) {
+		// 内積が負なら片方を反転して近い側の経路を通す
+		float dot = Dot(q0[i], q1[i]);
+		float sign = dot < 0.0f ? -1.0f : 1.0f;
+		float scale0 = SlerpScale(1.0f - t[i], dot * sign - 1.0f);
+		float scale1 = SlerpScale(t[i], dot * sign - 1.0f) * sign;
+		out[i] = {
+			scale0 * q0[i].x + scale1 * q1[i].x,
+			scale0 * q0[i].y + scale1 * q1[i].y,
+			scale0 * q0[i].z + scale1 * q1[i].z,
+			scale0 * q0[i].w + scale1 * q1[i].w,
+		};
+	}
+#endif
+}
+#pragma endregion
@@ -0,0 +1,64 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <span>
+
+// クォータニオン（x, y, zが虚部、wが実部）
+struct Quaternion {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+// 単位クォータニオン（回転なし）
+Quaternion IdentityQuaternion();
+
+// 積（rhsの回転を行ったあとにlhsの回転を行う回転）
+// 行列では MakeRotateMatrix(Multiply(lhs, rhs)) == Multiply(MakeRotateMatrix(rhs), MakeRotateMatrix(lhs))
+Quaternion Multiply(const Quaternion& lhs, const Quaternion& rhs);
+
+// 共役クォータニオン
+Quaternion Conjugate(const Quaternion& quaternion);
+
+// 内積
+float Dot(const Quaternion& q0, const Quaternion& q1);
+
+// ノルム
+float Norm(const Quaternion& quaternion);
+
+// 正規化
+Quaternion Normalize(const Quaternion& quaternion);
+
+// 逆クォータニオン
+Quaternion Inverse(const Quaternion& quaternion);
+
+// 任意軸回転（axisは正規化済みであること）
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle);
+
+// オイラー角からの変換（MakeRotateMatrix(const Vector3&)と同じX→Y→Zの順）
+Quaternion MakeRotateQuaternion(const Vector3& rotate);
+
+// 回転行列からの変換（拡大縮小を含まない回転行列であること）
+Quaternion MakeRotateQuaternion(const Matrix4x4& matrix);
+
+// 回転行列への変換（行ベクトル形式）
+Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion);
+
+// ベクトルの回転
+Vector3 RotateVector(const Vector3& vector, const Quaternion& quaternion);
+
+// 正規化線形補間（近い側の経路を通る、結果は正規化済み）
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+// 球面線形補間（近い側の経路を通る）
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+// まとめて正規化線形補間（out[i] = Nlerp(q0[i], q1[i], t[i])）
+void NlerpBatch(std::span<const Quaternion> q0, std::span<const Quaternion> q1,
+	std::span<const float> t, std::span<Quaternion> out);
+
+// まとめて球面線形補間（out[i] = Slerp(q0[i], q1[i], t[i])）
+// 三角関数を使わない多項式近似（Eberlyの方法）で4個ずつSIMDで計算する（Slerpとの差は1e-6未満）
+void SlerpBatch(std::span<const Quaternion> q0, std::span<const Quaternion> q1,
+	std::span<const float> t, std::span<Quaternion> out);
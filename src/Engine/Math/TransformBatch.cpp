@@ -0,0 +1,267 @@
+#include "TransformBatch.h"
+#include "FastMath.h"
+#include "MatrixSimd.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	// 1ブロックで同時に計算する要素数（SSEの1レジスタ分）
+	const uint32_t kBlockSize = 4;
+
+	// 4要素分のトランスフォーム
+	struct TransformBlock {
+		float scaleX[kBlockSize];
+		float scaleY[kBlockSize];
+		float scaleZ[kBlockSize];
+		float rotateX[kBlockSize];
+		float rotateY[kBlockSize];
+		float rotateZ[kBlockSize];
+		float translateX[kBlockSize];
+		float translateY[kBlockSize];
+		float translateZ[kBlockSize];
+
+		// 1要素分の設定
+		void Set(uint32_t lane, const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+			scaleX[lane] = scale.x;
+			scaleY[lane] = scale.y;
+			scaleZ[lane] = scale.z;
+			rotateX[lane] = rotate.x;
+			rotateY[lane] = rotate.y;
+			rotateZ[lane] = rotate.z;
+			translateX[lane] = translate.x;
+			translateY[lane] = translate.y;
+			translateZ[lane] = translate.z;
+		}
+
+		// 端数のブロックの空きレーンを単位トランスフォームで埋める
+		void Pad(uint32_t count) {
+			for (uint32_t lane = count; lane < kBlockSize; lane++) {
+				Set(lane, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f });
+			}
+		}
+	};
+
+	// ブロック内の要素をSoA配列から設定する
+	void LoadBlock(TransformBlock& block, const TransformSoA& transforms, uint32_t index, uint32_t count) {
+		for (uint32_t lane = 0; lane < count; lane++) {
+			uint32_t i = index + lane;
+			block.Set(lane,
+				{ transforms.scaleX[i], transforms.scaleY[i], transforms.scaleZ[i] },
+				{ transforms.rotateX[i], transforms.rotateY[i], transforms.rotateZ[i] },
+				{ transforms.translateX[i], transforms.translateY[i], transforms.translateZ[i] });
+		}
+		block.Pad(count);
+	}
+
+	// ブロック内の要素をAoS配列から設定する
+	void LoadBlock(TransformBlock& block, std::span<const Transform> transforms, uint32_t index, uint32_t count) {
+		for (uint32_t lane = 0; lane < count; lane++) {
+			const Transform& transform = transforms[index + lane];
+			block.Set(lane, transform.scale, transform.rotate, transform.translate);
+		}
+		block.Pad(count);
+	}
+
+#if defined(MATRIX_SIMD_SSE)
+	// 4要素分のWorld行列とWVP行列を計算して、要素ごとにdestination(lane)へ書き込む
+	template<typename Destination>
+	void ComputeBlock(const TransformBlock& block, const Matrix4x4& viewProjection, uint32_t count, Destination destination) {
+		__m128 sx, cx, sy, cy, sz, cz;
+		FastMath::SinCos(_mm_loadu_ps(block.rotateX), sx, cx);
+		FastMath::SinCos(_mm_loadu_ps(block.rotateY), sy, cy);
+		FastMath::SinCos(_mm_loadu_ps(block.rotateZ), sz, cz);
+		__m128 scaleX = _mm_loadu_ps(block.scaleX);
+		__m128 scaleY = _mm_loadu_ps(block.scaleY);
+		__m128 scaleZ = _mm_loadu_ps(block.scaleZ);
+
+		// 回転行列（RotateX * RotateY * RotateZ を展開したもの）にスケールを掛ける
+		__m128 sxsy = _mm_mul_ps(sx, sy);
+		__m128 cxsy = _mm_mul_ps(cx, sy);
+		__m128 world[4][3];
+		world[0][0] = _mm_mul_ps(scaleX, _mm_mul_ps(cy, cz));
+		world[0][1] = _mm_mul_ps(scaleX, _mm_mul_ps(cy, sz));
+		world[0][2] = _mm_mul_ps(scaleX, _mm_sub_ps(_mm_setzero_ps(), sy));
+		world[1][0] = _mm_mul_ps(scaleY, _mm_sub_ps(_mm_mul_ps(sxsy, cz), _mm_mul_ps(cx, sz)));
+		world[1][1] = _mm_mul_ps(scaleY, MatrixSimd::MulAdd(sxsy, sz, _mm_mul_ps(cx, cz)));
+		world[1][2] = _mm_mul_ps(scaleY, _mm_mul_ps(sx, cy));
+		world[2][0] = _mm_mul_ps(scaleZ, MatrixSimd::MulAdd(cxsy, cz, _mm_mul_ps(sx, sz)));
+		world[2][1] = _mm_mul_ps(scaleZ, _mm_sub_ps(_mm_mul_ps(cxsy, sz), _mm_mul_ps(sx, cz)));
+		world[2][2] = _mm_mul_ps(scaleZ, _mm_mul_ps(cx, cy));
+		world[3][0] = _mm_loadu_ps(block.translateX);
+		world[3][1] = _mm_loadu_ps(block.translateY);
+		world[3][2] = _mm_loadu_ps(block.translateZ);
+
+		// WVP[i][j] = Σ World[i][k] * VP[k][j]（4行目は平行移動なのでVP[3][j]を足す）
+		__m128 wvp[4][4];
+		for (int j = 0; j < 4; j++) {
+			__m128 vp0 = _mm_set1_ps(viewProjection.m[0][j]);
+			__m128 vp1 = _mm_set1_ps(viewProjection.m[1][j]);
+			__m128 vp2 = _mm_set1_ps(viewProjection.m[2][j]);
+			for (int i = 0; i < 4; i++) {
+				__m128 value = i == 3 ? _mm_set1_ps(viewProjection.m[3][j]) : _mm_setzero_ps();
+				value = MatrixSimd::MulAdd(world[i][0], vp0, value);
+				value = MatrixSimd::MulAdd(world[i][1], vp1, value);
+				value = MatrixSimd::MulAdd(world[i][2], vp2, value);
+				wvp[i][j] = value;
+			}
+		}
+
+		// 要素ごとの行に並べ替える（TransformationMatrixと同じWVP→Worldの順）
+		__m128 rows[8][kBlockSize];
+		for (int i = 0; i < 4; i++) {
+			__m128 r0 = wvp[i][0];
+			__m128 r1 = wvp[i][1];
+			__m128 r2 = wvp[i][2];
+			__m128 r3 = wvp[i][3];
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			rows[i][0] = r0;
+			rows[i][1] = r1;
+			rows[i][2] = r2;
+			rows[i][3] = r3;
+		}
+		for (int i = 0; i < 4; i++) {
+			__m128 r0 = world[i][0];
+			__m128 r1 = world[i][1];
+			__m128 r2 = world[i][2];
+			__m128 r3 = i == 3 ? _mm_set1_ps(1.0f) : _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			rows[4 + i][0] = r0;
+			rows[4 + i][1] = r1;
+			rows[4 + i][2] = r2;
+			rows[4 + i][3] = r3;
+		}
+
+		// 1要素分（128バイト）を先頭から順に書き込む（書き込み結合メモリでも効率が落ちない）
+		for (uint32_t lane = 0; lane < count; lane++) {
+			float* dst = reinterpret_cast<float*>(destination(lane));
+			for (int row = 0; row < 8; row++) {
+				_mm_storeu_ps(dst + row * 4, rows[row][lane]);
+			}
+		}
+	}
+#else
+	// 4要素分のWorld行列とWVP行列を計算して、要素ごとにdestination(lane)へ書き込む
+	template<typename Destination>
+	void ComputeBlock(const TransformBlock& block, const Matrix4x4& viewProjection, uint32_t count, Destination destination) {
+		for (uint32_t lane = 0; lane < count; lane++) {
+			float sx, cx, sy, cy, sz, cz;
+			FastMath::SinCos(block.rotateX[lane], sx, cx);
+			FastMath::SinCos(block.rotateY[lane], sy, cy);
+			FastMath::SinCos(block.rotateZ[lane], sz, cz);
+
+			// 回転行列（RotateX * RotateY * RotateZ を展開したもの）にスケールを掛ける
+			Matrix4x4 world;
+			world.m[0][0] = block.scaleX[lane] * (cy * cz);
+			world.m[0][1] = block.scaleX[lane] * (cy * sz);
+			world.m[0][2] = block.scaleX[lane] * -sy;
+			world.m[0][3] = 0.0f;
+			world.m[1][0] = block.scaleY[lane] * (sx * sy * cz - cx * sz);
+			world.m[1][1] = block.scaleY[lane] * (sx * sy * sz + cx * cz);
+			world.m[1][2] = block.scaleY[lane] * (sx * cy);
+			world.m[1][3] = 0.0f;
+			world.m[2][0] = block.scaleZ[lane] * (cx * sy * cz + sx * sz);
+			world.m[2][1] = block.scaleZ[lane] * (cx * sy * sz - sx * cz);
+			world.m[2][2] = block.scaleZ[lane] * (cx * cy);
+			world.m[2][3] = 0.0f;
+			world.m[3][0] = block.translateX[lane];
+			world.m[3][1] = block.translateY[lane];
+			world.m[3][2] = block.translateZ[lane];
+			world.m[3][3] = 1.0f;
+
+			TransformationMatrix* dst = destination(lane);
+			dst->WVP = Multiply(world, viewProjection);
+			dst->World = world;
+		}
+	}
+#endif
+
+	// [begin, end)の範囲をブロック単位で計算する
+	template<typename Source, typename Destination>
+	void ComputeRange(const Source& source, const Matrix4x4& viewProjection, uint32_t begin, uint32_t end, Destination destination) {
+		TransformBlock block;
+		for (uint32_t index = begin; index < end; index += kBlockSize) {
+			uint32_t count = (std::min)(kBlockSize, end - index);
+			LoadBlock(block, source, index, count);
+			ComputeBlock(block, viewProjection, count, [&](uint32_t lane) { return destination(index + lane); });
+		}
+	}
+
+	// 全範囲を計算する（要素数がgrainSizeを超えていればJobSystemで分割する）
+	template<typename Source, typename Destination>
+	void ComputeAll(const Source& source, uint32_t count, const Matrix4x4& viewProjection, uint32_t grainSize, Destination destination) {
+		if (grainSize == 0 || count <= grainSize) {
+			ComputeRange(source, viewProjection, 0, count, destination);
+			return;
+		}
+		JobSystem::GetInstance()->ParallelFor(0, count, grainSize, [&](uint32_t begin, uint32_t end) {
+			ComputeRange(source, viewProjection, begin, end, destination);
+		});
+	}
+}
+
+#pragma region SoA配列
+void TransformSoA::Resize(uint32_t count) {
+	std::vector<float>* columns[] = {
+		&scaleX, &scaleY, &scaleZ,
+		&rotateX, &rotateY, &rotateZ,
+		&translateX, &translateY, &translateZ,
+	};
+	for (std::vector<float>* column : columns) {
+		column->resize(count);
+	}
+}
+
+uint32_t TransformSoA::Add(const Transform& transform) {
+	uint32_t index = Size();
+	Resize(index + 1);
+	Set(index, transform);
+	return index;
+}
+
+void TransformSoA::Set(uint32_t index, const Transform& transform) {
+	assert(index < Size());
+	scaleX[index] = transform.scale.x;
+	scaleY[index] = transform.scale.y;
+	scaleZ[index] = transform.scale.z;
+	rotateX[index] = transform.rotate.x;
+	rotateY[index] = transform.rotate.y;
+	rotateZ[index] = transform.rotate.z;
+	translateX[index] = transform.translate.x;
+	translateY[index] = transform.translate.y;
+	translateZ[index] = transform.translate.z;
+}
+
+Transform TransformSoA::Get(uint32_t index) const {
+	assert(index < Size());
+	Transform transform;
+	transform.scale = { scaleX[index], scaleY[index], scaleZ[index] };
+	transform.rotate = { rotateX[index], rotateY[index], rotateZ[index] };
+	transform.translate = { translateX[index], translateY[index], translateZ[index] };
+	return transform;
+}
+#pragma endregion
+
+#pragma region 一括計算
+void ComputeWorldWVP(const TransformSoA& transforms, const Matrix4x4& viewProjection,
+	std::span<TransformationMatrix> out, uint32_t grainSize) {
+	assert(out.size() >= transforms.Size());
+	ComputeAll(transforms, transforms.Size(), viewProjection, grainSize,
+		[out](uint32_t index) { return &out[index]; });
+}
+
+void ComputeWorldWVP(const TransformSoA& transforms, const Matrix4x4& viewProjection,
+	std::span<TransformationMatrix* const> out, uint32_t grainSize) {
+	assert(out.size() >= transforms.Size());
+	ComputeAll(transforms, transforms.Size(), viewProjection, grainSize,
+		[out](uint32_t index) { return out[index]; });
+}
+
+void ComputeWorldWVP(std::span<const Transform> transforms, const Matrix4x4& viewProjection,
+	std::span<TransformationMatrix> out, uint32_t grainSize) {
+	assert(out.size() >= transforms.size());
+	ComputeAll(transforms, static_cast<uint32_t>(transforms.size()), viewProjection, grainSize,
+		[out](uint32_t index) { return &out[index]; });
+}
+#pragma endregion
@@ -0,0 +1,57 @@
+#pragma once
+#include "Mymath.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// トランスフォームの配列（要素ごとに連続した配列で保持するSoA形式）
+struct TransformSoA {
+	// スケール
+	std::vector<float> scaleX;
+	std::vector<float> scaleY;
+	std::vector<float> scaleZ;
+	// 回転
+	std::vector<float> rotateX;
+	std::vector<float> rotateY;
+	std::vector<float> rotateZ;
+	// 平行移動
+	std::vector<float> translateX;
+	std::vector<float> translateY;
+	std::vector<float> translateZ;
+
+	// 要素数の取得
+	uint32_t Size() const { return static_cast<uint32_t>(scaleX.size()); }
+
+	// 要素数の変更
+	void Resize(uint32_t count);
+
+	// 全要素の削除
+	void Clear() { Resize(0); }
+
+	// 末尾に追加（追加先のインデックスを返す）
+	uint32_t Add(const Transform& transform);
+
+	// 指定位置の書き換え
+	void Set(uint32_t index, const Transform& transform);
+
+	// 指定位置の取得
+	Transform Get(uint32_t index) const;
+};
+
+// 1ジョブあたりの既定の要素数（これ以下なら呼び出したスレッドだけで計算する）
+static const uint32_t kTransformBatchGrainSize = 512;
+
+// World行列とWVP行列をまとめて計算する
+// World = Scale * Rotate(X*Y*Z) * Translate、WVP = World * viewProjection で、MakeAffineMatrixと同じ規約
+// 4個ずつSIMDで計算し、要素数がgrainSizeを超えればJobSystemで分割して並列に処理する（0なら分割しない）
+// 出力は1要素ずつ先頭から連続して書き込むだけで読み戻さないので、Map済みのアップロードバッファに直接書いてよい
+void ComputeWorldWVP(const TransformSoA& transforms, const Matrix4x4& viewProjection,
+	std::span<TransformationMatrix> out, uint32_t grainSize = kTransformBatchGrainSize);
+
+// 出力先が要素ごとに別々のバッファにある場合（Object3dごとの定数バッファなど）
+void ComputeWorldWVP(const TransformSoA& transforms, const Matrix4x4& viewProjection,
+	std::span<TransformationMatrix* const> out, uint32_t grainSize = kTransformBatchGrainSize);
+
+// AoSのトランスフォーム配列から計算する（4個ずつSoAに並べ替えてから計算する）
+void ComputeWorldWVP(std::span<const Transform> transforms, const Matrix4x4& viewProjection,
+	std::span<TransformationMatrix> out, uint32_t grainSize = kTransformBatchGrainSize);
@@ -0,0 +1,56 @@
+#include "TransformComponent.h"
+
+namespace
+{
+	// 全要素が一致するか
+	bool IsSame(const Vector3& a, const Vector3& b) {
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+}
+
+TransformComponent::TransformComponent() {
+	transform_.scale = { 1.0f, 1.0f, 1.0f };
+	transform_.rotate = { 0.0f, 0.0f, 0.0f };
+	transform_.translate = { 0.0f, 0.0f, 0.0f };
+	worldMatrix_ = MakeIdentity4x4();
+}
+
+void TransformComponent::SetScale(const Vector3& scale) {
+	if (!IsSame(transform_.scale, scale)) {
+		transform_.scale = scale;
+		MarkDirty();
+	}
+}
+
+void TransformComponent::SetRotate(const Vector3& rotate) {
+	if (!IsSame(transform_.rotate, rotate)) {
+		transform_.rotate = rotate;
+		MarkDirty();
+	}
+}
+
+void TransformComponent::SetTranslate(const Vector3& translate) {
+	if (!IsSame(transform_.translate, translate)) {
+		transform_.translate = translate;
+		MarkDirty();
+	}
+}
+
+void TransformComponent::SetTransform(const Transform& transform) {
+	SetScale(transform.scale);
+	SetRotate(transform.rotate);
+	SetTranslate(transform.translate);
+}
+
+const Matrix4x4& TransformComponent::GetWorldMatrix() {
+	if (isDirty_) {
+		worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+		isDirty_ = false;
+	}
+	return worldMatrix_;
+}
+
+void TransformComponent::MarkDirty() {
+	isDirty_ = true;
+	++version_;
+}
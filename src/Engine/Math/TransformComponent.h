@@ -0,0 +1,49 @@
+#pragma once
+#include "Mymath.h"
+#include <cstdint>
+
+// 変更があったときだけワールド行列を作り直すトランスフォーム
+// 値の変更で更新番号が進むので、利用側は前回の番号と比べれば変化の有無がわかる
+class TransformComponent {
+public:
+	// コンストラクタ（スケール1、回転0、平行移動0）
+	TransformComponent();
+
+	// スケールの設定・取得
+	void SetScale(const Vector3& scale);
+	const Vector3& GetScale() const { return transform_.scale; }
+
+	// 回転の設定・取得
+	void SetRotate(const Vector3& rotate);
+	const Vector3& GetRotate() const { return transform_.rotate; }
+
+	// 平行移動の設定・取得
+	void SetTranslate(const Vector3& translate);
+	const Vector3& GetTranslate() const { return transform_.translate; }
+
+	// まとめて設定・取得
+	void SetTransform(const Transform& transform);
+	const Transform& GetTransform() const { return transform_; }
+
+	// ワールド行列の取得（変更があれば作り直す）
+	const Matrix4x4& GetWorldMatrix();
+
+	// ワールド行列の作り直しが必要か
+	bool IsDirty() const { return isDirty_; }
+
+	// 更新番号（値が変わるたびに1進む）
+	uint32_t GetVersion() const { return version_; }
+
+private:
+	// 値が変わったときの処理
+	void MarkDirty();
+
+	// トランスフォーム
+	Transform transform_;
+	// ワールド行列（isDirty_がfalseの間は最新）
+	Matrix4x4 worldMatrix_;
+	// ワールド行列の作り直しが必要か
+	bool isDirty_ = true;
+	// 更新番号
+	uint32_t version_ = 0;
+};
@@ -0,0 +1,329 @@
+#include "TriangleMesh.h"
+#include "MatrixSimd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+	// レイと三角形が平行とみなす行列式の大きさ
+	const float kParallelEpsilon = 1e-12f;
+	// パケット探索用スタックの大きさ（BVHの深さの上限より大きくする）
+	const uint32_t kPacketStackSize = 64;
+
+	float GetAxis(const Vector3& v, uint32_t axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+}
+
+#pragma region 構築
+void TriangleMesh::Build(std::span<const Vector3> positions) {
+	Clear();
+
+	uint32_t triangleCount = static_cast<uint32_t>(positions.size() / 3);
+	triangles_.resize(triangleCount);
+	std::vector<AABB> triangleBounds(triangleCount);
+	for (uint32_t i = 0; i < triangleCount; ++i) {
+		const Vector3& p0 = positions[i * 3];
+		const Vector3& p1 = positions[i * 3 + 1];
+		const Vector3& p2 = positions[i * 3 + 2];
+		triangles_[i].v0 = p0;
+		triangles_[i].edge1 = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+		triangles_[i].edge2 = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+
+		triangleBounds[i] = MakeEmptyAABB();
+		ExpandAABB(triangleBounds[i], p0);
+		ExpandAABB(triangleBounds[i], p1);
+		ExpandAABB(triangleBounds[i], p2);
+	}
+	bvh_.Build(triangleBounds);
+}
+
+void TriangleMesh::Clear() {
+	triangles_.clear();
+	bvh_.Clear();
+}
+#pragma endregion
+
+#pragma region 1本ずつの判定
+bool TriangleMesh::IntersectTriangle(const Triangle& triangle, const Ray& ray, float maxDistance, float& outDistance, float& outU, float& outV) {
+	// Möller–Trumbore法（交点を v0 + u*edge1 + v*edge2 = origin + t*direction として連立方程式をクラメルの公式で解く）
+	const Vector3& d = ray.direction;
+	const Vector3& e1 = triangle.edge1;
+	const Vector3& e2 = triangle.edge2;
+
+	Vector3 p = { d.y * e2.z - d.z * e2.y, d.z * e2.x - d.x * e2.z, d.x * e2.y - d.y * e2.x };
+	float det = e1.x * p.x + e1.y * p.y + e1.z * p.z;
+	if (std::fabs(det) <= kParallelEpsilon) {
+		return false;
+	}
+	float inverseDet = 1.0f / det;
+
+	Vector3 s = { ray.origin.x - triangle.v0.x, ray.origin.y - triangle.v0.y, ray.origin.z - triangle.v0.z };
+	float u = (s.x * p.x + s.y * p.y + s.z * p.z) * inverseDet;
+	if (u < 0.0f || u > 1.0f) {
+		return false;
+	}
+
+	Vector3 q = { s.y * e1.z - s.z * e1.y, s.z * e1.x - s.x * e1.z, s.x * e1.y - s.y * e1.x };
+	float v = (d.x * q.x + d.y * q.y + d.z * q.z) * inverseDet;
+	if (v < 0.0f || u + v > 1.0f) {
+		return false;
+	}
+
+	float t = (e2.x * q.x + e2.y * q.y + e2.z * q.z) * inverseDet;
+	if (t < 0.0f || t > maxDistance) {
+		return false;
+	}
+	outDistance = t;
+	outU = u;
+	outV = v;
+	return true;
+}
+
+bool TriangleMesh::Raycast(const Ray& ray, float maxDistance, MeshRayHit& hit) const {
+	hit = { kNoHit, maxDistance, 0.0f, 0.0f };
+
+	// IntersectTriangleはitemMaxDistance以内のときだけtrueを返して重心座標を書き込むので、
+	// 最後に書き込まれた値がBVHの採用した三角形のものになる
+	float u = 0.0f;
+	float v = 0.0f;
+	BvhRayHit bvhHit;
+	bool isHit = bvh_.Raycast(ray, maxDistance, bvhHit,
+		[&](uint32_t item, const Ray& itemRay, float itemMaxDistance, float& outDistance) {
+			return IntersectTriangle(triangles_[item], itemRay, itemMaxDistance, outDistance, u, v);
+		});
+	if (!isHit) {
+		return false;
+	}
+	hit = { bvhHit.item, bvhHit.distance, u, v };
+	return true;
+}
+
+bool TriangleMesh::RaycastAny(const Ray& ray, float maxDistance) const {
+	return bvh_.RaycastAny(ray, maxDistance,
+		[&](uint32_t item, const Ray& itemRay, float itemMaxDistance, float& outDistance) {
+			float u, v;
+			return IntersectTriangle(triangles_[item], itemRay, itemMaxDistance, outDistance, u, v);
+		});
+}
+#pragma endregion
+
+#pragma region パケットでの判定
+uint32_t TriangleMesh::RaycastPacket(std::span<const Ray> rays, float maxDistance, std::span<MeshRayHit> hits) const {
+	assert(hits.size() >= rays.size());
+
+	uint32_t rayCount = static_cast<uint32_t>(rays.size());
+	uint32_t hitCount = 0;
+	for (uint32_t i = 0; i < rayCount; i += 4) {
+		uint32_t packetCount = (std::min)(rayCount - i, 4u);
+		RaycastPacket4(&rays[i], packetCount, maxDistance, false, &hits[i]);
+		for (uint32_t lane = 0; lane < packetCount; ++lane) {
+			hitCount += hits[i + lane].triangle != kNoHit ? 1 : 0;
+		}
+	}
+	return hitCount;
+}
+
+uint32_t TriangleMesh::RaycastAnyPacket(std::span<const Ray> rays, float maxDistance, std::span<bool> isHits) const {
+	assert(isHits.size() >= rays.size());
+
+	uint32_t rayCount = static_cast<uint32_t>(rays.size());
+	uint32_t hitCount = 0;
+	MeshRayHit hits[4];
+	for (uint32_t i = 0; i < rayCount; i += 4) {
+		uint32_t packetCount = (std::min)(rayCount - i, 4u);
+		RaycastPacket4(&rays[i], packetCount, maxDistance, true, hits);
+		for (uint32_t lane = 0; lane < packetCount; ++lane) {
+			isHits[i + lane] = hits[lane].triangle != kNoHit;
+			hitCount += isHits[i + lane] ? 1 : 0;
+		}
+	}
+	return hitCount;
+}
+
+void TriangleMesh::RaycastPacket4(const Ray* rays, uint32_t rayCount, float maxDistance, bool isAnyHit, MeshRayHit* hits) const {
+	assert(rayCount <= 4);
+	for (uint32_t lane = 0; lane < rayCount; ++lane) {
+		hits[lane] = { kNoHit, maxDistance, 0.0f, 0.0f };
+	}
+	if (triangles_.empty()) {
+		return;
+	}
+
+#if defined(MATRIX_SIMD_SSE)
+	using MatrixSimd::MulAdd;
+
+	// レイを4本分のレーンに並べる（足りないレーンは1本目を複製して無効にしておく）
+	alignas(16) float lanes[7][4];
+	for (uint32_t lane = 0; lane < 4; ++lane) {
+		const Ray& ray = rays[lane < rayCount ? lane : 0];
+		lanes[0][lane] = ray.origin.x;
+		lanes[1][lane] = ray.origin.y;
+		lanes[2][lane] = ray.origin.z;
+		lanes[3][lane] = ray.direction.x;
+		lanes[4][lane] = ray.direction.y;
+		lanes[5][lane] = ray.direction.z;
+		lanes[6][lane] = lane < rayCount ? maxDistance : -1.0f;
+	}
+	const __m128 originX = _mm_load_ps(lanes[0]);
+	const __m128 originY = _mm_load_ps(lanes[1]);
+	const __m128 originZ = _mm_load_ps(lanes[2]);
+	const __m128 directionX = _mm_load_ps(lanes[3]);
+	const __m128 directionY = _mm_load_ps(lanes[4]);
+	const __m128 directionZ = _mm_load_ps(lanes[5]);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 inverseX = _mm_div_ps(one, directionX);
+	const __m128 inverseY = _mm_div_ps(one, directionY);
+	const __m128 inverseZ = _mm_div_ps(one, directionZ);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 parallelEpsilon = _mm_set1_ps(kParallelEpsilon);
+
+	// 各レーンの探索範囲（当たるたびに縮める）と、まだ探索中かどうか
+	__m128 tMax = _mm_load_ps(lanes[6]);
+	__m128 active = _mm_cmpge_ps(tMax, zero);
+	__m128 hitTriangle = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(kNoHit)));
+	__m128 hitU = zero;
+	__m128 hitV = zero;
+
+	// maskの立っているレーンだけaをbで置き換える
+	auto select = [](__m128 mask, __m128 a, __m128 b) {
+		return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+	};
+
+	std::span<const BoundingVolumeHierarchy::Node> nodes = bvh_.GetNodes();
+	std::span<const uint32_t> leafItems = bvh_.GetLeafItems();
+	uint32_t stack[kPacketStackSize];
+	uint32_t stackCount = 0;
+	stack[stackCount++] = 0;
+
+	while (stackCount > 0) {
+		uint32_t nodeIndex = stack[--stackCount];
+		const BoundingVolumeHierarchy::Node& node = nodes[nodeIndex];
+
+		// 4本のレイとノードのAABBをスラブ法で判定
+		__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.bounds.min.x), originX), inverseX);
+		__m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.bounds.max.x), originX), inverseX);
+		__m128 tEnter = _mm_min_ps(t1, t2);
+		__m128 tExit = _mm_max_ps(t1, t2);
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.bounds.min.y), originY), inverseY);
+		t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.bounds.max.y), originY), inverseY);
+		tEnter = _mm_max_ps(tEnter, _mm_min_ps(t1, t2));
+		tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.bounds.min.z), originZ), inverseZ);
+		t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.bounds.max.z), originZ), inverseZ);
+		tEnter = _mm_max_ps(_mm_max_ps(tEnter, _mm_min_ps(t1, t2)), zero);
+		tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+		__m128 nodeMask = _mm_and_ps(active, _mm_and_ps(_mm_cmple_ps(tEnter, tExit), _mm_cmple_ps(tEnter, tMax)));
+		int nodeBits = _mm_movemask_ps(nodeMask);
+		if (nodeBits == 0) {
+			continue;
+		}
+
+		if (!node.IsLeaf()) {
+			// 子の中心が最も離れている軸で、最初の有効なレイの進む向きに近い子を先に調べる
+			uint32_t left = nodeIndex + 1;
+			uint32_t right = node.offset;
+			Vector3 leftCenter = GetAABBCenter(nodes[left].bounds);
+			Vector3 rightCenter = GetAABBCenter(nodes[right].bounds);
+			Vector3 delta = { rightCenter.x - leftCenter.x, rightCenter.y - leftCenter.y, rightCenter.z - leftCenter.z };
+			uint32_t axis = 0;
+			if (std::fabs(delta.y) > std::fabs(GetAxis(delta, axis))) {
+				axis = 1;
+			}
+			if (std::fabs(delta.z) > std::fabs(GetAxis(delta, axis))) {
+				axis = 2;
+			}
+			uint32_t firstLane = 0;
+			while (!(nodeBits & (1 << firstLane))) {
+				++firstLane;
+			}
+			bool isLeftNear = GetAxis(delta, axis) * lanes[3 + axis][firstLane] >= 0.0f;
+			stack[stackCount++] = isLeftNear ? right : left;
+			stack[stackCount++] = isLeftNear ? left : right;
+			continue;
+		}
+
+		// 葉の三角形ごとに、4本のレイとMöller–Trumbore法で判定
+		for (uint32_t i = 0; i < node.count; ++i) {
+			uint32_t item = leafItems[node.offset + i];
+			const Triangle& triangle = triangles_[item];
+			__m128 e1x = _mm_set1_ps(triangle.edge1.x);
+			__m128 e1y = _mm_set1_ps(triangle.edge1.y);
+			__m128 e1z = _mm_set1_ps(triangle.edge1.z);
+			__m128 e2x = _mm_set1_ps(triangle.edge2.x);
+			__m128 e2y = _mm_set1_ps(triangle.edge2.y);
+			__m128 e2z = _mm_set1_ps(triangle.edge2.z);
+
+			// p = direction × edge2、det = edge1・p
+			__m128 px = _mm_sub_ps(_mm_mul_ps(directionY, e2z), _mm_mul_ps(directionZ, e2y));
+			__m128 py = _mm_sub_ps(_mm_mul_ps(directionZ, e2x), _mm_mul_ps(directionX, e2z));
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(directionX, e2y), _mm_mul_ps(directionY, e2x));
+			__m128 det = MulAdd(e1z, pz, MulAdd(e1y, py, _mm_mul_ps(e1x, px)));
+			__m128 inverseDet = _mm_div_ps(one, det);
+
+			// s = origin - v0、u = s・p / det
+			__m128 sx = _mm_sub_ps(originX, _mm_set1_ps(triangle.v0.x));
+			__m128 sy = _mm_sub_ps(originY, _mm_set1_ps(triangle.v0.y));
+			__m128 sz = _mm_sub_ps(originZ, _mm_set1_ps(triangle.v0.z));
+			__m128 u = _mm_mul_ps(MulAdd(sz, pz, MulAdd(sy, py, _mm_mul_ps(sx, px))), inverseDet);
+
+			// q = s × edge1、v = direction・q / det、t = edge2・q / det
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+			__m128 v = _mm_mul_ps(MulAdd(directionZ, qz, MulAdd(directionY, qy, _mm_mul_ps(directionX, qx))), inverseDet);
+			__m128 t = _mm_mul_ps(MulAdd(e2z, qz, MulAdd(e2y, qy, _mm_mul_ps(e2x, qx))), inverseDet);
+
+			__m128 hit = _mm_and_ps(nodeMask, _mm_cmpgt_ps(_mm_andnot_ps(signMask, det), parallelEpsilon));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+			hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, tMax)));
+			if (_mm_movemask_ps(hit) == 0) {
+				continue;
+			}
+
+			tMax = select(hit, tMax, t);
+			hitTriangle = select(hit, hitTriangle, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(item))));
+			hitU = select(hit, hitU, u);
+			hitV = select(hit, hitV, v);
+
+			if (isAnyHit) {
+				// 当たったレイは探索を終える
+				active = _mm_andnot_ps(hit, active);
+				nodeMask = _mm_andnot_ps(hit, nodeMask);
+			}
+		}
+		if (_mm_movemask_ps(active) == 0) {
+			break;
+		}
+	}
+
+	alignas(16) float resultDistance[4];
+	alignas(16) uint32_t resultTriangle[4];
+	alignas(16) float resultU[4];
+	alignas(16) float resultV[4];
+	_mm_store_ps(resultDistance, tMax);
+	_mm_store_ps(reinterpret_cast<float*>(resultTriangle), hitTriangle);
+	_mm_store_ps(resultU, hitU);
+	_mm_store_ps(resultV, hitV);
+	for (uint32_t lane = 0; lane < rayCount; ++lane) {
+		if (resultTriangle[lane] != kNoHit) {
+			hits[lane] = { resultTriangle[lane], resultDistance[lane], resultU[lane], resultV[lane] };
+		}
+	}
+#else
+	// SIMDが使えない環境では1本ずつ判定する
+	for (uint32_t lane = 0; lane < rayCount; ++lane) {
+		if (isAnyHit) {
+			// 遮蔽判定では当たった三角形は使わないので、外れでないことだけを記録する
+			if (RaycastAny(rays[lane], maxDistance)) {
+				hits[lane].triangle = 0;
+			}
+		} else {
+			Raycast(rays[lane], maxDistance, hits[lane]);
+		}
+	}
+#endif
+}
+#pragma endregion
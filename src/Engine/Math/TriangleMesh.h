@@ -0,0 +1,71 @@
+#pragma once
+#include "BoundingVolumeHierarchy.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// 三角形メッシュへのレイキャストの結果
+struct MeshRayHit {
+	// 当たった三角形の番号（頂点配列の3頂点ごとの番号）、外れたらTriangleMesh::kNoHit
+	uint32_t triangle;
+	// 始点からの距離（方向ベクトルを単位とした長さ）
+	float distance;
+	// 重心座標（交点 = (1-u-v)*v0 + u*v1 + v*v2）
+	float u;
+	float v;
+};
+
+// レイキャスト用の三角形メッシュ（CPUだけで判定する）
+// 三角形ごとのAABBでBVHを作り、レイと三角形の交差はMöller–Trumbore法で求める
+// 裏面も当たりとして扱う
+class TriangleMesh {
+public:
+	// 外れを表す三角形番号
+	static const uint32_t kNoHit = UINT32_MAX;
+
+	// 構築（3頂点ずつで1つの三角形とする三角形リスト）
+	void Build(std::span<const Vector3> positions);
+
+	// 全削除
+	void Clear();
+
+	// 最も近い交点を求める
+	bool Raycast(const Ray& ray, float maxDistance, MeshRayHit& hit) const;
+
+	// maxDistance以内に交点が1つでもあるか（視線や射線の遮蔽判定用、見つかった時点で打ち切る）
+	bool RaycastAny(const Ray& ray, float maxDistance) const;
+
+	// 複数のレイの最も近い交点をまとめて求める（4本ずつSIMDで同時にBVHをたどる）
+	// 並んだ4本が同じ向きに近いほど速い（画面の隣り合うピクセルのレイなど）。向きがばらばらならRaycastの方が速い
+	// hitsはraysと同じ数以上の領域が必要。当たった数を返す
+	uint32_t RaycastPacket(std::span<const Ray> rays, float maxDistance, std::span<MeshRayHit> hits) const;
+
+	// 複数のレイの遮蔽判定をまとめて行う（isHitsはraysと同じ数以上の領域が必要、当たった数を返す）
+	uint32_t RaycastAnyPacket(std::span<const Ray> rays, float maxDistance, std::span<bool> isHits) const;
+
+	// 三角形数の取得
+	uint32_t GetTriangleCount() const { return static_cast<uint32_t>(triangles_.size()); }
+
+	// BVHの取得
+	const BoundingVolumeHierarchy& GetBvh() const { return bvh_; }
+
+private:
+	// 交差判定用に前計算した三角形（1頂点と、そこから残り2頂点への辺）
+	struct Triangle {
+		Vector3 v0;
+		Vector3 edge1;
+		Vector3 edge2;
+	};
+
+	// 1本のレイと三角形の交差（maxDistance以内で当たればtrue）
+	static bool IntersectTriangle(const Triangle& triangle, const Ray& ray, float maxDistance, float& outDistance, float& outU, float& outV);
+
+	// 4本以下のレイをまとめて判定する（isAnyHitなら当たった時点でそのレイの探索をやめる）
+	void RaycastPacket4(const Ray* rays, uint32_t rayCount, float maxDistance, bool isAnyHit, MeshRayHit* hits) const;
+
+	// 三角形の配列
+	std::vector<Triangle> triangles_;
+	// 三角形のBVH
+	BoundingVolumeHierarchy bvh_;
+};
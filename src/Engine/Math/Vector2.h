@@ -3,4 +3,18 @@ struct Vector2
 {
     float x;
     float y;
-};
\ No newline at end of file
+
+    constexpr bool operator==(const Vector2&) const = default;
+};
+
+// 演算子（定数の計算はコンパイル時に畳み込まれ、実行時も呼び出し先でインライン展開されるようヘッダーで定義する）
+constexpr Vector2 operator+(const Vector2& v1, const Vector2& v2) { return { v1.x + v2.x, v1.y + v2.y }; }
+constexpr Vector2 operator-(const Vector2& v1, const Vector2& v2) { return { v1.x - v2.x, v1.y - v2.y }; }
+constexpr Vector2 operator-(const Vector2& v) { return { -v.x, -v.y }; }
+constexpr Vector2 operator*(const Vector2& v, float s) { return { v.x * s, v.y * s }; }
+constexpr Vector2 operator*(float s, const Vector2& v) { return { s * v.x, s * v.y }; }
+constexpr Vector2 operator/(const Vector2& v, float s) { return { v.x / s, v.y / s }; }
+constexpr Vector2& operator+=(Vector2& v1, const Vector2& v2) { v1.x += v2.x; v1.y += v2.y; return v1; }
+constexpr Vector2& operator-=(Vector2& v1, const Vector2& v2) { v1.x -= v2.x; v1.y -= v2.y; return v1; }
+constexpr Vector2& operator*=(Vector2& v, float s) { v.x *= s; v.y *= s; return v; }
+constexpr Vector2& operator/=(Vector2& v, float s) { v.x /= s; v.y /= s; return v; }
\ No newline at end of file
@@ -4,4 +4,26 @@ struct Vector3
     float x;
     float y;
     float z;
-};
\ No newline at end of file
+
+    constexpr bool operator==(const Vector3&) const = default;
+};
+
+// 演算子（定数の計算はコンパイル時に畳み込まれ、実行時も呼び出し先でインライン展開されるようヘッダーで定義する）
+constexpr Vector3 operator+(const Vector3& v1, const Vector3& v2) { return { v1.x + v2.x, v1.y + v2.y, v1.z + v2.z }; }
+constexpr Vector3 operator-(const Vector3& v1, const Vector3& v2) { return { v1.x - v2.x, v1.y - v2.y, v1.z - v2.z }; }
+constexpr Vector3 operator-(const Vector3& v) { return { -v.x, -v.y, -v.z }; }
+constexpr Vector3 operator*(const Vector3& v, float s) { return { v.x * s, v.y * s, v.z * s }; }
+constexpr Vector3 operator*(float s, const Vector3& v) { return { s * v.x, s * v.y, s * v.z }; }
+constexpr Vector3 operator/(const Vector3& v, float s) { return { v.x / s, v.y / s, v.z / s }; }
+constexpr Vector3& operator+=(Vector3& v1, const Vector3& v2) { v1.x += v2.x; v1.y += v2.y; v1.z += v2.z; return v1; }
+constexpr Vector3& operator-=(Vector3& v1, const Vector3& v2) { v1.x -= v2.x; v1.y -= v2.y; v1.z -= v2.z; return v1; }
+constexpr Vector3& operator*=(Vector3& v, float s) { v.x *= s; v.y *= s; v.z *= s; return v; }
+constexpr Vector3& operator/=(Vector3& v, float s) { v.x /= s; v.y /= s; v.z /= s; return v; }
+
+// 内積
+constexpr float Dot(const Vector3& v1, const Vector3& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+
+// 外積
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) {
+    return { v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x };
+}
\ No newline at end of file
@@ -5,4 +5,16 @@ struct Vector4
     float y;
     float z;
     float w;
-};
\ No newline at end of file
+
+    constexpr bool operator==(const Vector4&) const = default;
+};
+
+// 演算子（定数の計算はコンパイル時に畳み込まれ、実行時も呼び出し先でインライン展開されるようヘッダーで定義する）
+constexpr Vector4 operator+(const Vector4& v1, const Vector4& v2) { return { v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w }; }
+constexpr Vector4 operator-(const Vector4& v1, const Vector4& v2) { return { v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w }; }
+constexpr Vector4 operator-(const Vector4& v) { return { -v.x, -v.y, -v.z, -v.w }; }
+constexpr Vector4 operator*(const Vector4& v, float s) { return { v.x * s, v.y * s, v.z * s, v.w * s }; }
+constexpr Vector4 operator*(float s, const Vector4& v) { return { s * v.x, s * v.y, s * v.z, s * v.w }; }
+constexpr Vector4& operator+=(Vector4& v1, const Vector4& v2) { v1.x += v2.x; v1.y += v2.y; v1.z += v2.z; v1.w += v2.w; return v1; }
+constexpr Vector4& operator-=(Vector4& v1, const Vector4& v2) { v1.x -= v2.x; v1.y -= v2.y; v1.z -= v2.z; v1.w -= v2.w; return v1; }
+constexpr Vector4& operator*=(Vector4& v, float s) { v.x *= s; v.y *= s; v.z *= s; v.w *= s; return v; }
\ No newline at end of file
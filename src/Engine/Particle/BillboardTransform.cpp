@@ -0,0 +1,30 @@
+#include "BillboardTransform.h"
+
+namespace {
+// 方向ベクトル（w=0）にビュープロジェクション行列を掛ける
+Vector4 TransformAxis(const Vector3& axis, const Matrix4x4& m) {
+    return {
+        axis.x * m.m[0][0] + axis.y * m.m[1][0] + axis.z * m.m[2][0],
+        axis.x * m.m[0][1] + axis.y * m.m[1][1] + axis.z * m.m[2][1],
+        axis.x * m.m[0][2] + axis.y * m.m[1][2] + axis.z * m.m[2][2],
+        axis.x * m.m[0][3] + axis.y * m.m[1][3] + axis.z * m.m[2][3],
+    };
+}
+}
+
+BillboardBasis MakeBillboardBasis(const Matrix4x4& billboardMatrix, const Matrix4x4& viewProjectionMatrix) {
+    BillboardBasis basis;
+
+    // ビルボード行列の各行がそのまま各軸になる
+    basis.axisX = { billboardMatrix.m[0][0], billboardMatrix.m[0][1], billboardMatrix.m[0][2] };
+    basis.axisY = { billboardMatrix.m[1][0], billboardMatrix.m[1][1], billboardMatrix.m[1][2] };
+    basis.axisZ = { billboardMatrix.m[2][0], billboardMatrix.m[2][1], billboardMatrix.m[2][2] };
+
+    // 軸ごとにビュープロジェクション変換を済ませておく
+    basis.clipAxisX = TransformAxis(basis.axisX, viewProjectionMatrix);
+    basis.clipAxisY = TransformAxis(basis.axisY, viewProjectionMatrix);
+    basis.clipAxisZ = TransformAxis(basis.axisZ, viewProjectionMatrix);
+
+    basis.viewProjection = viewProjectionMatrix;
+    return basis;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "FastMath.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix4x4.h"
+
+// ビルボード変換の前計算データ（カメラが決まったらフレームに1回だけ作る）
+struct BillboardBasis {
+    // ビルボード行列の各軸（ワールド空間）
+    Vector3 axisX;
+    Vector3 axisY;
+    Vector3 axisZ;
+    // 各軸にビュープロジェクション行列を掛けたもの
+    Vector4 clipAxisX;
+    Vector4 clipAxisY;
+    Vector4 clipAxisZ;
+    // ビュープロジェクション行列（平行移動成分の変換用）
+    Matrix4x4 viewProjection;
+};
+
+// ビルボード行列とビュープロジェクション行列から前計算データを作成
+BillboardBasis MakeBillboardBasis(const Matrix4x4& billboardMatrix, const Matrix4x4& viewProjectionMatrix);
+
+// サイズ・Z回転（のsinとcos）・座標からWorld行列とWVP行列を直接計算する
+// Scale * RotateZ * Billboard * Translate と同じ結果を、4x4行列の乗算なしで求める
+// 多数のパーティクルを処理するときは、回転のsinとcosをFastMath::SinCos(span)でまとめて求めてから渡す
+inline void MakeBillboardTransform(
+    const BillboardBasis& basis, float size, float sinRotation, float cosRotation, const Vector3& position,
+    Matrix4x4& world, Matrix4x4& wvp) {
+    float s = sinRotation;
+    float c = cosRotation;
+
+    // 回転とスケールを合成した係数
+    float xx = size * c;
+    float xy = size * s;
+    float yx = -size * s;
+    float yy = size * c;
+
+    // World行列（1～3行目はビルボード軸の線形結合、4行目は座標）
+    world.m[0][0] = xx * basis.axisX.x + xy * basis.axisY.x;
+    world.m[0][1] = xx * basis.axisX.y + xy * basis.axisY.y;
+    world.m[0][2] = xx * basis.axisX.z + xy * basis.axisY.z;
+    world.m[0][3] = 0.0f;
+
+    world.m[1][0] = yx * basis.axisX.x + yy * basis.axisY.x;
+    world.m[1][1] = yx * basis.axisX.y + yy * basis.axisY.y;
+    world.m[1][2] = yx * basis.axisX.z + yy * basis.axisY.z;
+    world.m[1][3] = 0.0f;
+
+    world.m[2][0] = size * basis.axisZ.x;
+    world.m[2][1] = size * basis.axisZ.y;
+    world.m[2][2] = size * basis.axisZ.z;
+    world.m[2][3] = 0.0f;
+
+    world.m[3][0] = position.x;
+    world.m[3][1] = position.y;
+    world.m[3][2] = position.z;
+    world.m[3][3] = 1.0f;
+
+    // WVP行列（同じ係数を変換済みの軸に掛ける）
+    wvp.m[0][0] = xx * basis.clipAxisX.x + xy * basis.clipAxisY.x;
+    wvp.m[0][1] = xx * basis.clipAxisX.y + xy * basis.clipAxisY.y;
+    wvp.m[0][2] = xx * basis.clipAxisX.z + xy * basis.clipAxisY.z;
+    wvp.m[0][3] = xx * basis.clipAxisX.w + xy * basis.clipAxisY.w;
+
+    wvp.m[1][0] = yx * basis.clipAxisX.x + yy * basis.clipAxisY.x;
+    wvp.m[1][1] = yx * basis.clipAxisX.y + yy * basis.clipAxisY.y;
+    wvp.m[1][2] = yx * basis.clipAxisX.z + yy * basis.clipAxisY.z;
+    wvp.m[1][3] = yx * basis.clipAxisX.w + yy * basis.clipAxisY.w;
+
+    wvp.m[2][0] = size * basis.clipAxisZ.x;
+    wvp.m[2][1] = size * basis.clipAxisZ.y;
+    wvp.m[2][2] = size * basis.clipAxisZ.z;
+    wvp.m[2][3] = size * basis.clipAxisZ.w;
+
+    // 4行目は座標をビュープロジェクション行列で変換したもの
+    const Matrix4x4& vp = basis.viewProjection;
+    for (int j = 0; j < 4; ++j) {
+        wvp.m[3][j] = position.x * vp.m[0][j] + position.y * vp.m[1][j] + position.z * vp.m[2][j] + vp.m[3][j];
+    }
+}
+
+// 回転角から求める場合（sinとcosはFastMath::SinCosで同時に求める）
+inline void MakeBillboardTransform(
+    const BillboardBasis& basis, float size, float rotation, const Vector3& position,
+    Matrix4x4& world, Matrix4x4& wvp) {
+    float s;
+    float c;
+    FastMath::SinCos(rotation, s, c);
+    MakeBillboardTransform(basis, size, s, c, position, world, wvp);
+}
@@ -0,0 +1,154 @@
+#include "ParticleCurve.h"
+#include <algorithm>
+
+#pragma region 曲線
+ParticleCurve& ParticleCurve::AddKey(float time, float value) {
+    // 同じ時間以下のキーの後ろに挿入して時間順を保つ
+    auto it = std::upper_bound(keys_.begin(), keys_.end(), time,
+        [](float t, const Key& key) { return t < key.time; });
+    keys_.insert(it, { time, value });
+    return *this;
+}
+
+float ParticleCurve::Evaluate(float time) const {
+    if (keys_.empty()) {
+        return 1.0f;
+    }
+    if (time <= keys_.front().time) {
+        return keys_.front().value;
+    }
+    if (time >= keys_.back().time) {
+        return keys_.back().value;
+    }
+
+    // timeを含む区間[k1, k2]を探す
+    size_t k2 = 1;
+    while (keys_[k2].time < time) {
+        ++k2;
+    }
+    size_t k1 = k2 - 1;
+    const Key& p1 = keys_[k1];
+    const Key& p2 = keys_[k2];
+    float span = p2.time - p1.time;
+    if (span <= 0.0f) {
+        return p2.value;
+    }
+
+    // 前後のキーから接線を求める（端は片側差分）
+    auto tangent = [this](size_t k) {
+        size_t prev = k > 0 ? k - 1 : k;
+        size_t next = k + 1 < keys_.size() ? k + 1 : k;
+        float dt = keys_[next].time - keys_[prev].time;
+        return dt > 0.0f ? (keys_[next].value - keys_[prev].value) / dt : 0.0f;
+    };
+    float m1 = tangent(k1) * span;
+    float m2 = tangent(k2) * span;
+
+    // エルミート補間
+    float t = (time - p1.time) / span;
+    float t2 = t * t;
+    float t3 = t2 * t;
+    float h00 = 2.0f * t3 - 3.0f * t2 + 1.0f;
+    float h10 = t3 - 2.0f * t2 + t;
+    float h01 = -2.0f * t3 + 3.0f * t2;
+    float h11 = t3 - t2;
+    return h00 * p1.value + h10 * m1 + h01 * p2.value + h11 * m2;
+}
+#pragma endregion
+
+#pragma region グラデーション
+ParticleGradient& ParticleGradient::AddKey(float time, const Vector4& color) {
+    auto it = std::upper_bound(keys_.begin(), keys_.end(), time,
+        [](float t, const Key& key) { return t < key.time; });
+    keys_.insert(it, { time, color });
+    return *this;
+}
+
+Vector4 ParticleGradient::Evaluate(float time) const {
+    if (keys_.empty()) {
+        return { 1.0f, 1.0f, 1.0f, 1.0f };
+    }
+    if (time <= keys_.front().time) {
+        return keys_.front().color;
+    }
+    if (time >= keys_.back().time) {
+        return keys_.back().color;
+    }
+
+    size_t k2 = 1;
+    while (keys_[k2].time < time) {
+        ++k2;
+    }
+    const Key& p1 = keys_[k2 - 1];
+    const Key& p2 = keys_[k2];
+    float span = p2.time - p1.time;
+    float t = span > 0.0f ? (time - p1.time) / span : 1.0f;
+    return {
+        p1.color.x + (p2.color.x - p1.color.x) * t,
+        p1.color.y + (p2.color.y - p1.color.y) * t,
+        p1.color.z + (p2.color.z - p1.color.z) * t,
+        p1.color.w + (p2.color.w - p1.color.w) * t,
+    };
+}
+#pragma endregion
+
+#pragma region テーブル
+void ParticleCurveTable::Bake(const ParticleCurve& curve) {
+    for (uint32_t i = 0; i < kParticleCurveTableSize; ++i) {
+        float t = static_cast<float>(i) / static_cast<float>(kParticleCurveTableSize - 1);
+        values[i] = curve.Evaluate(t);
+    }
+    values[kParticleCurveTableSize] = values[kParticleCurveTableSize - 1];
+}
+
+void ParticleGradientTable::Bake(const ParticleGradient& gradient) {
+    for (uint32_t i = 0; i < kParticleCurveTableSize; ++i) {
+        float t = static_cast<float>(i) / static_cast<float>(kParticleCurveTableSize - 1);
+        Vector4 color = gradient.Evaluate(t);
+        r.values[i] = color.x;
+        g.values[i] = color.y;
+        b.values[i] = color.z;
+        a.values[i] = color.w;
+    }
+    r.values[kParticleCurveTableSize] = r.values[kParticleCurveTableSize - 1];
+    g.values[kParticleCurveTableSize] = g.values[kParticleCurveTableSize - 1];
+    b.values[kParticleCurveTableSize] = b.values[kParticleCurveTableSize - 1];
+    a.values[kParticleCurveTableSize] = a.values[kParticleCurveTableSize - 1];
+}
+#pragma endregion
+
+void ApplyLifetimeCurves(const ParticleLifetimeCurves& curves, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    if (!curves.IsEnabled()) {
+        return;
+    }
+
+    for (uint32_t i = begin; i < end; ++i) {
+        float t = pool.lifeTime[i] / pool.lifeTimeMax[i];
+
+        // サイズ（カーネルで毎回補間し直しているので倍率を掛けるだけでよい）
+        if (curves.hasSize) {
+            pool.size[i] *= curves.size.Sample(t);
+        }
+
+        // 色
+        if (curves.hasColor) {
+            pool.colorR[i] *= curves.color.r.Sample(t);
+            pool.colorG[i] *= curves.color.g.Sample(t);
+            pool.colorB[i] *= curves.color.b.Sample(t);
+            pool.colorA[i] *= curves.color.a.Sample(t);
+        }
+
+        // 回転速度（カーネルで等倍分は進めているので差分だけ補正する）
+        if (curves.hasRotationSpeed) {
+            pool.rotation[i] += pool.rotationVelocity[i] * (curves.rotationSpeed.Sample(t) - 1.0f) * deltaTime;
+        }
+
+        // 速度の減衰（減衰しすぎて逆向きにならないよう0で止める）
+        if (curves.hasDamping) {
+            float scale = (std::max)(0.0f, 1.0f - curves.damping.Sample(t) * deltaTime);
+            pool.velocityX[i] *= scale;
+            pool.velocityY[i] *= scale;
+            pool.velocityZ[i] *= scale;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Vector4.h"
+#include "ParticlePool.h"
+
+// 曲線テーブルの分解能（寿命0～1をこの数で区切る）
+static const uint32_t kParticleCurveTableSize = 64;
+
+// 寿命（0～1）に対する値の曲線
+// キーの間はCatmull-Rom型のエルミート補間で滑らかにつなぐ
+class ParticleCurve {
+public:
+    // キー
+    struct Key {
+        float time;
+        float value;
+    };
+
+    // コンストラクタ（キーなしは常に1.0）
+    ParticleCurve() = default;
+
+    // 一定値の曲線
+    explicit ParticleCurve(float value) { AddKey(0.0f, value); }
+
+    // キーの追加（時間順に並べて保持する）
+    ParticleCurve& AddKey(float time, float value);
+
+    // 値の取得（範囲外は端のキーの値）
+    float Evaluate(float time) const;
+
+    // キー一覧の取得
+    const std::vector<Key>& GetKeys() const { return keys_; }
+
+private:
+    std::vector<Key> keys_;
+};
+
+// 寿命（0～1）に対する色のグラデーション（キーの間は線形補間）
+class ParticleGradient {
+public:
+    // キー
+    struct Key {
+        float time;
+        Vector4 color;
+    };
+
+    // キーの追加（時間順に並べて保持する）
+    ParticleGradient& AddKey(float time, const Vector4& color);
+
+    // 色の取得（キーなしは白、範囲外は端のキーの色）
+    Vector4 Evaluate(float time) const;
+
+    // キー一覧の取得
+    const std::vector<Key>& GetKeys() const { return keys_; }
+
+private:
+    std::vector<Key> keys_;
+};
+
+// 曲線を焼き込んだテーブル（更新時はスプラインを評価せず表を引く）
+struct ParticleCurveTable {
+    // 末尾に1つ余分に持たせて、t=1でも範囲外を読まずに補間できるようにする
+    float values[kParticleCurveTableSize + 1];
+
+    // 曲線の焼き込み
+    void Bake(const ParticleCurve& curve);
+
+    // 値の取得（テーブル間は線形補間）
+    float Sample(float t) const {
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        float x = t * static_cast<float>(kParticleCurveTableSize - 1);
+        uint32_t index = static_cast<uint32_t>(x);
+        float f = x - static_cast<float>(index);
+        return values[index] + (values[index + 1] - values[index]) * f;
+    }
+};
+
+// グラデーションを焼き込んだテーブル（RGBAそれぞれ連続した配列で持つ）
+struct ParticleGradientTable {
+    ParticleCurveTable r;
+    ParticleCurveTable g;
+    ParticleCurveTable b;
+    ParticleCurveTable a;
+
+    // グラデーションの焼き込み
+    void Bake(const ParticleGradient& gradient);
+};
+
+// パーティクルグループの寿命に応じた変化
+// 積分カーネルで求めたサイズ・色に倍率を掛け、回転速度と速度の減衰を寿命に応じて変える
+struct ParticleLifetimeCurves {
+    // サイズの倍率
+    bool hasSize = false;
+    ParticleCurveTable size;
+
+    // 色の倍率
+    bool hasColor = false;
+    ParticleGradientTable color;
+
+    // 回転速度の倍率
+    bool hasRotationSpeed = false;
+    ParticleCurveTable rotationSpeed;
+
+    // 速度の減衰率（1秒あたり）
+    bool hasDamping = false;
+    ParticleCurveTable damping;
+
+    // どれか1つでも有効か
+    bool IsEnabled() const { return hasSize || hasColor || hasRotationSpeed || hasDamping; }
+};
+
+// 寿命に応じた変化を適用する（IntegrateParticlesの直後に同じ範囲に対して呼ぶ）
+void ApplyLifetimeCurves(const ParticleLifetimeCurves& curves, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime);
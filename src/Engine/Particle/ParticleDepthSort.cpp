@@ -0,0 +1,136 @@
+#include "ParticleDepthSort.h"
+#include <cstring>
+
+namespace {
+// 基数ソートの1パスあたりのビット数とバケット数
+const uint32_t kRadixBits = 11;
+const uint32_t kRadixSize = 1u << kRadixBits;
+const uint32_t kRadixMask = kRadixSize - 1;
+const uint32_t kRadixPassCount = (32 + kRadixBits - 1) / kRadixBits;
+
+// 深度から昇順に並べると奥から手前になる整数キーを作る
+// 浮動小数点数のビット列は符号を調整すると整数として大小関係が保たれるので、それを反転して降順にする
+inline uint32_t MakeDepthKey(float depth) {
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    uint32_t mask = (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+    return ~(bits ^ mask);
+}
+}
+
+void ParticleDepthSorter::RebuildOrder(uint32_t count) {
+    // 削除は末尾との入れ替えなので、前フレームの添字のうちcount未満のものはそのまま使える
+    // （中身が入れ替わった添字は深度が変わるだけで、並べ替えで正しい位置に移る）
+    uint32_t previousCount = static_cast<uint32_t>(order_.size());
+    uint32_t writeIndex = 0;
+    for (uint32_t k = 0; k < previousCount; ++k) {
+        if (order_[k] < count) {
+            order_[writeIndex++] = order_[k];
+        }
+    }
+    order_.resize(writeIndex);
+
+    // 新しく増えた添字は末尾に追加
+    for (uint32_t i = previousCount; i < count; ++i) {
+        order_.push_back(i);
+    }
+}
+
+void ParticleDepthSorter::Sort(const ParticlePool& pool, const Matrix4x4& viewMatrix) {
+    uint32_t count = pool.Size();
+    RebuildOrder(count);
+
+    // 前フレームの並び順のままキーを計算（ビュー行列のZ列との内積がビュー空間の深度）
+    keys_.resize(count);
+    float zx = viewMatrix.m[0][2];
+    float zy = viewMatrix.m[1][2];
+    float zz = viewMatrix.m[2][2];
+    float zw = viewMatrix.m[3][2];
+    for (uint32_t k = 0; k < count; ++k) {
+        uint32_t i = order_[k];
+        float depth = pool.positionX[i] * zx + pool.positionY[i] * zy + pool.positionZ[i] * zz + zw;
+        keys_[k] = MakeDepthKey(depth);
+    }
+
+    // フレーム間の変化が小さければ挿入ソートで直す（移動回数が全体の数倍を超えたら諦める）
+    wasIncremental_ = InsertionSort(static_cast<uint64_t>(count) * 4);
+    if (!wasIncremental_) {
+        RadixSort();
+    }
+}
+
+bool ParticleDepthSorter::InsertionSort(uint64_t maxMoves) {
+    uint32_t count = static_cast<uint32_t>(keys_.size());
+    uint64_t moves = 0;
+
+    for (uint32_t k = 1; k < count; ++k) {
+        uint32_t key = keys_[k];
+        if (keys_[k - 1] <= key) {
+            continue;
+        }
+
+        // 前に詰めながら挿入位置を探す
+        uint32_t index = order_[k];
+        uint32_t j = k;
+        while (j > 0 && keys_[j - 1] > key) {
+            keys_[j] = keys_[j - 1];
+            order_[j] = order_[j - 1];
+            --j;
+            ++moves;
+        }
+        keys_[j] = key;
+        order_[j] = index;
+
+        if (moves > maxMoves) {
+            // 途中まで挿入済みでも並び順は有効な順列なので、そのまま基数ソートに渡せる
+            return false;
+        }
+    }
+    return true;
+}
+
+void ParticleDepthSorter::RadixSort() {
+    uint32_t count = static_cast<uint32_t>(keys_.size());
+    if (count == 0) {
+        return;
+    }
+    tempKeys_.resize(count);
+    tempOrder_.resize(count);
+
+    // 全パスのヒストグラムを1回の走査でまとめて作る
+    histogram_.assign(kRadixSize * kRadixPassCount, 0);
+    for (uint32_t k = 0; k < count; ++k) {
+        uint32_t key = keys_[k];
+        for (uint32_t pass = 0; pass < kRadixPassCount; ++pass) {
+            ++histogram_[pass * kRadixSize + ((key >> (pass * kRadixBits)) & kRadixMask)];
+        }
+    }
+
+    for (uint32_t pass = 0; pass < kRadixPassCount; ++pass) {
+        uint32_t* bucket = &histogram_[pass * kRadixSize];
+        uint32_t shift = pass * kRadixBits;
+
+        // 全要素が同じ桁ならこのパスは並びが変わらないので飛ばす
+        if (bucket[(keys_[0] >> shift) & kRadixMask] == count) {
+            continue;
+        }
+
+        // 累積和で書き込み開始位置にする
+        uint32_t sum = 0;
+        for (uint32_t b = 0; b < kRadixSize; ++b) {
+            uint32_t n = bucket[b];
+            bucket[b] = sum;
+            sum += n;
+        }
+
+        // 安定に振り分ける
+        for (uint32_t k = 0; k < count; ++k) {
+            uint32_t key = keys_[k];
+            uint32_t dst = bucket[(key >> shift) & kRadixMask]++;
+            tempKeys_[dst] = key;
+            tempOrder_[dst] = order_[k];
+        }
+        keys_.swap(tempKeys_);
+        order_.swap(tempOrder_);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Matrix4x4.h"
+#include "ParticlePool.h"
+
+// パーティクルのビュー空間の深度による並べ替え（アルファブレンド用に奥から手前の順にする）
+// 並び順は前フレームのものを引き継ぎ、ほぼ並んでいれば挿入ソートで直すだけで済ませる
+// 大きく崩れていれば32bitキーのLSD基数ソート（11bit×3パス）で並べ直す
+class ParticleDepthSorter {
+public:
+    // 並べ替え（GetOrder()で奥から手前の順のパーティクルの添字を取得できる）
+    void Sort(const ParticlePool& pool, const Matrix4x4& viewMatrix);
+
+    // 奥から手前の順の添字
+    const std::vector<uint32_t>& GetOrder() const { return order_; }
+
+    // 直前の並べ替えが挿入ソートで済んだか（デバッグ用）
+    bool WasIncremental() const { return wasIncremental_; }
+
+private:
+    // 並び順（前フレームの結果を引き継ぐ）
+    std::vector<uint32_t> order_;
+
+    // 並び順に対応するソートキー
+    std::vector<uint32_t> keys_;
+
+    // 基数ソートの作業用
+    std::vector<uint32_t> tempOrder_;
+    std::vector<uint32_t> tempKeys_;
+    std::vector<uint32_t> histogram_;
+
+    // 直前の並べ替えが挿入ソートで済んだか
+    bool wasIncremental_ = false;
+
+    // 前フレームの並び順を現在のパーティクル数に合わせる
+    void RebuildOrder(uint32_t count);
+
+    // 挿入ソート（移動回数がmaxMovesを超えたら中断してfalseを返す）
+    bool InsertionSort(uint64_t maxMoves);
+
+    // LSD基数ソート
+    void RadixSort();
+};
@@ -75,21 +75,25 @@ ParticleEmitter::ParticleEmitter(
         lifeTimeMax_);
 }
 
-void ParticleEmitter::Update() {
-    // 発生フラグがOFFなら処理しない
-    if (!isEmitting_) {
+void ParticleEmitter::Update(float deltaTime) {
+    // 発生フラグがOFF、または発生頻度が0以下なら処理しない
+    if (!isEmitting_ || emitRate_ <= 0.0f) {
         return;
     }
 
     // 時間を進める
-    currentTime_ += 1.0f / 60.0f; // 60FPS想定
+    currentTime_ += deltaTime;
 
     // 発生頻度から発生タイミングを計算
     float interval = 1.0f / emitRate_;
 
-    // 発生タイミングを超えていたらパーティクルを発生
-    if (currentTime_ >= interval) {
-        // 発生処理
+    // 発生タイミングを超えた回数だけパーティクルを発生
+    while (currentTime_ >= interval) {
+        // 経過時間を戻す（余剰分を考慮）
+        currentTime_ -= interval;
+
+        // 発生処理（残った経過時間は発生してからフレームの終わりまでの時間なので、その分進めておく）
+        // 1フレームに複数回発生しても、発生した時刻ごとに位置と経過時間がずれて1か所に固まらない
         ParticleManager::GetInstance()->Emit(
             name_,
             transform_.translate,
@@ -111,9 +115,7 @@ void ParticleEmitter::Update() {
             rotationVelocityMin_,
             rotationVelocityMax_,
             lifeTimeMin_,
-            lifeTimeMax_);
-
-        // 経過時間を戻す（余剰分を考慮）
-        currentTime_ -= interval;
+            lifeTimeMax_,
+            currentTime_);
     }
 }
\ No newline at end of file
@@ -37,8 +37,9 @@ public:
     // デストラクタ
     ~ParticleEmitter() = default;
 
-    // 更新
-    void Update();
+    // 更新（deltaTimeは前フレームからの経過時間（秒））
+    // 1フレームに発生間隔を複数回またいだ場合は、その回数分まとめて発生させる
+    void Update(float deltaTime);
 
     // 発生フラグ設定
     void SetEmitting(bool isEmitting) { isEmitting_ = isEmitting; }
@@ -0,0 +1,160 @@
+#include "ParticleForceField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 距離に応じた減衰（半径0以下は減衰なし、半径の外は0）
+inline float Falloff(float distance, float radius) {
+    if (radius <= 0.0f) {
+        return 1.0f;
+    }
+    return (std::max)(0.0f, 1.0f - distance / radius);
+}
+
+// 法線方向の衝突応答（法線方向は反発、接線方向は摩擦で減らす）
+inline void ResolveContact(float& vx, float& vy, float& vz, float nx, float ny, float nz, float bounce, float friction) {
+    float vn = vx * nx + vy * ny + vz * nz;
+    if (vn >= 0.0f) {
+        // 既に離れる向きに動いている
+        return;
+    }
+    float tx = vx - vn * nx;
+    float ty = vy - vn * ny;
+    float tz = vz - vn * nz;
+    float keep = 1.0f - friction;
+    vx = tx * keep - vn * bounce * nx;
+    vy = ty * keep - vn * bounce * ny;
+    vz = tz * keep - vn * bounce * nz;
+}
+}
+
+void ApplyForceFields(const ParticleForceStage& stage, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    // 引き寄せ
+    for (const ParticleAttractor& attractor : stage.attractors) {
+        for (uint32_t i = begin; i < end; ++i) {
+            float dx = attractor.position.x - pool.positionX[i];
+            float dy = attractor.position.y - pool.positionY[i];
+            float dz = attractor.position.z - pool.positionZ[i];
+            float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            if (distance < 1.0e-4f) {
+                continue;
+            }
+            float scale = attractor.strength * Falloff(distance, attractor.radius) * deltaTime / distance;
+            pool.velocityX[i] += dx * scale;
+            pool.velocityY[i] += dy * scale;
+            pool.velocityZ[i] += dz * scale;
+        }
+    }
+
+    // 渦（軸に垂直な成分と軸の外積が接線方向になる）
+    for (const ParticleVortex& vortex : stage.vortices) {
+        const Vector3& a = vortex.axis;
+        for (uint32_t i = begin; i < end; ++i) {
+            float rx = pool.positionX[i] - vortex.position.x;
+            float ry = pool.positionY[i] - vortex.position.y;
+            float rz = pool.positionZ[i] - vortex.position.z;
+            float along = rx * a.x + ry * a.y + rz * a.z;
+            rx -= a.x * along;
+            ry -= a.y * along;
+            rz -= a.z * along;
+            float distance = std::sqrt(rx * rx + ry * ry + rz * rz);
+            if (distance < 1.0e-4f) {
+                continue;
+            }
+            float tx = a.y * rz - a.z * ry;
+            float ty = a.z * rx - a.x * rz;
+            float tz = a.x * ry - a.y * rx;
+            float scale = vortex.strength * Falloff(distance, vortex.radius) * deltaTime / distance;
+            pool.velocityX[i] += tx * scale;
+            pool.velocityY[i] += ty * scale;
+            pool.velocityZ[i] += tz * scale;
+        }
+    }
+
+    // 風（範囲内なら速度を風速に近づける）
+    for (const ParticleWindVolume& wind : stage.windVolumes) {
+        float rate = (std::min)(1.0f, wind.drag * deltaTime);
+        for (uint32_t i = begin; i < end; ++i) {
+            float px = pool.positionX[i];
+            float py = pool.positionY[i];
+            float pz = pool.positionZ[i];
+            if (px < wind.min.x || px > wind.max.x ||
+                py < wind.min.y || py > wind.max.y ||
+                pz < wind.min.z || pz > wind.max.z) {
+                continue;
+            }
+            pool.velocityX[i] += (wind.velocity.x - pool.velocityX[i]) * rate;
+            pool.velocityY[i] += (wind.velocity.y - pool.velocityY[i]) * rate;
+            pool.velocityZ[i] += (wind.velocity.z - pool.velocityZ[i]) * rate;
+        }
+    }
+}
+
+void ApplyColliders(const ParticleForceStage& stage, ParticlePool& pool, uint32_t begin, uint32_t end) {
+    // 平面（裏側に出たら表面に戻して反射）
+    for (const ParticlePlaneCollider& plane : stage.planeColliders) {
+        const Vector3& n = plane.normal;
+        for (uint32_t i = begin; i < end; ++i) {
+            float depth = pool.positionX[i] * n.x + pool.positionY[i] * n.y + pool.positionZ[i] * n.z - plane.distance;
+            if (depth >= 0.0f) {
+                continue;
+            }
+            pool.positionX[i] -= n.x * depth;
+            pool.positionY[i] -= n.y * depth;
+            pool.positionZ[i] -= n.z * depth;
+            ResolveContact(pool.velocityX[i], pool.velocityY[i], pool.velocityZ[i], n.x, n.y, n.z, plane.bounce, plane.friction);
+        }
+    }
+
+    // 球（内側に入ったら表面に戻して反射）
+    for (const ParticleSphereCollider& sphere : stage.sphereColliders) {
+        float radiusSq = sphere.radius * sphere.radius;
+        for (uint32_t i = begin; i < end; ++i) {
+            float dx = pool.positionX[i] - sphere.center.x;
+            float dy = pool.positionY[i] - sphere.center.y;
+            float dz = pool.positionZ[i] - sphere.center.z;
+            float distanceSq = dx * dx + dy * dy + dz * dz;
+            if (distanceSq >= radiusSq || distanceSq < 1.0e-8f) {
+                continue;
+            }
+            float distance = std::sqrt(distanceSq);
+            float nx = dx / distance;
+            float ny = dy / distance;
+            float nz = dz / distance;
+            pool.positionX[i] = sphere.center.x + nx * sphere.radius;
+            pool.positionY[i] = sphere.center.y + ny * sphere.radius;
+            pool.positionZ[i] = sphere.center.z + nz * sphere.radius;
+            ResolveContact(pool.velocityX[i], pool.velocityY[i], pool.velocityZ[i], nx, ny, nz, sphere.bounce, sphere.friction);
+        }
+    }
+}
+
+void ApplyRepulsion(const ParticleRepulsion& repulsion, const ParticleSpatialHash& hash, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    float radius = repulsion.radius;
+    float scale = repulsion.strength * deltaTime;
+
+    // セル順に処理して近傍セルの読み込みをキャッシュに乗せる
+    for (uint32_t k = begin; k < end; ++k) {
+        uint32_t i = hash.GetSortedIndex(k);
+        float ax = 0.0f;
+        float ay = 0.0f;
+        float az = 0.0f;
+
+        // 近いほど強く押し返す（自分自身と完全に重なったものは向きが決まらないので除外）
+        hash.ForEachNeighbor(hash.GetSortedX(k), hash.GetSortedY(k), hash.GetSortedZ(k), radius,
+            [&](uint32_t j, float dx, float dy, float dz, float distanceSq) {
+                if (j == i || distanceSq < 1.0e-8f) {
+                    return;
+                }
+                float distance = std::sqrt(distanceSq);
+                float weight = (1.0f - distance / radius) / distance;
+                ax += dx * weight;
+                ay += dy * weight;
+                az += dz * weight;
+            });
+
+        pool.velocityX[i] += ax * scale;
+        pool.velocityY[i] += ay * scale;
+        pool.velocityZ[i] += az * scale;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+#include "ParticlePool.h"
+#include "ParticleSpatialHash.h"
+
+// 点に引き寄せる力場（strengthが負なら反発）
+struct ParticleAttractor {
+    // 中心
+    Vector3 position;
+    // 強さ（加速度の大きさ）
+    float strength;
+    // 影響半径（0以下なら無限、半径内は中心に近いほど強い）
+    float radius;
+};
+
+// 軸の周りを回す渦の力場
+struct ParticleVortex {
+    // 中心
+    Vector3 position;
+    // 回転軸（正規化済み）
+    Vector3 axis;
+    // 強さ（接線方向の加速度の大きさ）
+    float strength;
+    // 影響半径（0以下なら無限）
+    float radius;
+};
+
+// 箱の範囲内で速度を風速に近づける力場
+struct ParticleWindVolume {
+    // 範囲（AABB）
+    Vector3 min;
+    Vector3 max;
+    // 風速
+    Vector3 velocity;
+    // 風速に近づく速さ（1秒あたり）
+    float drag;
+};
+
+// 平面の衝突判定（normal・p >= distanceの側に留める）
+struct ParticlePlaneCollider {
+    // 法線（正規化済み）
+    Vector3 normal;
+    // 原点からの距離
+    float distance;
+    // 反発係数（0で止まる、1で完全反射）
+    float bounce;
+    // 摩擦（接線方向の速度を減らす割合）
+    float friction;
+};
+
+// 球の衝突判定（球の外側に留める）
+struct ParticleSphereCollider {
+    // 中心
+    Vector3 center;
+    // 半径
+    float radius;
+    // 反発係数
+    float bounce;
+    // 摩擦
+    float friction;
+};
+
+// パーティクル同士の反発（空間ハッシュで近傍だけを調べる）
+struct ParticleRepulsion {
+    // 有効か
+    bool isEnabled = false;
+    // 影響半径（空間ハッシュのセルはこの2倍の大きさにする）
+    float radius = 0.5f;
+    // 強さ（半径内で近いほど強くなる加速度の最大値）
+    float strength = 1.0f;
+};
+
+// パーティクルグループに掛かる力と衝突の設定
+struct ParticleForceStage {
+    std::vector<ParticleAttractor> attractors;
+    std::vector<ParticleVortex> vortices;
+    std::vector<ParticleWindVolume> windVolumes;
+    std::vector<ParticlePlaneCollider> planeColliders;
+    std::vector<ParticleSphereCollider> sphereColliders;
+    ParticleRepulsion repulsion;
+
+    // 力場があるか
+    bool HasForceFields() const { return !attractors.empty() || !vortices.empty() || !windVolumes.empty(); }
+
+    // 衝突判定があるか
+    bool HasColliders() const { return !planeColliders.empty() || !sphereColliders.empty(); }
+};
+
+// 力場による速度の変化を適用する（IntegrateParticlesの前に同じ範囲に対して呼ぶ）
+void ApplyForceFields(const ParticleForceStage& stage, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime);
+
+// 衝突判定と応答（IntegrateParticlesの後に同じ範囲に対して呼ぶ）
+void ApplyColliders(const ParticleForceStage& stage, ParticlePool& pool, uint32_t begin, uint32_t end);
+
+// パーティクル同士の反発（hashはpoolの現在の座標で構築済みであること）
+// [begin, end)は空間ハッシュのセル順の範囲で、範囲内のパーティクルの速度だけを書き換えるので範囲ごとに並列に呼べる
+void ApplyRepulsion(const ParticleRepulsion& repulsion, const ParticleSpatialHash& hash, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime);
@@ -0,0 +1,240 @@
+#include "ParticleKernel.h"
+#include <cassert>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PARTICLE_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/ClangではAVX2命令を使う関数だけ個別にターゲット指定する
+// （MSVCは/arch指定なしでもAVX組み込み関数を使用できる）
+#if defined(PARTICLE_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PARTICLE_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PARTICLE_KERNEL_TARGET_AVX2
+#endif
+
+namespace {
+
+#pragma region CPU判定
+ParticleKernelType DetectKernelType() {
+#if defined(PARTICLE_KERNEL_X86)
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool hasSSE2 = (info[3] & (1 << 26)) != 0;
+    bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+    bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+    // OSがYMMレジスタの退避に対応しているか
+    bool isYmmEnabled = false;
+    if (hasOSXSave && hasAVX) {
+        isYmmEnabled = (_xgetbv(0) & 0x6) == 0x6;
+    }
+
+    bool hasAVX2 = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        hasAVX2 = (info[1] & (1 << 5)) != 0;
+    }
+
+    if (hasAVX2 && isYmmEnabled) {
+        return ParticleKernelType::AVX2;
+    }
+    if (hasSSE2) {
+        return ParticleKernelType::SSE;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ParticleKernelType::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return ParticleKernelType::SSE;
+    }
+#endif
+#endif
+    return ParticleKernelType::Scalar;
+}
+
+// 現在使用中のカーネル（初期値は判定した最速のカーネル）
+ParticleKernelType& CurrentKernelType() {
+    static ParticleKernelType currentKernelType = GetBestParticleKernelType();
+    return currentKernelType;
+}
+#pragma endregion
+
+#pragma region スカラー版
+void IntegrateScalar(ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    for (uint32_t i = begin; i < end; ++i) {
+        // 経過時間
+        pool.lifeTime[i] += deltaTime;
+
+        // 速度に加速度を加算
+        pool.velocityX[i] += pool.accelX[i] * deltaTime;
+        pool.velocityY[i] += pool.accelY[i] * deltaTime;
+        pool.velocityZ[i] += pool.accelZ[i] * deltaTime;
+
+        // 位置に速度を加算
+        pool.positionX[i] += pool.velocityX[i] * deltaTime;
+        pool.positionY[i] += pool.velocityY[i] * deltaTime;
+        pool.positionZ[i] += pool.velocityZ[i] * deltaTime;
+
+        // 回転を更新
+        pool.rotation[i] += pool.rotationVelocity[i] * deltaTime;
+
+        // 線形補間でサイズと色を更新
+        float t = pool.lifeTime[i] / pool.lifeTimeMax[i];
+        float s = 1.0f - t;
+        pool.size[i] = s * pool.startSize[i] + t * pool.endSize[i];
+        pool.colorR[i] = s * pool.startColorR[i] + t * pool.endColorR[i];
+        pool.colorG[i] = s * pool.startColorG[i] + t * pool.endColorG[i];
+        pool.colorB[i] = s * pool.startColorB[i] + t * pool.endColorB[i];
+        pool.colorA[i] = s * pool.startColorA[i] + t * pool.endColorA[i];
+    }
+}
+#pragma endregion
+
+#if defined(PARTICLE_KERNEL_X86)
+#pragma region SSE版
+// a += b * dt
+inline void MulAddSSE(float* a, const float* b, __m128 dt) {
+    _mm_storeu_ps(a, _mm_add_ps(_mm_loadu_ps(a), _mm_mul_ps(_mm_loadu_ps(b), dt)));
+}
+
+// out = s * from + t * to
+inline void LerpSSE(float* out, const float* from, const float* to, __m128 s, __m128 t) {
+    _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(s, _mm_loadu_ps(from)), _mm_mul_ps(t, _mm_loadu_ps(to))));
+}
+
+// 4粒ずつ処理し、端数はスカラー版で処理する
+void IntegrateSSE(ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        // 経過時間
+        __m128 lifeTime = _mm_add_ps(_mm_loadu_ps(&pool.lifeTime[i]), dt);
+        _mm_storeu_ps(&pool.lifeTime[i], lifeTime);
+
+        // 速度に加速度を加算
+        MulAddSSE(&pool.velocityX[i], &pool.accelX[i], dt);
+        MulAddSSE(&pool.velocityY[i], &pool.accelY[i], dt);
+        MulAddSSE(&pool.velocityZ[i], &pool.accelZ[i], dt);
+
+        // 位置に速度を加算
+        MulAddSSE(&pool.positionX[i], &pool.velocityX[i], dt);
+        MulAddSSE(&pool.positionY[i], &pool.velocityY[i], dt);
+        MulAddSSE(&pool.positionZ[i], &pool.velocityZ[i], dt);
+
+        // 回転を更新
+        MulAddSSE(&pool.rotation[i], &pool.rotationVelocity[i], dt);
+
+        // 線形補間でサイズと色を更新
+        __m128 t = _mm_div_ps(lifeTime, _mm_loadu_ps(&pool.lifeTimeMax[i]));
+        __m128 s = _mm_sub_ps(one, t);
+        LerpSSE(&pool.size[i], &pool.startSize[i], &pool.endSize[i], s, t);
+        LerpSSE(&pool.colorR[i], &pool.startColorR[i], &pool.endColorR[i], s, t);
+        LerpSSE(&pool.colorG[i], &pool.startColorG[i], &pool.endColorG[i], s, t);
+        LerpSSE(&pool.colorB[i], &pool.startColorB[i], &pool.endColorB[i], s, t);
+        LerpSSE(&pool.colorA[i], &pool.startColorA[i], &pool.endColorA[i], s, t);
+    }
+    IntegrateScalar(pool, i, end, deltaTime);
+}
+#pragma endregion
+
+#pragma region AVX2版
+// a += b * dt（FMAは使わずスカラー版と丸めを揃える）
+PARTICLE_KERNEL_TARGET_AVX2 inline void MulAddAVX2(float* a, const float* b, __m256 dt) {
+    _mm256_storeu_ps(a, _mm256_add_ps(_mm256_loadu_ps(a), _mm256_mul_ps(_mm256_loadu_ps(b), dt)));
+}
+
+// out = s * from + t * to
+PARTICLE_KERNEL_TARGET_AVX2 inline void LerpAVX2(float* out, const float* from, const float* to, __m256 s, __m256 t) {
+    _mm256_storeu_ps(out, _mm256_add_ps(_mm256_mul_ps(s, _mm256_loadu_ps(from)), _mm256_mul_ps(t, _mm256_loadu_ps(to))));
+}
+
+// 8粒ずつ処理し、端数はSSE版（さらに端数はスカラー版）で処理する
+PARTICLE_KERNEL_TARGET_AVX2 void IntegrateAVX2(ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        // 経過時間
+        __m256 lifeTime = _mm256_add_ps(_mm256_loadu_ps(&pool.lifeTime[i]), dt);
+        _mm256_storeu_ps(&pool.lifeTime[i], lifeTime);
+
+        // 速度に加速度を加算
+        MulAddAVX2(&pool.velocityX[i], &pool.accelX[i], dt);
+        MulAddAVX2(&pool.velocityY[i], &pool.accelY[i], dt);
+        MulAddAVX2(&pool.velocityZ[i], &pool.accelZ[i], dt);
+
+        // 位置に速度を加算
+        MulAddAVX2(&pool.positionX[i], &pool.velocityX[i], dt);
+        MulAddAVX2(&pool.positionY[i], &pool.velocityY[i], dt);
+        MulAddAVX2(&pool.positionZ[i], &pool.velocityZ[i], dt);
+
+        // 回転を更新
+        MulAddAVX2(&pool.rotation[i], &pool.rotationVelocity[i], dt);
+
+        // 線形補間でサイズと色を更新
+        __m256 t = _mm256_div_ps(lifeTime, _mm256_loadu_ps(&pool.lifeTimeMax[i]));
+        __m256 s = _mm256_sub_ps(one, t);
+        LerpAVX2(&pool.size[i], &pool.startSize[i], &pool.endSize[i], s, t);
+        LerpAVX2(&pool.colorR[i], &pool.startColorR[i], &pool.endColorR[i], s, t);
+        LerpAVX2(&pool.colorG[i], &pool.startColorG[i], &pool.endColorG[i], s, t);
+        LerpAVX2(&pool.colorB[i], &pool.startColorB[i], &pool.endColorB[i], s, t);
+        LerpAVX2(&pool.colorA[i], &pool.startColorA[i], &pool.endColorA[i], s, t);
+    }
+    IntegrateSSE(pool, i, end, deltaTime);
+}
+#pragma endregion
+#endif
+
+} // namespace
+
+ParticleKernelType GetBestParticleKernelType() {
+    // 静的ローカル変数の初期化はスレッドセーフなので判定は一度だけ行われる
+    static const ParticleKernelType bestKernelType = DetectKernelType();
+    return bestKernelType;
+}
+
+ParticleKernelType GetParticleKernelType() {
+    return CurrentKernelType();
+}
+
+void SetParticleKernelType(ParticleKernelType type) {
+    // CPUが対応していないカーネルは選択できない
+    assert(static_cast<int>(type) <= static_cast<int>(GetBestParticleKernelType()));
+    CurrentKernelType() = type;
+}
+
+void IntegrateParticles(ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    IntegrateParticles(GetParticleKernelType(), pool, begin, end, deltaTime);
+}
+
+void IntegrateParticles(ParticleKernelType type, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime) {
+    assert(begin <= end && end <= pool.Size());
+
+    switch (type) {
+#if defined(PARTICLE_KERNEL_X86)
+    case ParticleKernelType::AVX2:
+        IntegrateAVX2(pool, begin, end, deltaTime);
+        break;
+    case ParticleKernelType::SSE:
+        IntegrateSSE(pool, begin, end, deltaTime);
+        break;
+#endif
+    default:
+        IntegrateScalar(pool, begin, end, deltaTime);
+        break;
+    }
+}
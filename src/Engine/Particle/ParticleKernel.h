@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include "ParticlePool.h"
+
+// パーティクル更新カーネルの種類
+enum class ParticleKernelType {
+    Scalar, // スカラー版（全環境で動作）
+    SSE,    // SSE版（4粒ずつ処理）
+    AVX2,   // AVX2版（8粒ずつ処理）
+};
+
+// 実行環境で使用可能な最速のカーネルを取得（初回呼び出し時にCPUを判定）
+ParticleKernelType GetBestParticleKernelType();
+
+// 使用するカーネルの取得・設定（検証用に強制的に切り替えられる）
+ParticleKernelType GetParticleKernelType();
+void SetParticleKernelType(ParticleKernelType type);
+
+// パーティクルの積分処理（[begin, end)の範囲）
+// 経過時間・速度・座標・回転を進め、寿命に応じてサイズと色を線形補間する
+// 全カーネルでスカラー版と同じ演算順序で計算するため、結果はビット単位で一致する
+void IntegrateParticles(ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime);
+
+// カーネルを指定して積分処理を行う
+void IntegrateParticles(ParticleKernelType type, ParticlePool& pool, uint32_t begin, uint32_t end, float deltaTime);
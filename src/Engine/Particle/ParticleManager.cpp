@@ -1,11 +1,18 @@
 #include "ParticleManager.h"
 #include "TextureManager.h"
+#include "ParticleSimulation.h"
+#include "JobSystem.h"
+#include "FastMath.h"
 #include <cassert>
 #include <algorithm>
+#include <chrono>
 #include <d3d12.h>
 
 // Meyer's Singletonパターンでは、静的メンバ変数やGetInstance、Finalizeの実装は不要になります
 
+// 板ポリゴン（1辺1の正方形）の中心から角までの距離（Z回転しても大きさ×この値の球に収まる）
+static const float kParticleBoundsRadiusScale = 0.70710678f;
+
 void ParticleManager::Initialize(DirectXCommon* dxCommon, SrvManager* srvManager) {
     // nullptrチェック
     assert(dxCommon);
@@ -15,10 +22,6 @@ void ParticleManager::Initialize(DirectXCommon* dxCommon, SrvManager* srvManager
     dxCommon_ = dxCommon;
     srvManager_ = srvManager;
 
-    // 乱数エンジンの初期化
-    std::random_device seed_gen;
-    randomEngine_.seed(seed_gen());
-
     // グラフィックスパイプラインの初期化
     InitializeGraphicsPipeline();
 
@@ -118,6 +121,8 @@ void ParticleManager::InitializeGraphicsPipeline() {
     // 深度設定
     D3D12_DEPTH_STENCIL_DESC depthStencilDesc{};
     depthStencilDesc.DepthEnable = false; // 深度テストを無効化
+    // 深度テストを有効にしたときに向きが合うよう、比較関数は深度バッファの設定から取る
+    depthStencilDesc.DepthFunc = dxCommon_->GetDepthComparisonFunc();
 
     // ルートパラメータの設定 - シェーダーに合わせて修正（4つのパラメータを使用）
     D3D12_ROOT_PARAMETER rootParameters[4] = {}; // 4つのパラメータに変更
@@ -206,7 +211,7 @@ void ParticleManager::InitializeGraphicsPipeline() {
     pipelineDesc.DepthStencilState = depthStencilDesc;
     pipelineDesc.NumRenderTargets = 1;
     pipelineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
-    pipelineDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    pipelineDesc.DSVFormat = dxCommon_->GetDepthFormat();
     pipelineDesc.SampleDesc.Count = 1;
     pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
     pipelineDesc.SampleMask = 0xffffffff; // すべてのサンプルを有効化
@@ -214,9 +219,20 @@ void ParticleManager::InitializeGraphicsPipeline() {
     hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(
         &pipelineDesc, IID_PPV_ARGS(pipelineState.GetAddressOf()));
     assert(SUCCEEDED(hr));
+
+    // アルファブレンド用（奥から手前の順に描画するグループで使う）
+    pipelineDesc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+    hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(
+        &pipelineDesc, IID_PPV_ARGS(alphaPipelineState.GetAddressOf()));
+    assert(SUCCEEDED(hr));
 }
 
-void ParticleManager::CreateParticleGroup(const std::string& name, const std::string& textureFilePath) {
+void ParticleManager::CreateParticleGroup(
+    const std::string& name,
+    const std::string& textureFilePath,
+    uint32_t capacity,
+    ParticleOverflowPolicy overflowPolicy,
+    uint32_t maxCapacity) {
     // 既に同名のグループが存在する場合は処理をスキップ
     if (particleGroups.find(name) != particleGroups.end()) {
         // 既存のグループがあることをデバッグ出力
@@ -224,36 +240,134 @@ void ParticleManager::CreateParticleGroup(const std::string& name, const std::st
         return;
     }
 
+    // 容量は1以上
+    assert(capacity > 0);
+
     // 新規パーティクルグループを作成
     ParticleGroup group;
     group.textureFilePath = textureFilePath;
     group.instanceCount = 0;
+    group.instanceData = nullptr;
+    group.instanceCapacity = 0;
+    group.capacity = capacity;
+    group.maxCapacity = (std::max)(capacity, maxCapacity);
+    group.overflowPolicy = overflowPolicy;
+    group.peakCount = 0;
+    group.droppedCount = 0;
+    group.recycledCount = 0;
+    group.growCount = 0;
+    group.spatialHashBuildMilliseconds = 0.0f;
+    group.repulsionMilliseconds = 0.0f;
+    group.sortMilliseconds = 0.0f;
+    group.bounds = MakeEmptyAABB();
+    group.isCulled = false;
+    group.culledFrameCount = 0;
+    group.blendMode = ParticleBlendMode::Add;
+
+    // 乱数はグループ名と基準シードから決める（作成順によらず同じ乱数列になる）
+    group.random.Seed(ParticleRandom::MakeSeed(name.c_str(), randomSeed_));
 
     // テクスチャの読み込み
     TextureManager::GetInstance()->LoadTexture(textureFilePath);
     // テクスチャのSRVインデックスを取得
     group.textureSrvIndex = TextureManager::GetInstance()->GetSrvIndex(textureFilePath);
 
-    // インスタンシング用リソースの作成（最大10000パーティクル）
-    const uint32_t kMaxInstanceCount = 10000;
-    group.instanceResource = dxCommon_->CreateBufferResource(sizeof(ParticleForGPU) * kMaxInstanceCount);
+    // プールの領域を先に確保しておく
+    group.particles.Reserve(capacity);
+
+    // インスタンシング用リソースとSRVの作成（容量分だけ確保する）
+    group.instanceSrvIndex = srvManager_->Allocate();
+    CreateInstanceResource(group, capacity);
+
+    // パーティクルグループを登録
+    particleGroups[name] = group;
+
+    // 登録成功をデバッグ出力
+    OutputDebugStringA(("ParticleManager: Created particle group - " + name +
+        " (capacity " + std::to_string(capacity) + ")\n").c_str());
+}
+
+void ParticleManager::CreateInstanceResource(ParticleGroup& group, uint32_t instanceCapacity) {
+    // 作り直す場合、古いリソースは直前のフレームの描画で参照されているので1フレーム保持する
+    if (group.instanceResource) {
+        group.retiredInstanceResource = group.instanceResource;
+    }
+
+    // インスタンシング用リソースの作成
+    group.instanceResource = dxCommon_->CreateBufferResource(sizeof(ParticleForGPU) * instanceCapacity);
 
     // マップしてポインタを取得
     group.instanceResource->Map(0, nullptr, reinterpret_cast<void**>(&group.instanceData));
+    group.instanceCapacity = instanceCapacity;
 
-    // インスタンシング用SRVの作成
-    group.instanceSrvIndex = srvManager_->Allocate();
+    // インスタンシング用SRVの作成（同じインデックスに作り直すので描画側の変更は不要）
     srvManager_->CreateSRVForStructuredBuffer(
         group.instanceSrvIndex,
         group.instanceResource,
-        kMaxInstanceCount,
+        instanceCapacity,
         sizeof(ParticleForGPU));
+}
 
-    // パーティクルグループを登録
-    particleGroups[name] = group;
+uint32_t ParticleManager::ReserveParticleSlots(ParticleGroup& group, uint32_t count) {
+    uint32_t liveCount = group.particles.Size();
+    uint32_t required = liveCount + count;
+    if (required <= group.capacity) {
+        return count;
+    }
 
-    // 登録成功をデバッグ出力
-    OutputDebugStringA(("ParticleManager: Created particle group - " + name + "\n").c_str());
+    // 容量を増やす（倍々に増やして作り直しの回数を抑える）
+    // GPUリソースは描画中の可能性があるので、ここでは容量だけ変えて次のUpdateで作り直す
+    if (group.overflowPolicy == ParticleOverflowPolicy::Grow && group.capacity < group.maxCapacity) {
+        uint32_t newCapacity = (std::max)(group.capacity * 2, required);
+        group.capacity = (std::min)(newCapacity, group.maxCapacity);
+        group.particles.Reserve(group.capacity);
+        ++group.growCount;
+        if (required <= group.capacity) {
+            return count;
+        }
+    }
+
+    // 1回の発生数が容量を超える分は発生させない
+    uint32_t emitCount = (std::min)(count, group.capacity);
+    group.droppedCount += count - emitCount;
+
+    // 古いパーティクルを消して空きを作る（Growで上限に達した場合は既存のものを優先する）
+    uint32_t freeCount = group.capacity - liveCount;
+    if (emitCount > freeCount) {
+        if (group.overflowPolicy == ParticleOverflowPolicy::KillOldest) {
+            group.recycledCount += group.particles.KillOldest(emitCount - freeCount);
+        }
+        else {
+            group.droppedCount += emitCount - freeCount;
+            emitCount = freeCount;
+        }
+    }
+
+    return emitCount;
+}
+
+ParticleGroupStats ParticleManager::GetParticleGroupStats(const std::string& name) const {
+    ParticleGroupStats stats{};
+    auto it = particleGroups.find(name);
+    if (it == particleGroups.end()) {
+        return stats;
+    }
+
+    const ParticleGroup& group = it->second;
+    stats.capacity = group.capacity;
+    stats.instanceCapacity = group.instanceCapacity;
+    stats.liveCount = group.particles.Size();
+    stats.peakCount = group.peakCount;
+    stats.droppedCount = group.droppedCount;
+    stats.recycledCount = group.recycledCount;
+    stats.growCount = group.growCount;
+    stats.spatialHashBuildMilliseconds = group.spatialHashBuildMilliseconds;
+    stats.repulsionMilliseconds = group.repulsionMilliseconds;
+    stats.sortMilliseconds = group.sortMilliseconds;
+    stats.bounds = group.bounds;
+    stats.isCulled = group.isCulled;
+    stats.culledFrameCount = group.culledFrameCount;
+    return stats;
 }
 
 void ParticleManager::CalculateBillboardMatrix(const Camera* camera) {
@@ -279,86 +393,210 @@ void ParticleManager::CalculateBillboardMatrix(const Camera* camera) {
     billboardMatrix.m[2][2] = viewMatrix.m[2][2];
 }
 
-void ParticleManager::Update(const Camera* camera) {
+void ParticleManager::SetFixedTimeStep(float timeStep, uint32_t maxSubSteps) {
+    fixedTimeStep_ = timeStep;
+    maxSubSteps_ = (std::max)(maxSubSteps, 1u);
+    timeAccumulator_ = 0.0f;
+}
+
+void ParticleManager::Update(const Camera* camera, float deltaTime) {
     // ビルボード行列の計算
     CalculateBillboardMatrix(camera);
 
-    // ビュー行列、プロジェクション行列を取得
-    Matrix4x4 viewMatrix = camera->GetViewMatrix();
-    Matrix4x4 projectionMatrix = camera->GetProjectionMatrix();
-    Matrix4x4 viewProjectionMatrix = camera->GetViewProjectionMatrix();
+    // ビルボード変換の前計算（全パーティクルで共通）
+    billboardBasis = MakeBillboardBasis(billboardMatrix, camera->GetViewProjectionMatrix());
+
+    // 深度の並べ替え用にビュー行列を保持
+    viewMatrix_ = camera->GetViewMatrix();
+
+    // グループ単位のカリング用に視錐台を保持
+    frustum_ = camera->GetFrustum();
+
+    // 1ステップの時間とステップ数を決める
+    float stepTime = deltaTime;
+    uint32_t subStepCount = 1;
+    if (fixedTimeStep_ > 0.0f) {
+        // 経過時間を貯めて固定刻みで進める（端数は次のフレームに持ち越す）
+        timeAccumulator_ += deltaTime;
+        stepTime = fixedTimeStep_;
+        subStepCount = static_cast<uint32_t>(timeAccumulator_ / fixedTimeStep_);
+        if (subStepCount > maxSubSteps_) {
+            // 追いつけない分は捨てる（処理落ちがさらに処理落ちを呼ぶのを防ぐ）
+            subStepCount = maxSubSteps_;
+            timeAccumulator_ = 0.0f;
+        }
+        else {
+            timeAccumulator_ -= fixedTimeStep_ * subStepCount;
+        }
+    }
 
-    // 全パーティクルグループの更新
+    // 更新対象のグループを配列にまとめる（グループ単位で並列化するため）
+    std::vector<ParticleGroup*> groups;
+    groups.reserve(particleGroups.size());
     for (auto& [name, group] : particleGroups) {
-        // インスタンス数をリセット
-        group.instanceCount = 0;
+        // 前回作り直したときの古いリソースはもう参照されていないので解放する
+        group.retiredInstanceResource.Reset();
 
-        // 各パーティクルの更新
-        for (auto it = group.particles.begin(); it != group.particles.end(); ) {
-            // 寿命チェック
-            it->lifeTime += 1.0f / 60.0f; // 60FPS想定
-            if (it->lifeTime >= it->lifeTimeMax) {
-                // 寿命が尽きたら削除
-                it = group.particles.erase(it);
-                continue;
+        // Emitで容量が増えていればインスタンシングリソースを作り直す
+        // （前フレームの描画はDirectXCommon::Endでフェンスを待って完了している）
+        if (group.instanceCapacity < group.capacity) {
+            CreateInstanceResource(group, group.capacity);
+        }
+
+        groups.push_back(&group);
+    }
+
+    // 全パーティクルグループの更新（グループごとに並列、大きなグループは内部でさらに分割）
+    JobSystem::GetInstance()->ParallelFor(0, static_cast<uint32_t>(groups.size()), 1,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                UpdateParticleGroup(*groups[i], stepTime, subStepCount);
             }
+        });
+}
+
+void ParticleManager::UpdateParticleGroup(ParticleGroup& group, float deltaTime, uint32_t subStepCount) {
+    JobSystem* jobSystem = JobSystem::GetInstance();
+    ParticlePool& pool = group.particles;
+
+    // 力場・積分・寿命に応じた変化・衝突・反発を進める（計測値はこの更新の分だけを記録する）
+    ParticleSimulationTimings timings = SimulateParticles(pool, group.curves, group.forces, group.spatialHash, deltaTime, subStepCount);
+    group.spatialHashBuildMilliseconds = timings.spatialHashBuildMilliseconds;
+    group.repulsionMilliseconds = timings.repulsionMilliseconds;
+
+    // 生存数の最大値を記録
+    group.peakCount = (std::max)(group.peakCount, pool.Size());
+
+    // グループ全体が視錐台の外なら、並べ替えとインスタンシングデータの作成を省いて描画しない
+    group.bounds = pool.ComputeBounds(kParticleBoundsRadiusScale);
+    group.isCulled = !pool.Empty() && !IsAABBInFrustum(frustum_, group.bounds);
+    if (group.isCulled) {
+        ++group.culledFrameCount;
+        group.instanceCount = 0;
+        return;
+    }
+
+    // 書き込み数はインスタンシングリソースの容量で打ち切る（マップ先の範囲外に書かない）
+    assert(pool.Size() <= group.capacity);
+    uint32_t writeCount = (std::min)(pool.Size(), group.instanceCapacity);
+
+    // アルファブレンドのグループは奥から手前の順に並べ替える（前フレームの並び順を引き継ぐ）
+    const uint32_t* order = nullptr;
+    if (group.blendMode == ParticleBlendMode::Alpha) {
+        std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+        group.depthSorter.Sort(pool, viewMatrix_);
+        order = group.depthSorter.GetOrder().data();
+        group.sortMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - sortStart).count();
+    }
 
-            // パーティクルの更新
-            // 速度に加速度を加算
-            it->velocity.x += it->accel.x / 60.0f;
-            it->velocity.y += it->accel.y / 60.0f;
-            it->velocity.z += it->accel.z / 60.0f;
-
-            // 位置に速度を加算
-            it->position.x += it->velocity.x / 60.0f;
-            it->position.y += it->velocity.y / 60.0f;
-            it->position.z += it->velocity.z / 60.0f;
-
-            // 回転を更新
-            it->rotation += it->rotationVelocity / 60.0f;
-
-            // 線形補間でサイズと色を更新
-            float t = it->lifeTime / it->lifeTimeMax;
-            it->size = (1.0f - t) * it->startSize + t * it->endSize;
-
-            it->color.x = (1.0f - t) * it->startColor.x + t * it->endColor.x;
-            it->color.y = (1.0f - t) * it->startColor.y + t * it->endColor.y;
-            it->color.z = (1.0f - t) * it->startColor.z + t * it->endColor.z;
-            it->color.w = (1.0f - t) * it->startColor.w + t * it->endColor.w;
-
-            // スケール、回転、座標を使用して行列を作成
-            Vector3 scale = { it->size, it->size, it->size };
-            Vector3 rotate = { 0.0f, 0.0f, it->rotation };
-
-            // ワールド行列を計算（ビルボード処理も含む）
-            Matrix4x4 matScale = MakeScaleMatrix(scale);
-            Matrix4x4 matRotZ = MakeRotateZMatrix(rotate.z);
-
-            // スケール -> 回転 -> ビルボード -> 平行移動
-            Matrix4x4 matWorld = matScale;
-            matWorld = Multiply(matWorld, matRotZ);
-            matWorld = Multiply(matWorld, billboardMatrix);
-            matWorld.m[3][0] = it->position.x;
-            matWorld.m[3][1] = it->position.y;
-            matWorld.m[3][2] = it->position.z;
-
-            // WVP行列を計算
-            Matrix4x4 matWVP = Multiply(matWorld, viewProjectionMatrix);
-
-            // インスタンシングデータの書き込み（新しいシェーダー形式に合わせて）
-            group.instanceData[group.instanceCount].WVP = matWVP;
-            group.instanceData[group.instanceCount].World = matWorld;
-            group.instanceData[group.instanceCount].color = it->color;
-
-            // インスタンス数をインクリメント
-            group.instanceCount++;
-
-            // 次のパーティクルへ
-            ++it;
+    // インスタンシングデータの作成（各チャンクは自分の範囲のParticleForGPUだけを書き込む）
+    jobSystem->ParallelFor(0, writeCount, kParticleChunkSize,
+        [&](uint32_t begin, uint32_t end) {
+            WriteInstanceData(group, order, begin, end);
+        });
+
+    // インスタンス数を更新
+    group.instanceCount = writeCount;
+}
+
+void ParticleManager::WriteInstanceData(ParticleGroup& group, const uint32_t* order, uint32_t begin, uint32_t end) {
+    const ParticlePool& pool = group.particles;
+
+    // 回転のsinとcosはブロックごとにまとめて求める（FastMath::SinCosのSIMD版で4粒ずつ計算する）
+    const uint32_t kBlockSize = 64;
+    float rotations[kBlockSize];
+    float sins[kBlockSize];
+    float coses[kBlockSize];
+
+    for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += kBlockSize) {
+        uint32_t blockCount = (std::min)(kBlockSize, end - blockBegin);
+        for (uint32_t j = 0; j < blockCount; ++j) {
+            uint32_t k = blockBegin + j;
+            rotations[j] = pool.rotation[order ? order[k] : k];
+        }
+        FastMath::SinCos(std::span<const float>(rotations, blockCount), std::span<float>(sins, blockCount), std::span<float>(coses, blockCount));
+
+        for (uint32_t j = 0; j < blockCount; ++j) {
+            // 並べ替えている場合は並び順のk番目のパーティクルを書き込む
+            uint32_t k = blockBegin + j;
+            uint32_t i = order ? order[k] : k;
+
+            // スケール -> Z回転 -> ビルボード -> 平行移動 をまとめてWorld/WVP行列を作成
+            Vector3 position = { pool.positionX[i], pool.positionY[i], pool.positionZ[i] };
+            Matrix4x4 matWorld;
+            Matrix4x4 matWVP;
+            MakeBillboardTransform(billboardBasis, pool.size[i], sins[j], coses[j], position, matWorld, matWVP);
+
+            // インスタンシングデータの書き込み（マップ先はライトコンバインなので先頭から順に書く）
+            group.instanceData[k].WVP = matWVP;
+            group.instanceData[k].World = matWorld;
+            group.instanceData[k].color = { pool.colorR[i], pool.colorG[i], pool.colorB[i], pool.colorA[i] };
         }
     }
 }
 
+ParticleGroup* ParticleManager::FindParticleGroup(const std::string& name) {
+    auto it = particleGroups.find(name);
+    if (it == particleGroups.end()) {
+        OutputDebugStringA(("ParticleManager: Group not found - " + name + "\n").c_str());
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void ParticleManager::SetSizeOverLifetime(const std::string& name, const ParticleCurve& curve) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->curves.size.Bake(curve);
+        group->curves.hasSize = true;
+    }
+}
+
+void ParticleManager::SetColorOverLifetime(const std::string& name, const ParticleGradient& gradient) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->curves.color.Bake(gradient);
+        group->curves.hasColor = true;
+    }
+}
+
+void ParticleManager::SetRotationSpeedOverLifetime(const std::string& name, const ParticleCurve& curve) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->curves.rotationSpeed.Bake(curve);
+        group->curves.hasRotationSpeed = true;
+    }
+}
+
+void ParticleManager::SetDampingOverLifetime(const std::string& name, const ParticleCurve& curve) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->curves.damping.Bake(curve);
+        group->curves.hasDamping = true;
+    }
+}
+
+void ParticleManager::ClearLifetimeCurves(const std::string& name) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->curves = ParticleLifetimeCurves();
+    }
+}
+
+void ParticleManager::SetBlendMode(const std::string& name, ParticleBlendMode blendMode) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->blendMode = blendMode;
+        group->sortMilliseconds = 0.0f;
+    }
+}
+
+void ParticleManager::SetForceStage(const std::string& name, const ParticleForceStage& stage) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->forces = stage;
+    }
+}
+
+void ParticleManager::ClearForceStage(const std::string& name) {
+    if (ParticleGroup* group = FindParticleGroup(name)) {
+        group->forces = ParticleForceStage();
+    }
+}
+
 void ParticleManager::Emit(const std::string& name, const Vector3& position, uint32_t count) {
     // 詳細設定版のEmitを呼び出し
     Emit(
@@ -407,92 +645,99 @@ void ParticleManager::Emit(
     float rotationVelocityMin,
     float rotationVelocityMax,
     float lifeTimeMin,
-    float lifeTimeMax) {
+    float lifeTimeMax,
+    float preAgeTime) {
 
     // 指定された名前のパーティクルグループが存在するか確認
     auto it = particleGroups.find(name);
     assert(it != particleGroups.end());
 
-    // 均等分布乱数生成器
-    std::uniform_real_distribution<float> velocityDistX(velocityMin.x, velocityMax.x);
-    std::uniform_real_distribution<float> velocityDistY(velocityMin.y, velocityMax.y);
-    std::uniform_real_distribution<float> velocityDistZ(velocityMin.z, velocityMax.z);
-
-    std::uniform_real_distribution<float> accelDistX(accelMin.x, accelMax.x);
-    std::uniform_real_distribution<float> accelDistY(accelMin.y, accelMax.y);
-    std::uniform_real_distribution<float> accelDistZ(accelMin.z, accelMax.z);
-
-    std::uniform_real_distribution<float> startSizeDist(startSizeMin, startSizeMax);
-    std::uniform_real_distribution<float> endSizeDist(endSizeMin, endSizeMax);
-
-    std::uniform_real_distribution<float> startColorDistR(startColorMin.x, startColorMax.x);
-    std::uniform_real_distribution<float> startColorDistG(startColorMin.y, startColorMax.y);
-    std::uniform_real_distribution<float> startColorDistB(startColorMin.z, startColorMax.z);
-    std::uniform_real_distribution<float> startColorDistA(startColorMin.w, startColorMax.w);
-
-    std::uniform_real_distribution<float> endColorDistR(endColorMin.x, endColorMax.x);
-    std::uniform_real_distribution<float> endColorDistG(endColorMin.y, endColorMax.y);
-    std::uniform_real_distribution<float> endColorDistB(endColorMin.z, endColorMax.z);
-    std::uniform_real_distribution<float> endColorDistA(endColorMin.w, endColorMax.w);
-
-    std::uniform_real_distribution<float> rotationDist(rotationMin, rotationMax);
-    std::uniform_real_distribution<float> rotationVelocityDist(rotationVelocityMin, rotationVelocityMax);
-
-    std::uniform_real_distribution<float> lifeTimeDist(lifeTimeMin, lifeTimeMax);
-
-    // 指定された数のパーティクルを生成
-    for (uint32_t i = 0; i < count; ++i) {
-        Particle particle;
-
-        // 座標
-        particle.position = position;
-
-        // 速度（ランダム）
-        particle.velocity.x = velocityDistX(randomEngine_);
-        particle.velocity.y = velocityDistY(randomEngine_);
-        particle.velocity.z = velocityDistZ(randomEngine_);
-
-        // 加速度（ランダム）
-        particle.accel.x = accelDistX(randomEngine_);
-        particle.accel.y = accelDistY(randomEngine_);
-        particle.accel.z = accelDistZ(randomEngine_);
-
-        // サイズ（ランダム）
-        particle.startSize = startSizeDist(randomEngine_);
-        particle.endSize = endSizeDist(randomEngine_);
-        particle.size = particle.startSize;
-
-        // 色（ランダム）
-        particle.startColor.x = startColorDistR(randomEngine_);
-        particle.startColor.y = startColorDistG(randomEngine_);
-        particle.startColor.z = startColorDistB(randomEngine_);
-        particle.startColor.w = startColorDistA(randomEngine_);
-
-        particle.endColor.x = endColorDistR(randomEngine_);
-        particle.endColor.y = endColorDistG(randomEngine_);
-        particle.endColor.z = endColorDistB(randomEngine_);
-        particle.endColor.w = endColorDistA(randomEngine_);
+    // 容量を超える場合は古いものを消すか容量を増やす（発生できない分は数を減らす）
+    ParticleGroup& group = it->second;
+    count = ReserveParticleSlots(group, count);
+    if (count == 0) {
+        return;
+    }
 
-        particle.color = particle.startColor;
+    // 末尾にまとめて領域を追加し、属性ごとに連続した配列へ一気に書き込む
+    ParticlePool& pool = group.particles;
+    uint32_t first = pool.Append(count);
+    ParticleRandom& random = group.random;
+
+    // 座標
+    std::fill_n(&pool.positionX[first], count, position.x);
+    std::fill_n(&pool.positionY[first], count, position.y);
+    std::fill_n(&pool.positionZ[first], count, position.z);
+
+    // 速度（ランダム）
+    random.FillUniform(&pool.velocityX[first], count, velocityMin.x, velocityMax.x);
+    random.FillUniform(&pool.velocityY[first], count, velocityMin.y, velocityMax.y);
+    random.FillUniform(&pool.velocityZ[first], count, velocityMin.z, velocityMax.z);
+
+    // 加速度（ランダム）
+    random.FillUniform(&pool.accelX[first], count, accelMin.x, accelMax.x);
+    random.FillUniform(&pool.accelY[first], count, accelMin.y, accelMax.y);
+    random.FillUniform(&pool.accelZ[first], count, accelMin.z, accelMax.z);
+
+    // サイズ（ランダム、現在サイズは初期サイズから始める）
+    random.FillUniform(&pool.startSize[first], count, startSizeMin, startSizeMax);
+    random.FillUniform(&pool.endSize[first], count, endSizeMin, endSizeMax);
+    std::copy_n(&pool.startSize[first], count, &pool.size[first]);
+
+    // 色（ランダム、現在色は初期色から始める）
+    random.FillUniform(&pool.startColorR[first], count, startColorMin.x, startColorMax.x);
+    random.FillUniform(&pool.startColorG[first], count, startColorMin.y, startColorMax.y);
+    random.FillUniform(&pool.startColorB[first], count, startColorMin.z, startColorMax.z);
+    random.FillUniform(&pool.startColorA[first], count, startColorMin.w, startColorMax.w);
+
+    random.FillUniform(&pool.endColorR[first], count, endColorMin.x, endColorMax.x);
+    random.FillUniform(&pool.endColorG[first], count, endColorMin.y, endColorMax.y);
+    random.FillUniform(&pool.endColorB[first], count, endColorMin.z, endColorMax.z);
+    random.FillUniform(&pool.endColorA[first], count, endColorMin.w, endColorMax.w);
+
+    std::copy_n(&pool.startColorR[first], count, &pool.colorR[first]);
+    std::copy_n(&pool.startColorG[first], count, &pool.colorG[first]);
+    std::copy_n(&pool.startColorB[first], count, &pool.colorB[first]);
+    std::copy_n(&pool.startColorA[first], count, &pool.colorA[first]);
+
+    // 回転（ランダム）
+    random.FillUniform(&pool.rotation[first], count, rotationMin, rotationMax);
+    random.FillUniform(&pool.rotationVelocity[first], count, rotationVelocityMin, rotationVelocityMax);
+
+    // 寿命（ランダム）
+    random.FillUniform(&pool.lifeTimeMax[first], count, lifeTimeMin, lifeTimeMax);
+    std::fill_n(&pool.lifeTime[first], count, 0.0f);
+
+    // フレームの途中で発生した分は、発生してから経過した時間だけ更新と同じ処理（力場・積分・寿命に応じた変化・衝突）で進めておく
+    // パーティクル同士の反発は全パーティクルの空間ハッシュが必要なので行わず、次の更新から効く
+    // （寿命を超えたものは次の更新で削除される）
+    if (preAgeTime > 0.0f) {
+        StepParticles(pool, group.curves, group.forces, first, first + count, preAgeTime);
+    }
+}
 
-        // 回転（ランダム）
-        particle.rotation = rotationDist(randomEngine_);
-        particle.rotationVelocity = rotationVelocityDist(randomEngine_);
+void ParticleManager::SetRandomSeed(uint64_t seed) {
+    randomSeed_ = seed;
 
-        // 寿命（ランダム）
-        particle.lifeTimeMax = lifeTimeDist(randomEngine_);
-        particle.lifeTime = 0.0f;
+    // 既存のグループもグループ名と新しいシードから初期化し直す
+    for (auto& [name, group] : particleGroups) {
+        group.random.Seed(ParticleRandom::MakeSeed(name.c_str(), randomSeed_));
+    }
+}
 
-        // パーティクルリストに追加
-        it->second.particles.push_back(particle);
+void ParticleManager::SetParticleGroupSeed(const std::string& name, uint64_t seed) {
+    auto it = particleGroups.find(name);
+    if (it == particleGroups.end()) {
+        return;
     }
+    it->second.random.Seed(seed);
 }
 
 void ParticleManager::Draw() {
     // パーティクルがない場合は描画しない
     bool hasParticles = false;
     for (auto& [name, group] : particleGroups) {
-        if (!group.particles.empty()) {
+        if (!group.particles.Empty()) {
             hasParticles = true;
             break;
         }
@@ -521,10 +766,14 @@ void ParticleManager::Draw() {
     // 各パーティクルグループの描画
     for (auto& [name, group] : particleGroups) {
         // パーティクルがない場合はスキップ
-        if (group.particles.empty() || group.instanceCount == 0) {
+        if (group.particles.Empty() || group.instanceCount == 0) {
             continue;
         }
 
+        // ブレンド方法に応じたパイプラインステートをセット
+        commandList->SetPipelineState(
+            group.blendMode == ParticleBlendMode::Alpha ? alphaPipelineState.Get() : pipelineState.Get());
+
         // テクスチャをセット（ピクセルシェーダー用）
         srvManager_->SetGraphicsRootDescriptorTable(2, group.textureSrvIndex);
 
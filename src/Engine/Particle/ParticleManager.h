@@ -2,51 +2,23 @@
 
 #include <unordered_map>
 #include <string>
-#include <list>
-#include <random>
 #include <memory>
 #include "DirectXCommon.h"
 #include "SRVManager.h"
 #include "Vector3.h"
 #include "Mymath.h"
 #include "Camera.h"
+#include "ParticlePool.h"
+#include "ParticleRandom.h"
+#include "ParticleCurve.h"
+#include "ParticleForceField.h"
+#include "ParticleSpatialHash.h"
+#include "ParticleDepthSort.h"
+#include "BillboardTransform.h"
 
 // 前方宣言
 class ParticleEmitter;
 
-// パーティクル1粒の情報
-struct Particle {
-    // 座標
-    Vector3 position;
-    // 速度
-    Vector3 velocity;
-    // 加速度
-    Vector3 accel;
-    // 色
-    Vector4 color;
-    // 初期サイズ
-    float startSize;
-    // 最終サイズ
-    float endSize;
-    // 現在サイズ
-    float size;
-    // 初期色
-    Vector4 startColor;
-    // 最終色
-    Vector4 endColor;
-    // 回転
-    float rotation;
-    // 回転速度
-    float rotationVelocity;
-    // 経過時間
-    float lifeTime;
-    // 寿命
-    float lifeTimeMax;
-
-    // 生存フラグ
-    bool isDead = false;
-};
-
 // インスタンシング描画用データ
 struct ParticleForGPU {
     // WVP行列
@@ -57,14 +29,74 @@ struct ParticleForGPU {
     Vector4 color;
 };
 
+// 容量いっぱいのグループに発生させたときの挙動
+enum class ParticleOverflowPolicy {
+    KillOldest, // 寿命の進んだパーティクルを消して新しいものに置き換える
+    Grow,       // 最大容量まで容量を増やす（GPUリソースは次の更新で作り直す）
+};
+
+// パーティクルグループのブレンド方法
+enum class ParticleBlendMode {
+    Add,   // 加算合成（並べ替え不要）
+    Alpha, // アルファブレンド（奥から手前の順に並べ替えて描画する）
+};
+
+// パーティクルグループの統計情報（デバッグ・調整用）
+struct ParticleGroupStats {
+    // 容量（CPU側で保持できる最大数）
+    uint32_t capacity;
+    // インスタンシングリソースの容量
+    uint32_t instanceCapacity;
+    // 現在の生存数
+    uint32_t liveCount;
+    // 生存数の最大値
+    uint32_t peakCount;
+    // 容量不足で発生できなかった数（累計）
+    uint64_t droppedCount;
+    // 新しいパーティクルのために消した古いパーティクルの数（累計）
+    uint64_t recycledCount;
+    // 容量を増やした回数（累計）
+    uint32_t growCount;
+    // 直前の更新での空間ハッシュの構築時間（ミリ秒）
+    float spatialHashBuildMilliseconds;
+    // 直前の更新でのパーティクル同士の反発の計算時間（ミリ秒）
+    float repulsionMilliseconds;
+    // 直前の更新での深度の並べ替えの時間（ミリ秒）
+    float sortMilliseconds;
+    // 直前の更新でのグループ全体の境界
+    AABB bounds;
+    // 直前の更新で視錐台の外にあったか
+    bool isCulled;
+    // 視錐台の外で描画しなかったフレーム数（累計）
+    uint64_t culledFrameCount;
+};
+
 // パーティクルグループ（テクスチャごとにグループ化）
 struct ParticleGroup {
     // マテリアルデータ（テクスチャファイルパスとテクスチャのSRVインデックス）
     std::string textureFilePath;
     uint32_t textureSrvIndex;
 
-    // パーティクルのリスト
-    std::list<Particle> particles;
+    // パーティクルのプール（SoA形式）
+    ParticlePool particles;
+
+    // 発生用の乱数生成器（グループごとに独立しているので発生順が他のグループに影響しない）
+    ParticleRandom random;
+
+    // 寿命に応じた変化（曲線を焼き込んだテーブル）
+    ParticleLifetimeCurves curves;
+
+    // 力場と衝突の設定
+    ParticleForceStage forces;
+
+    // パーティクル同士の反発用の空間ハッシュ（反発が有効なときだけ毎ステップ作り直す）
+    ParticleSpatialHash spatialHash;
+
+    // ブレンド方法
+    ParticleBlendMode blendMode;
+
+    // 深度の並べ替え（アルファブレンドのときだけ使う、並び順は次のフレームに引き継ぐ）
+    ParticleDepthSorter depthSorter;
 
     // インスタンシングデータのSRVインデックス
     uint32_t instanceSrvIndex;
@@ -77,6 +109,35 @@ struct ParticleGroup {
 
     // インスタンシングデータを書き込むためのポインタ
     ParticleForGPU* instanceData;
+
+    // インスタンシングリソースの容量（instanceDataに書き込める最大数）
+    uint32_t instanceCapacity;
+
+    // 作り直す前のインスタンシングリソース（GPUが参照し終わるまで1フレーム保持する）
+    Microsoft::WRL::ComPtr<ID3D12Resource> retiredInstanceResource;
+
+    // 容量（パーティクル数はこれを超えない）
+    uint32_t capacity;
+
+    // Growで増やせる最大容量
+    uint32_t maxCapacity;
+
+    // 容量を超えたときの挙動
+    ParticleOverflowPolicy overflowPolicy;
+
+    // 統計情報
+    uint32_t peakCount;
+    uint64_t droppedCount;
+    uint64_t recycledCount;
+    uint32_t growCount;
+    float spatialHashBuildMilliseconds;
+    float repulsionMilliseconds;
+    float sortMilliseconds;
+
+    // グループ全体の境界（視錐台の外ならインスタンシングデータを作らず描画もしない）
+    AABB bounds;
+    bool isCulled;
+    uint64_t culledFrameCount;
 };
 
 // パーティクルマネージャクラス
@@ -88,8 +149,17 @@ private:
     // SRVマネージャ
     SrvManager* srvManager_ = nullptr;
 
-    // 乱数生成器
-    std::mt19937 randomEngine_;
+    // 固定タイムステップの刻み幅（0以下なら渡された経過時間でそのまま1回更新する）
+    float fixedTimeStep_ = 0.0f;
+
+    // 1回のUpdateで進める最大ステップ数（処理落ち時に更新が追いつかなくなるのを防ぐ）
+    uint32_t maxSubSteps_ = 4;
+
+    // 固定タイムステップ用の未処理時間
+    float timeAccumulator_ = 0.0f;
+
+    // 乱数の基準シード（各グループのシードはグループ名と組み合わせて作る）
+    uint64_t randomSeed_ = 0;
 
     // パーティクルグループコンテナ
     std::unordered_map<std::string, ParticleGroup> particleGroups;
@@ -97,9 +167,12 @@ private:
     // 描画用ルートシグネチャ
     Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
 
-    // 描画用パイプラインステート
+    // 描画用パイプラインステート（加算合成）
     Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
 
+    // 描画用パイプラインステート（アルファブレンド）
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> alphaPipelineState;
+
     // 頂点バッファビュー
     D3D12_VERTEX_BUFFER_VIEW vbView;
 
@@ -117,6 +190,15 @@ private:
     // ビルボード行列
     Matrix4x4 billboardMatrix;
 
+    // ビルボード変換の前計算データ（ビルボード行列とビュープロジェクション行列から作成）
+    BillboardBasis billboardBasis;
+
+    // ビュー行列（深度の並べ替え用）
+    Matrix4x4 viewMatrix_;
+
+    // カメラの視錐台（グループ単位のカリング用）
+    Frustum frustum_;
+
     // コピー禁止
     ParticleManager(const ParticleManager&) = delete;
     ParticleManager& operator=(const ParticleManager&) = delete;
@@ -134,6 +216,24 @@ private:
     // ビルボード行列の計算
     void CalculateBillboardMatrix(const Camera* camera);
 
+    // パーティクルグループ1つ分の更新（チャンク単位で並列処理する）
+    // deltaTimeずつsubStepCount回進めてから、インスタンシングデータを1回だけ書き込む
+    void UpdateParticleGroup(ParticleGroup& group, float deltaTime, uint32_t subStepCount);
+
+    // インスタンシングデータの書き込み（[begin, end)の範囲だけを書き込む）
+    // orderがあれば、k番目のインスタンスにorder[k]番目のパーティクルを書き込む
+    void WriteInstanceData(ParticleGroup& group, const uint32_t* order, uint32_t begin, uint32_t end);
+
+    // 名前からパーティクルグループを探す（見つからなければnullptr）
+    ParticleGroup* FindParticleGroup(const std::string& name);
+
+    // インスタンシングリソースの作成（SRVはgroup.instanceSrvIndexの位置に作る）
+    void CreateInstanceResource(ParticleGroup& group, uint32_t instanceCapacity);
+
+    // 容量を超える分の発生数を調整する（古いものを消す・容量を増やす・発生数を減らす）
+    // 実際に発生させる数を返す
+    uint32_t ReserveParticleSlots(ParticleGroup& group, uint32_t count);
+
     // フレンドクラス
     friend class ParticleEmitter;
 
@@ -143,6 +243,12 @@ private:
     ~ParticleManager() = default;
 
 public:
+    // パーティクルグループの容量の既定値
+    static const uint32_t kDefaultParticleCapacity = 1024;
+
+    // Growで増やせる容量の既定値
+    static const uint32_t kDefaultMaxParticleCapacity = 65536;
+
     // シングルトンインスタンスの取得
     static ParticleManager* GetInstance() {
         // スレッドセーフなMeyer'sシングルトンパターン
@@ -159,19 +265,60 @@ public:
     // 初期化
     void Initialize(DirectXCommon* dxCommon, SrvManager* srvManager);
 
-    // 更新
-    void Update(const Camera* camera);
+    // 更新（deltaTimeは前フレームからの経過時間（秒））
+    void Update(const Camera* camera, float deltaTime);
+
+    // 固定タイムステップの設定（timeStepが0以下なら可変ステップ）
+    // 経過時間を貯めてtimeStep刻みで進め、1回のUpdateではmaxSubSteps回までに抑える
+    void SetFixedTimeStep(float timeStep, uint32_t maxSubSteps = 4);
 
     // 描画
     void Draw();
 
     // パーティクルグループの作成
-    void CreateParticleGroup(const std::string& name, const std::string& textureFilePath);
+    // capacityは同時に存在できるパーティクル数、maxCapacityはGrow時に増やせる上限
+    void CreateParticleGroup(
+        const std::string& name,
+        const std::string& textureFilePath,
+        uint32_t capacity = kDefaultParticleCapacity,
+        ParticleOverflowPolicy overflowPolicy = ParticleOverflowPolicy::Grow,
+        uint32_t maxCapacity = kDefaultMaxParticleCapacity);
+
+    // 乱数の基準シードの設定（既存の全グループの乱数列も初期化し直す）
+    void SetRandomSeed(uint64_t seed);
+
+    // パーティクルグループの乱数シードの設定（リプレイ時の再現用）
+    void SetParticleGroupSeed(const std::string& name, uint64_t seed);
+
+    // 寿命に応じたサイズの倍率の設定
+    void SetSizeOverLifetime(const std::string& name, const ParticleCurve& curve);
+
+    // 寿命に応じた色の倍率の設定
+    void SetColorOverLifetime(const std::string& name, const ParticleGradient& gradient);
+
+    // 寿命に応じた回転速度の倍率の設定
+    void SetRotationSpeedOverLifetime(const std::string& name, const ParticleCurve& curve);
+
+    // 寿命に応じた速度の減衰率（1秒あたり）の設定
+    void SetDampingOverLifetime(const std::string& name, const ParticleCurve& curve);
+
+    // 寿命に応じた変化をすべて解除する
+    void ClearLifetimeCurves(const std::string& name);
+
+    // ブレンド方法の設定（Alphaにすると毎フレーム奥から手前の順に並べ替えて描画する）
+    void SetBlendMode(const std::string& name, ParticleBlendMode blendMode);
+
+    // 力場・衝突・パーティクル同士の反発の設定
+    void SetForceStage(const std::string& name, const ParticleForceStage& stage);
+
+    // 力場・衝突・パーティクル同士の反発をすべて解除する
+    void ClearForceStage(const std::string& name);
 
     // パーティクルの発生（シンプル版）
     void Emit(const std::string& name, const Vector3& position, uint32_t count);
 
     // パーティクルの発生（詳細設定版）
+    // preAgeTimeを指定すると、発生してからその時間が経過した状態まで更新と同じ1ステップ（反発を除く）で進めてから追加する
     void Emit(
         const std::string& name,
         const Vector3& position,
@@ -193,17 +340,21 @@ public:
         float rotationVelocityMin,
         float rotationVelocityMax,
         float lifeTimeMin,
-        float lifeTimeMax);
+        float lifeTimeMax,
+        float preAgeTime = 0.0f);
 
     // デバッグ用：パーティクル数の取得
     uint32_t GetParticleCount(const std::string& name) {
         auto it = particleGroups.find(name);
         if (it != particleGroups.end()) {
-            return static_cast<uint32_t>(it->second.particles.size());
+            return it->second.particles.Size();
         }
         return 0;
     }
 
+    // デバッグ用：パーティクルグループの統計情報の取得
+    ParticleGroupStats GetParticleGroupStats(const std::string& name) const;
+
     // デバッグ用：シンプルな四角形を描画
     void DrawSimpleQuad();
 };
\ No newline at end of file
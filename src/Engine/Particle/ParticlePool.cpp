@@ -0,0 +1,162 @@
+#include "ParticlePool.h"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+void ParticlePool::Reserve(uint32_t capacity) {
+    ForEachColumn([capacity](std::vector<float>& column) { column.reserve(capacity); });
+}
+
+void ParticlePool::Clear() {
+    ForEachColumn([](std::vector<float>& column) { column.clear(); });
+}
+
+uint32_t ParticlePool::Add(const Particle& particle) {
+    uint32_t index = Size();
+
+    positionX.push_back(particle.position.x);
+    positionY.push_back(particle.position.y);
+    positionZ.push_back(particle.position.z);
+
+    velocityX.push_back(particle.velocity.x);
+    velocityY.push_back(particle.velocity.y);
+    velocityZ.push_back(particle.velocity.z);
+
+    accelX.push_back(particle.accel.x);
+    accelY.push_back(particle.accel.y);
+    accelZ.push_back(particle.accel.z);
+
+    colorR.push_back(particle.color.x);
+    colorG.push_back(particle.color.y);
+    colorB.push_back(particle.color.z);
+    colorA.push_back(particle.color.w);
+
+    startColorR.push_back(particle.startColor.x);
+    startColorG.push_back(particle.startColor.y);
+    startColorB.push_back(particle.startColor.z);
+    startColorA.push_back(particle.startColor.w);
+
+    endColorR.push_back(particle.endColor.x);
+    endColorG.push_back(particle.endColor.y);
+    endColorB.push_back(particle.endColor.z);
+    endColorA.push_back(particle.endColor.w);
+
+    size.push_back(particle.size);
+    startSize.push_back(particle.startSize);
+    endSize.push_back(particle.endSize);
+
+    rotation.push_back(particle.rotation);
+    rotationVelocity.push_back(particle.rotationVelocity);
+
+    lifeTime.push_back(particle.lifeTime);
+    lifeTimeMax.push_back(particle.lifeTimeMax);
+
+    return index;
+}
+
+uint32_t ParticlePool::Append(uint32_t count) {
+    uint32_t index = Size();
+    uint32_t newSize = index + count;
+    ForEachColumn([newSize](std::vector<float>& column) { column.resize(newSize); });
+    return index;
+}
+
+void ParticlePool::Kill(uint32_t index) {
+    assert(index < Size());
+
+    // 末尾の要素を削除位置に移動してから末尾を落とす
+    ForEachColumn([index](std::vector<float>& column) {
+        column[index] = column.back();
+        column.pop_back();
+    });
+}
+
+uint32_t ParticlePool::KillExpired() {
+    // 1粒ずつKillすると1粒ごとに全属性配列を行き来するので、先に穴埋めの移動を決めてから属性配列ごとにまとめて適用する
+    // 移動の決め方はKillを先頭から繰り返した場合と同じ（穴は末尾の生きている要素で埋める）
+    uint32_t count = Size();
+    uint32_t aliveCount = count;
+    killMoves_.clear();
+    for (uint32_t i = 0; i < aliveCount; ++i) {
+        if (lifeTime[i] < lifeTimeMax[i]) {
+            continue;
+        }
+        // 末尾側の寿命が尽きたものは移動せずにそのまま落とす
+        --aliveCount;
+        while (aliveCount > i && lifeTime[aliveCount] >= lifeTimeMax[aliveCount]) {
+            --aliveCount;
+        }
+        if (aliveCount > i) {
+            killMoves_.push_back({ i, aliveCount });
+        }
+    }
+    if (aliveCount == count) {
+        return 0;
+    }
+
+    ForEachColumn([this, aliveCount](std::vector<float>& column) {
+        for (const KillMove& move : killMoves_) {
+            column[move.to] = column[move.from];
+        }
+        column.resize(aliveCount);
+    });
+    return count - aliveCount;
+}
+
+uint32_t ParticlePool::KillOldest(uint32_t count) {
+    count = (std::min)(count, Size());
+    if (count == 0) {
+        return 0;
+    }
+
+    // 寿命の進み具合が大きい順に並べた先頭count個を選ぶ（全体のソートはしない）
+    std::vector<uint32_t> indices(Size());
+    for (uint32_t i = 0; i < Size(); ++i) {
+        indices[i] = i;
+    }
+    auto isOlder = [this](uint32_t a, uint32_t b) {
+        return lifeTime[a] * lifeTimeMax[b] > lifeTime[b] * lifeTimeMax[a];
+    };
+    std::nth_element(indices.begin(), indices.begin() + (count - 1), indices.end(), isOlder);
+
+    // 添字の大きい順に削除すれば、末尾から移動してくる要素は削除対象に含まれない
+    std::sort(indices.begin(), indices.begin() + count, std::greater<uint32_t>());
+    for (uint32_t i = 0; i < count; ++i) {
+        Kill(indices[i]);
+    }
+    return count;
+}
+
+AABB ParticlePool::ComputeBounds(float radiusScale) const {
+    AABB bounds = MakeEmptyAABB();
+    for (uint32_t i = 0; i < Size(); ++i) {
+        float radius = size[i] * radiusScale;
+        bounds.min.x = (std::min)(bounds.min.x, positionX[i] - radius);
+        bounds.min.y = (std::min)(bounds.min.y, positionY[i] - radius);
+        bounds.min.z = (std::min)(bounds.min.z, positionZ[i] - radius);
+        bounds.max.x = (std::max)(bounds.max.x, positionX[i] + radius);
+        bounds.max.y = (std::max)(bounds.max.y, positionY[i] + radius);
+        bounds.max.z = (std::max)(bounds.max.z, positionZ[i] + radius);
+    }
+    return bounds;
+}
+
+Particle ParticlePool::Get(uint32_t index) const {
+    assert(index < Size());
+
+    Particle particle;
+    particle.position = { positionX[index], positionY[index], positionZ[index] };
+    particle.velocity = { velocityX[index], velocityY[index], velocityZ[index] };
+    particle.accel = { accelX[index], accelY[index], accelZ[index] };
+    particle.color = { colorR[index], colorG[index], colorB[index], colorA[index] };
+    particle.startColor = { startColorR[index], startColorG[index], startColorB[index], startColorA[index] };
+    particle.endColor = { endColorR[index], endColorG[index], endColorB[index], endColorA[index] };
+    particle.size = size[index];
+    particle.startSize = startSize[index];
+    particle.endSize = endSize[index];
+    particle.rotation = rotation[index];
+    particle.rotationVelocity = rotationVelocity[index];
+    particle.lifeTime = lifeTime[index];
+    particle.lifeTimeMax = lifeTimeMax[index];
+    return particle;
+}
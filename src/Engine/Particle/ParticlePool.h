@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Bounds.h"
+
+// パーティクル1粒の情報（発生時の受け渡し用）
+struct Particle {
+    // 座標
+    Vector3 position;
+    // 速度
+    Vector3 velocity;
+    // 加速度
+    Vector3 accel;
+    // 色
+    Vector4 color;
+    // 初期サイズ
+    float startSize;
+    // 最終サイズ
+    float endSize;
+    // 現在サイズ
+    float size;
+    // 初期色
+    Vector4 startColor;
+    // 最終色
+    Vector4 endColor;
+    // 回転
+    float rotation;
+    // 回転速度
+    float rotationVelocity;
+    // 経過時間
+    float lifeTime;
+    // 寿命
+    float lifeTimeMax;
+
+    // 生存フラグ
+    bool isDead = false;
+};
+
+// パーティクルプール（属性ごとに連続した配列で保持するSoA形式）
+// 削除は末尾要素との入れ替えで行うため、並び順は保証しない
+struct ParticlePool {
+    // 座標
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> positionZ;
+    // 速度
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> velocityZ;
+    // 加速度
+    std::vector<float> accelX;
+    std::vector<float> accelY;
+    std::vector<float> accelZ;
+    // 色
+    std::vector<float> colorR;
+    std::vector<float> colorG;
+    std::vector<float> colorB;
+    std::vector<float> colorA;
+    // 初期色
+    std::vector<float> startColorR;
+    std::vector<float> startColorG;
+    std::vector<float> startColorB;
+    std::vector<float> startColorA;
+    // 最終色
+    std::vector<float> endColorR;
+    std::vector<float> endColorG;
+    std::vector<float> endColorB;
+    std::vector<float> endColorA;
+    // サイズ
+    std::vector<float> size;
+    std::vector<float> startSize;
+    std::vector<float> endSize;
+    // 回転
+    std::vector<float> rotation;
+    std::vector<float> rotationVelocity;
+    // 経過時間・寿命
+    std::vector<float> lifeTime;
+    std::vector<float> lifeTimeMax;
+
+    // 生存数の取得
+    uint32_t Size() const { return static_cast<uint32_t>(lifeTime.size()); }
+
+    // 空かどうか
+    bool Empty() const { return lifeTime.empty(); }
+
+    // 容量の予約
+    void Reserve(uint32_t capacity);
+
+    // 全パーティクルの削除
+    void Clear();
+
+    // パーティクルの追加（追加先のインデックスを返す）
+    uint32_t Add(const Particle& particle);
+
+    // 末尾にcount個分の領域を追加（追加した先頭のインデックスを返す）
+    // 値は未設定なので、呼び出し側で全属性を書き込むこと
+    uint32_t Append(uint32_t count);
+
+    // パーティクルの削除（末尾の要素を移動して穴を埋める）
+    void Kill(uint32_t index);
+
+    // 寿命が尽きたパーティクルをまとめて削除（削除数を返す）
+    uint32_t KillExpired();
+
+    // 寿命の進み具合（経過時間/寿命）が大きいものから指定数を削除（削除数を返す）
+    uint32_t KillOldest(uint32_t count);
+
+    // 1粒分の情報を取得
+    Particle Get(uint32_t index) const;
+
+    // 各パーティクルを半径 size * radiusScale の球とみなして、全体を含むAABBを求める（空なら空のAABB）
+    AABB ComputeBounds(float radiusScale) const;
+
+private:
+    // KillExpiredでの穴埋めの移動（fromの要素をtoに移す）
+    struct KillMove {
+        uint32_t to;
+        uint32_t from;
+    };
+    // 毎フレームの確保を避けるため使い回す
+    std::vector<KillMove> killMoves_;
+
+    // 全属性配列に同じ処理を適用する
+    template<typename Func>
+    void ForEachColumn(Func func) {
+        std::vector<float>* columns[] = {
+            &positionX, &positionY, &positionZ,
+            &velocityX, &velocityY, &velocityZ,
+            &accelX, &accelY, &accelZ,
+            &colorR, &colorG, &colorB, &colorA,
+            &startColorR, &startColorG, &startColorB, &startColorA,
+            &endColorR, &endColorG, &endColorB, &endColorA,
+            &size, &startSize, &endSize,
+            &rotation, &rotationVelocity,
+            &lifeTime, &lifeTimeMax,
+        };
+        for (std::vector<float>* column : columns) {
+            func(*column);
+        }
+    }
+};
@@ -0,0 +1,108 @@
+#include "ParticleRandom.h"
+
+namespace {
+// シード展開用（splitmix64）
+uint64_t SplitMix64(uint64_t& x) {
+    x += 0x9E3779B97F4A7C15ull;
+    uint64_t z = x;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// 上位24bitを[0, 1)の浮動小数点数に変換
+// 24bit以下なので符号付き整数経由で変換してもよく、その方がSIMD化しやすい
+inline float ToUnitFloat(uint32_t x) {
+    return static_cast<float>(static_cast<int32_t>(x >> 8)) * (1.0f / 16777216.0f);
+}
+}
+
+ParticleRandom::ParticleRandom(uint64_t seed) {
+    Seed(seed);
+}
+
+void ParticleRandom::Seed(uint64_t seed) {
+    // splitmix64でレーンごとの状態を作る（全て0の状態は周期が壊れるので避ける）
+    uint64_t x = seed;
+    for (uint32_t lane = 0; lane < kLaneCount; ++lane) {
+        uint64_t a = SplitMix64(x);
+        uint64_t b = SplitMix64(x);
+        state0_[lane] = static_cast<uint32_t>(a);
+        state1_[lane] = static_cast<uint32_t>(a >> 32);
+        state2_[lane] = static_cast<uint32_t>(b);
+        state3_[lane] = static_cast<uint32_t>(b >> 32);
+        if ((state0_[lane] | state1_[lane] | state2_[lane] | state3_[lane]) == 0) {
+            state0_[lane] = 1;
+        }
+    }
+
+    // バッファは空にしておく
+    bufferIndex_ = kLaneCount;
+}
+
+void ParticleRandom::Step(uint32_t out[kLaneCount]) {
+    // xoshiro128+（レーン方向のループはそのままSIMD化される）
+    for (uint32_t lane = 0; lane < kLaneCount; ++lane) {
+        uint32_t s0 = state0_[lane];
+        uint32_t s1 = state1_[lane];
+        uint32_t s2 = state2_[lane];
+        uint32_t s3 = state3_[lane];
+
+        out[lane] = s0 + s3;
+
+        uint32_t t = s1 << 9;
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = (s3 << 11) | (s3 >> 21);
+
+        state0_[lane] = s0;
+        state1_[lane] = s1;
+        state2_[lane] = s2;
+        state3_[lane] = s3;
+    }
+}
+
+uint32_t ParticleRandom::NextUInt() {
+    if (bufferIndex_ >= kLaneCount) {
+        Step(buffer_);
+        bufferIndex_ = 0;
+    }
+    return buffer_[bufferIndex_++];
+}
+
+float ParticleRandom::NextFloat() {
+    return ToUnitFloat(NextUInt());
+}
+
+void ParticleRandom::FillUniform(float* out, uint32_t count, float min, float max) {
+    float range = max - min;
+
+    // レーン数ずつまとめて生成する
+    uint32_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        uint32_t bits[kLaneCount];
+        Step(bits);
+        for (uint32_t lane = 0; lane < kLaneCount; ++lane) {
+            out[i + lane] = min + range * ToUnitFloat(bits[lane]);
+        }
+    }
+
+    // 端数は1つずつ生成する
+    for (; i < count; ++i) {
+        out[i] = min + range * NextFloat();
+    }
+}
+
+uint64_t ParticleRandom::MakeSeed(const char* text, uint64_t baseSeed) {
+    // FNV-1aでハッシュしてから基準シードと混ぜる
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char* p = text; *p != '\0'; ++p) {
+        hash ^= static_cast<uint8_t>(*p);
+        hash *= 0x100000001B3ull;
+    }
+    uint64_t x = hash ^ baseSeed;
+    return SplitMix64(x);
+}
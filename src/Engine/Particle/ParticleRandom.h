@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+// パーティクル用の乱数生成器（xoshiro128+）
+// 独立した状態を8本並べて同時に進めるので、まとめて生成するときはSIMD化される
+// 同じシードからは常に同じ乱数列が得られる（リプレイ・QAでの再現用）
+class ParticleRandom {
+public:
+    // 同時に進める乱数列の本数
+    static const uint32_t kLaneCount = 8;
+
+    // コンストラクタ
+    explicit ParticleRandom(uint64_t seed = 0);
+
+    // シードの設定（状態と内部のバッファを初期化する）
+    void Seed(uint64_t seed);
+
+    // 32bitの乱数を1つ生成
+    uint32_t NextUInt();
+
+    // [0, 1)の乱数を1つ生成
+    float NextFloat();
+
+    // [min, max)の乱数を1つ生成
+    float NextFloat(float min, float max) { return min + (max - min) * NextFloat(); }
+
+    // [min, max)の乱数をcount個まとめて書き込む
+    void FillUniform(float* out, uint32_t count, float min, float max);
+
+    // 文字列からシードを作る（グループ名ごとに異なる乱数列にするため）
+    static uint64_t MakeSeed(const char* text, uint64_t baseSeed);
+
+private:
+    // 各乱数列の状態（レーンごとに連続させてSIMD化しやすくする）
+    uint32_t state0_[kLaneCount];
+    uint32_t state1_[kLaneCount];
+    uint32_t state2_[kLaneCount];
+    uint32_t state3_[kLaneCount];
+
+    // 1つずつ取り出す用のバッファ
+    uint32_t buffer_[kLaneCount];
+    uint32_t bufferIndex_;
+
+    // 全レーンを1ステップ進めて結果を書き込む
+    void Step(uint32_t out[kLaneCount]);
+};
@@ -0,0 +1,69 @@
+#include "ParticleSimulation.h"
+#include "ParticleKernel.h"
+#include "JobSystem.h"
+#include <chrono>
+
+namespace {
+
+// パーティクル同士の反発（空間ハッシュを作り直してから範囲ごとに並列で計算する）
+void ApplyParticleRepulsion(ParticlePool& pool, const ParticleRepulsion& repulsion, ParticleSpatialHash& spatialHash,
+    float deltaTime, ParticleSimulationTimings& timings) {
+    using Clock = std::chrono::steady_clock;
+    if (pool.Empty() || repulsion.radius <= 0.0f) {
+        return;
+    }
+
+    // 空間ハッシュの構築（計数ソートでO(n)、セルは探索半径の2倍にして2x2x2セルだけを調べる）
+    Clock::time_point buildStart = Clock::now();
+    spatialHash.Build(pool.positionX.data(), pool.positionY.data(), pool.positionZ.data(), pool.Size(), repulsion.radius * 2.0f);
+    Clock::time_point buildEnd = Clock::now();
+
+    // 近傍探索と反発（各チャンクは自分の範囲の速度だけを書き換える）
+    JobSystem::GetInstance()->ParallelFor(0, pool.Size(), kParticleChunkSize,
+        [&](uint32_t begin, uint32_t end) {
+            ApplyRepulsion(repulsion, spatialHash, pool, begin, end, deltaTime);
+        });
+    Clock::time_point queryEnd = Clock::now();
+
+    // サブステップ分は合算する
+    timings.spatialHashBuildMilliseconds += std::chrono::duration<float, std::milli>(buildEnd - buildStart).count();
+    timings.repulsionMilliseconds += std::chrono::duration<float, std::milli>(queryEnd - buildEnd).count();
+}
+
+} // namespace
+
+ParticleSimulationTimings SimulateParticles(ParticlePool& pool, const ParticleLifetimeCurves& curves,
+    const ParticleForceStage& forces, ParticleSpatialHash& spatialHash, float deltaTime, uint32_t subStepCount) {
+    JobSystem* jobSystem = JobSystem::GetInstance();
+    ParticleSimulationTimings timings;
+
+    for (uint32_t step = 0; step < subStepCount; ++step) {
+        // 全パーティクルの積分（SIMDカーネルで連続配列をチャンクごとに処理）
+        jobSystem->ParallelFor(0, pool.Size(), kParticleChunkSize,
+            [&](uint32_t begin, uint32_t end) {
+                StepParticles(pool, curves, forces, begin, end, deltaTime);
+            });
+
+        // 寿命が尽きたパーティクルを削除（並びが変わるので直列で行う）
+        pool.KillExpired();
+
+        // パーティクル同士の反発（次のステップの速度に反映される）
+        if (forces.repulsion.isEnabled) {
+            ApplyParticleRepulsion(pool, forces.repulsion, spatialHash, deltaTime, timings);
+        }
+    }
+    return timings;
+}
+
+void StepParticles(ParticlePool& pool, const ParticleLifetimeCurves& curves, const ParticleForceStage& forces,
+    uint32_t begin, uint32_t end, float deltaTime) {
+    // 力場で速度を変えてから積分し、積分後の座標で衝突判定を行う
+    if (forces.HasForceFields()) {
+        ApplyForceFields(forces, pool, begin, end, deltaTime);
+    }
+    IntegrateParticles(pool, begin, end, deltaTime);
+    ApplyLifetimeCurves(curves, pool, begin, end, deltaTime);
+    if (forces.HasColliders()) {
+        ApplyColliders(forces, pool, begin, end);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include "ParticlePool.h"
+#include "ParticleCurve.h"
+#include "ParticleForceField.h"
+#include "ParticleSpatialHash.h"
+
+// 並列更新時に1ジョブが受け持つパーティクル数
+static const uint32_t kParticleChunkSize = 2048;
+
+// 1回の更新での処理時間（ミリ秒、サブステップ分は合算）
+struct ParticleSimulationTimings {
+    // 空間ハッシュの構築時間
+    float spatialHashBuildMilliseconds = 0.0f;
+    // パーティクル同士の反発の計算時間
+    float repulsionMilliseconds = 0.0f;
+};
+
+// パーティクルをdeltaTimeずつsubStepCount回進める（描画に関係しない、パーティクルグループの更新のうち計算の部分）
+// 各ステップで力場・積分・寿命に応じた変化・衝突をチャンク単位でJobSystemで並列に処理し、寿命が尽きたものを削除してから反発を適用する
+// 各チャンクは自分の範囲だけを書き換えるので、ワーカーの数によらず結果は同じになる
+// spatialHashは反発が有効なときに毎ステップ作り直す作業領域
+ParticleSimulationTimings SimulateParticles(ParticlePool& pool, const ParticleLifetimeCurves& curves,
+    const ParticleForceStage& forces, ParticleSpatialHash& spatialHash, float deltaTime, uint32_t subStepCount);
+
+// [begin, end)のパーティクルを1ステップ進める（SimulateParticlesが各チャンクに行う、力場・積分・寿命に応じた変化・衝突）
+// 寿命が尽きたものの削除と、パーティクル同士の反発（全パーティクルの空間ハッシュが必要）は行わない
+void StepParticles(ParticlePool& pool, const ParticleLifetimeCurves& curves, const ParticleForceStage& forces,
+    uint32_t begin, uint32_t end, float deltaTime);
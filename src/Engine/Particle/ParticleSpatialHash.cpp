@@ -0,0 +1,49 @@
+#include "ParticleSpatialHash.h"
+#include <cassert>
+#include <cmath>
+
+int32_t ParticleSpatialHash::ToCell(float v) const {
+    return static_cast<int32_t>(std::floor(v * inverseCellSize_));
+}
+
+void ParticleSpatialHash::ToCellAndSide(float v, int32_t& cell, int32_t& side) const {
+    float scaled = v * inverseCellSize_;
+    float cellFloor = std::floor(scaled);
+    cell = static_cast<int32_t>(cellFloor);
+    side = scaled - cellFloor < 0.5f ? -1 : 1;
+}
+
+void ParticleSpatialHash::Build(const float* positionX, const float* positionY, const float* positionZ, uint32_t count, float cellSize) {
+    assert(cellSize > 0.0f);
+    cellSize_ = cellSize;
+    inverseCellSize_ = 1.0f / cellSize;
+
+    // ハッシュ表はパーティクル数以上の2の累乗（衝突を減らしつつO(n)に収める）
+    uint32_t tableSize = 64;
+    while (tableSize < count) {
+        tableSize <<= 1;
+    }
+    tableMask_ = tableSize - 1;
+
+    // 各セルのパーティクル数を数える
+    cellStart_.assign(tableSize + 1, 0);
+    particleCell_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t h = HashCell(ToCell(positionX[i]), ToCell(positionY[i]), ToCell(positionZ[i]));
+        particleCell_[i] = h;
+        ++cellStart_[h + 1];
+    }
+
+    // 累積和で開始位置にする
+    for (uint32_t h = 0; h < tableSize; ++h) {
+        cellStart_[h + 1] += cellStart_[h];
+    }
+
+    // セル順に並べる（計数ソート）
+    entries_.resize(count);
+    writeOffset_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t k = writeOffset_[particleCell_[i]]++;
+        entries_[k] = { positionX[i], positionY[i], positionZ[i], i };
+    }
+}
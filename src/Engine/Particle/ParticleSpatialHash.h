@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// パーティクル用の一様グリッド空間ハッシュ
+// 毎フレーム計数ソートでO(n)で作り直し、近傍探索は点に近い側の2x2x2セルだけを調べる
+class ParticleSpatialHash {
+public:
+    // 構築（cellSizeは探索半径の2倍以上にすること）
+    void Build(const float* positionX, const float* positionY, const float* positionZ, uint32_t count, float cellSize);
+
+    // 点(x, y, z)から半径radius以内のパーティクルを列挙する
+    // func(index, dx, dy, dz, distanceSq)のd*は「点 - パーティクル」の差分
+    template<typename Func>
+    void ForEachNeighbor(float x, float y, float z, float radius, Func func) const;
+
+    // セルの大きさ
+    float GetCellSize() const { return cellSize_; }
+
+    // 登録されているパーティクル数
+    uint32_t GetCount() const { return static_cast<uint32_t>(entries_.size()); }
+
+    // セル順でk番目のパーティクルの添字と座標
+    // この順に探索すると連続したパーティクルが同じセルを引くのでキャッシュに乗りやすい
+    uint32_t GetSortedIndex(uint32_t k) const { return entries_[k].index; }
+    float GetSortedX(uint32_t k) const { return entries_[k].x; }
+    float GetSortedY(uint32_t k) const { return entries_[k].y; }
+    float GetSortedZ(uint32_t k) const { return entries_[k].z; }
+
+private:
+    // セル順に並べたパーティクル（近傍探索で1回の読み込みで済むよう座標と添字をまとめる）
+    struct Entry {
+        float x;
+        float y;
+        float z;
+        uint32_t index;
+    };
+
+    // セル座標からハッシュ表の位置を求める
+    uint32_t HashCell(int32_t cx, int32_t cy, int32_t cz) const {
+        uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u ^ static_cast<uint32_t>(cz) * 83492791u;
+        return h & tableMask_;
+    }
+
+    // 座標からセル座標を求める
+    int32_t ToCell(float v) const;
+
+    // 座標から、セル座標と隣のどちら側のセルが近いか（-1か+1）を求める
+    void ToCellAndSide(float v, int32_t& cell, int32_t& side) const;
+
+    // セルの大きさとその逆数
+    float cellSize_ = 1.0f;
+    float inverseCellSize_ = 1.0f;
+
+    // ハッシュ表の大きさ-1（大きさは2の累乗）
+    uint32_t tableMask_ = 0;
+
+    // ハッシュ表の位置ごとの開始位置（cellStart_[h]～cellStart_[h+1]がそのセルの範囲）
+    std::vector<uint32_t> cellStart_;
+
+    // パーティクルごとのハッシュ値と書き込み位置（構築時の作業用）
+    std::vector<uint32_t> particleCell_;
+    std::vector<uint32_t> writeOffset_;
+
+    // セル順に並べたパーティクル
+    std::vector<Entry> entries_;
+};
+
+template<typename Func>
+void ParticleSpatialHash::ForEachNeighbor(float x, float y, float z, float radius, Func func) const {
+    if (entries_.empty()) {
+        return;
+    }
+
+    float radiusSq = radius * radius;
+
+    // 半径がセルの半分以下なら、各軸で点に近い側の隣のセルだけを見れば足りる
+    int32_t cx, cy, cz, sx, sy, sz;
+    ToCellAndSide(x, cx, sx);
+    ToCellAndSide(y, cy, sy);
+    ToCellAndSide(z, cz, sz);
+
+    // 2x2x2セルのハッシュ値を集める（衝突で同じ位置になったものは1回だけ調べる）
+    uint32_t buckets[8];
+    uint32_t bucketCount = 0;
+    for (int32_t oz = 0; oz <= 1; ++oz) {
+        for (int32_t oy = 0; oy <= 1; ++oy) {
+            for (int32_t ox = 0; ox <= 1; ++ox) {
+                uint32_t h = HashCell(cx + ox * sx, cy + oy * sy, cz + oz * sz);
+                bool isDuplicate = false;
+                for (uint32_t b = 0; b < bucketCount; ++b) {
+                    isDuplicate |= buckets[b] == h;
+                }
+                if (!isDuplicate) {
+                    buckets[bucketCount++] = h;
+                }
+            }
+        }
+    }
+
+    // 別のセルが混ざっていても距離判定で除外される
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        uint32_t h = buckets[b];
+        for (uint32_t k = cellStart_[h]; k < cellStart_[h + 1]; ++k) {
+            const Entry& entry = entries_[k];
+            float dx = x - entry.x;
+            float dy = y - entry.y;
+            float dz = z - entry.z;
+            float distanceSq = dx * dx + dy * dy + dz * dz;
+            if (distanceSq < radiusSq) {
+                func(entry.index, dx, dy, dz, distanceSq);
+            }
+        }
+    }
+}
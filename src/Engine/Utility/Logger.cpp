@@ -1,11 +1,20 @@
 #include "Logger.h"
-#include "Windows.h"
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <cstdio>
+#endif
 
 
 
 namespace Logger
 {
-	void Logger::Log(const std::string& message) {
+	void Log(const std::string& message) {
+#if defined(_WIN32)
 		OutputDebugStringA(message.c_str());
+#else
+		// Windows以外ではデバッグ出力の代わりに標準エラーへ出す
+		std::fputs(message.c_str(), stderr);
+#endif
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string>
 #include <algorithm>
 #include <ParticleManager.h>
+#include "JobSystem.h"
 
 MyGame::MyGame()
     : winApp_(nullptr),
@@ -26,6 +27,8 @@ void MyGame::Initialize() {
 
         // DirectXCommonの初期化
         dxCommon_ = std::make_unique<DirectXCommon>();
+        // reverse-Z（深度バッファのフォーマット・クリア値・比較関数が変わるので、デバイスを作る前に設定する）
+        dxCommon_->SetReverseZ(true);
         dxCommon_->Initialize(winApp_);
 
         // SRVマネージャの初期化
@@ -55,8 +58,14 @@ void MyGame::Initialize() {
         // カメラの作成と初期化
         camera_ = std::make_unique<Camera>();
         camera_->SetTranslate({ 0.0f, 0.0f, -5.0f });
+        // 投影行列を深度バッファの設定に合わせ、reverse-Zなら遠くまで精度が落ちないのでファークリップをなくす
+        camera_->SetReverseZ(dxCommon_->IsReverseZ());
+        camera_->SetInfiniteFar(dxCommon_->IsReverseZ());
         Object3dCommon::SetDefaultCamera(camera_.get());
 
+        // ジョブシステムの初期化（パーティクル更新などの並列処理用）
+        JobSystem::GetInstance()->Initialize();
+
         // パーティクルマネージャの初期化
         ParticleManager::GetInstance()->Initialize(dxCommon_.get(), srvManager_.get());
 
@@ -126,8 +135,8 @@ void MyGame::Update() {
             srvManager_->PreDraw();
         }
 
-        // パーティクルマネージャの更新
-        ParticleManager::GetInstance()->Update(camera_.get());
+        // パーティクルマネージャの更新（前フレームの経過時間で進める）
+        ParticleManager::GetInstance()->Update(camera_.get(), dxCommon_->GetDeltaTime());
 
         // シーンマネージャーの更新
         sceneManager_->Update();
@@ -173,6 +182,9 @@ void MyGame::Finalize() {
         // パーティクルマネージャーの終了処理
         ParticleManager::GetInstance()->Finalize();
 
+        // ジョブシステムの終了処理（ワーカースレッドの停止）
+        JobSystem::GetInstance()->Finalize();
+
         // ImGuiの解放
         ImGui_ImplDX12_Shutdown();
         ImGui_ImplWin32_Shutdown();
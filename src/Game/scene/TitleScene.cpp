@@ -115,8 +115,10 @@ void TitleScene::Draw() {
     // 3Dオブジェクトの描画準備（SRVヒープの設定）
     srvManager_->PreDraw();
 
-    // 3Dオブジェクトの描画
-    sphereObject_->Draw();
+    // 3Dオブジェクトの描画（視錐台の外にあれば描画しない）
+    if (sphereObject_->IsVisible(camera_->GetFrustum())) {
+        sphereObject_->Draw();
+    }
 
     // スプライトの描画準備（共通設定）
     spriteCommon_->CommonDraw();
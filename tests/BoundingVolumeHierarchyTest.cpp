@@ -0,0 +1,308 @@
+#include "BoundingVolumeHierarchy.h"
+#include "Mymath.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ±50の範囲に置いた大きさ0.1～3の箱
+AABB RandomAABB(std::mt19937& engine) {
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    Vector3 min = { position(engine), position(engine), position(engine) };
+    return { min, { min.x + size(engine), min.y + size(engine), min.z + size(engine) } };
+}
+
+std::vector<AABB> RandomAABBs(uint32_t count, uint32_t seed) {
+    std::mt19937 engine(seed);
+    std::vector<AABB> aabbs(count);
+    for (AABB& aabb : aabbs) {
+        aabb = RandomAABB(engine);
+    }
+    return aabbs;
+}
+
+Ray RandomRay(std::mt19937& engine) {
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    Ray ray;
+    ray.origin = { position(engine), position(engine), position(engine) };
+    Vector3 d;
+    float lengthSq;
+    do {
+        d = { direction(engine), direction(engine), direction(engine) };
+        lengthSq = d.x * d.x + d.y * d.y + d.z * d.z;
+    } while (lengthSq < 0.01f);
+    float inverseLength = 1.0f / std::sqrt(lengthSq);
+    ray.direction = { d.x * inverseLength, d.y * inverseLength, d.z * inverseLength };
+    return ray;
+}
+
+// 原点付近を見下ろす透視投影（縦の視野角45度、16:9、0.1～60）
+Frustum MakeTestFrustum() {
+    Matrix4x4 cameraWorld = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.4f, 0.3f, 0.0f }, { -10.0f, 20.0f, -40.0f });
+    float cotHalfFov = 1.0f / std::tan(0.3927f);
+    float nearClip = 0.1f;
+    float farClip = 60.0f;
+    Matrix4x4 projection = {
+        cotHalfFov / (16.0f / 9.0f), 0, 0, 0,
+        0, cotHalfFov, 0, 0,
+        0, 0, farClip / (farClip - nearClip), 1,
+        0, 0, -nearClip * farClip / (farClip - nearClip), 0
+    };
+    return MakeFrustum(Multiply(InverseAffine(cameraWorld), projection));
+}
+
+std::vector<uint32_t> Sorted(std::vector<uint32_t> items) {
+    std::sort(items.begin(), items.end());
+    return items;
+}
+
+bool Contains(const AABB& outer, const AABB& inner) {
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+        outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+// 木の構造が正しいか
+// ・深さ優先の配置（左の子は親の直後、右の子は左の部分木の後ろ）
+// ・全アイテムがちょうど1回ずつ葉に入っている
+// ・各ノードの境界が子やアイテムの境界を含む
+void ExpectValidTree(const BoundingVolumeHierarchy& bvh, std::span<const AABB> itemBounds) {
+    std::span<const BoundingVolumeHierarchy::Node> nodes = bvh.GetNodes();
+    std::span<const uint32_t> leafItems = bvh.GetLeafItems();
+    ASSERT_FALSE(nodes.empty());
+
+    std::vector<uint32_t> itemCounts(itemBounds.size(), 0);
+    uint32_t nextLeafItem = 0;
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        const BoundingVolumeHierarchy::Node& node = nodes[i];
+        if (node.IsLeaf()) {
+            // 葉は深さ優先の順にアイテムの範囲を隙間なく使う
+            EXPECT_EQ(node.offset, nextLeafItem);
+            nextLeafItem = node.offset + node.count;
+            ASSERT_LE(nextLeafItem, leafItems.size());
+            for (uint32_t k = 0; k < node.count; ++k) {
+                uint32_t item = leafItems[node.offset + k];
+                ASSERT_LT(item, itemBounds.size());
+                ++itemCounts[item];
+                EXPECT_TRUE(Contains(node.bounds, itemBounds[item])) << "leaf " << i << " item " << item;
+            }
+        } else {
+            ASSERT_LT(i + 1, nodes.size());
+            ASSERT_GT(node.offset, i + 1);
+            ASSERT_LT(node.offset, nodes.size());
+            EXPECT_TRUE(Contains(node.bounds, nodes[i + 1].bounds)) << "node " << i;
+            EXPECT_TRUE(Contains(node.bounds, nodes[node.offset].bounds)) << "node " << i;
+        }
+    }
+    EXPECT_EQ(nextLeafItem, leafItems.size());
+    for (uint32_t item = 0; item < itemBounds.size(); ++item) {
+        EXPECT_EQ(itemCounts[item], 1u) << "item " << item;
+    }
+}
+
+// 全ての検索が総当たりと一致するか
+void ExpectQueriesMatchBruteForce(const BoundingVolumeHierarchy& bvh, std::span<const AABB> itemBounds, uint32_t seed) {
+    std::mt19937 engine(seed);
+    uint32_t itemCount = static_cast<uint32_t>(itemBounds.size());
+
+    // 視錐台
+    Frustum frustum = MakeTestFrustum();
+    std::vector<uint32_t> expected;
+    for (uint32_t item = 0; item < itemCount; ++item) {
+        if (IsAABBInFrustum(frustum, itemBounds[item])) {
+            expected.push_back(item);
+        }
+    }
+    std::vector<uint32_t> actual;
+    bvh.QueryFrustum(frustum, actual);
+    EXPECT_FALSE(expected.empty());
+    EXPECT_LT(expected.size(), itemCount);
+    EXPECT_EQ(Sorted(actual), expected);
+
+    for (uint32_t query = 0; query < 50; ++query) {
+        // 境界球
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> radius(1.0f, 15.0f);
+        Sphere sphere = { { position(engine), position(engine), position(engine) }, radius(engine) };
+        expected.clear();
+        for (uint32_t item = 0; item < itemCount; ++item) {
+            if (IsSphereAABBOverlap(sphere, itemBounds[item])) {
+                expected.push_back(item);
+            }
+        }
+        actual.clear();
+        bvh.QuerySphere(sphere, actual);
+        EXPECT_EQ(Sorted(actual), expected) << "sphere query " << query;
+
+        // AABB
+        AABB box = RandomAABB(engine);
+        box.max = { box.max.x + 10.0f, box.max.y + 10.0f, box.max.z + 10.0f };
+        expected.clear();
+        for (uint32_t item = 0; item < itemCount; ++item) {
+            if (IsAABBOverlap(box, itemBounds[item])) {
+                expected.push_back(item);
+            }
+        }
+        actual.clear();
+        bvh.QueryAABB(box, actual);
+        EXPECT_EQ(Sorted(actual), expected) << "AABB query " << query;
+    }
+
+    // レイ（最も近いものと、1つでも当たるか）
+    uint32_t hitRayCount = 0;
+    for (uint32_t query = 0; query < 200; ++query) {
+        Ray ray = RandomRay(engine);
+        if (query % 4 == 1) {
+            // 確実に当たるものも混ぜるため、一部はアイテムの中心へ向ける
+            Vector3 target = GetAABBCenter(itemBounds[engine() % itemCount]);
+            Vector3 d = { target.x - ray.origin.x, target.y - ray.origin.y, target.z - ray.origin.z };
+            float inverseLength = 1.0f / std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+            ray.direction = { d.x * inverseLength, d.y * inverseLength, d.z * inverseLength };
+        }
+        float maxDistance = query % 2 == 0 ? FLT_MAX : 40.0f;
+        Vector3 inverseDirection = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+        bool isExpectedHit = false;
+        float expectedDistance = maxDistance;
+        for (uint32_t item = 0; item < itemCount; ++item) {
+            float distance;
+            if (IntersectRayAABB(ray, inverseDirection, itemBounds[item], maxDistance, distance) && distance <= expectedDistance) {
+                isExpectedHit = true;
+                expectedDistance = distance;
+            }
+        }
+        hitRayCount += isExpectedHit ? 1 : 0;
+
+        BvhRayHit hit;
+        ASSERT_EQ(bvh.Raycast(ray, maxDistance, hit), isExpectedHit) << "ray " << query;
+        if (isExpectedHit) {
+            // 同じ距離のアイテムが複数あってもよいので、距離と、当たったアイテム自身の距離を確かめる
+            EXPECT_EQ(hit.distance, expectedDistance) << "ray " << query;
+            float itemDistance;
+            ASSERT_TRUE(IntersectRayAABB(ray, inverseDirection, itemBounds[hit.item], maxDistance, itemDistance));
+            EXPECT_EQ(itemDistance, expectedDistance) << "ray " << query;
+        }
+
+        auto itemTest = [&](uint32_t item, const Ray& itemRay, float itemMaxDistance, float& outDistance) {
+            return IntersectRayAABB(itemRay, inverseDirection, itemBounds[item], itemMaxDistance, outDistance);
+        };
+        EXPECT_EQ(bvh.RaycastAny(ray, maxDistance, itemTest), isExpectedHit) << "ray " << query;
+    }
+    EXPECT_GT(hitRayCount, 0u);
+}
+
+} // namespace
+
+TEST(BoundingVolumeHierarchyTest, BuildProducesValidTree) {
+    std::vector<AABB> aabbs = RandomAABBs(3000, 1);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    EXPECT_EQ(bvh.GetItemCount(), 3000u);
+    ExpectValidTree(bvh, aabbs);
+
+    // SAHで作った木は全アイテムを調べるより十分安い
+    float cost = bvh.ComputeCost();
+    EXPECT_GT(cost, 0.0f);
+    EXPECT_LT(cost, 3000.0f * 0.05f);
+}
+
+TEST(BoundingVolumeHierarchyTest, QueriesMatchBruteForce) {
+    std::vector<AABB> aabbs = RandomAABBs(3000, 2);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    ExpectQueriesMatchBruteForce(bvh, aabbs, 3);
+}
+
+TEST(BoundingVolumeHierarchyTest, DegenerateItemsStayValid) {
+    // 全て同じ位置にある（SAHで分けられず中央で分割される）アイテムと、少数のアイテム
+    std::vector<AABB> sameAABBs(100, AABB{ { 1.0f, 2.0f, 3.0f }, { 2.0f, 3.0f, 4.0f } });
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(sameAABBs);
+    ExpectValidTree(bvh, sameAABBs);
+    std::vector<uint32_t> items;
+    bvh.QueryAABB({ { 0.0f, 0.0f, 0.0f }, { 1.5f, 2.5f, 3.5f } }, items);
+    EXPECT_EQ(items.size(), 100u);
+
+    std::vector<AABB> single = RandomAABBs(1, 4);
+    bvh.Build(single);
+    ExpectValidTree(bvh, single);
+    items.clear();
+    bvh.QueryAABB(single[0], items);
+    EXPECT_EQ(items, std::vector<uint32_t>{ 0 });
+
+    bvh.Clear();
+    items.clear();
+    bvh.QuerySphere({ { 0.0f, 0.0f, 0.0f }, 100.0f }, items);
+    EXPECT_TRUE(items.empty());
+    BvhRayHit hit;
+    EXPECT_FALSE(bvh.Raycast({ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }, FLT_MAX, hit));
+}
+
+TEST(BoundingVolumeHierarchyTest, IncrementalRefitMatchesBruteForce) {
+    std::vector<AABB> aabbs = RandomAABBs(3000, 5);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+
+    // 一部のアイテムを大きく動かし、同じアイテムを2回動かすものも混ぜる
+    std::mt19937 engine(6);
+    std::uniform_int_distribution<uint32_t> pick(0, 2999);
+    for (uint32_t frame = 0; frame < 5; ++frame) {
+        for (uint32_t i = 0; i < 200; ++i) {
+            uint32_t item = pick(engine);
+            aabbs[item] = RandomAABB(engine);
+            bvh.UpdateItem(item, aabbs[item]);
+            EXPECT_EQ(bvh.GetItemBounds(item).min.x, aabbs[item].min.x);
+        }
+        bvh.Refit();
+        ExpectValidTree(bvh, aabbs);
+        ExpectQueriesMatchBruteForce(bvh, aabbs, 100 + frame);
+    }
+
+    // 境界を狭めた場合も親までたどって縮む（根の境界が全アイテムの境界と一致する）
+    for (uint32_t item = 0; item < aabbs.size(); ++item) {
+        AABB shrunk = { { aabbs[item].min.x * 0.5f, aabbs[item].min.y * 0.5f, aabbs[item].min.z * 0.5f },
+            { aabbs[item].min.x * 0.5f + 0.1f, aabbs[item].min.y * 0.5f + 0.1f, aabbs[item].min.z * 0.5f + 0.1f } };
+        aabbs[item] = shrunk;
+        bvh.UpdateItem(item, shrunk);
+    }
+    bvh.Refit();
+    ExpectValidTree(bvh, aabbs);
+    AABB all = MakeEmptyAABB();
+    for (const AABB& aabb : aabbs) {
+        all = MergeAABB(all, aabb);
+    }
+    EXPECT_EQ(bvh.GetNodes()[0].bounds.min.x, all.min.x);
+    EXPECT_EQ(bvh.GetNodes()[0].bounds.max.z, all.max.z);
+    ExpectQueriesMatchBruteForce(bvh, aabbs, 200);
+}
+
+TEST(BoundingVolumeHierarchyTest, FullRefitMatchesBruteForce) {
+    std::vector<AABB> aabbs = RandomAABBs(2000, 7);
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(aabbs);
+    float builtCost = bvh.ComputeCost();
+
+    // 全アイテムを少しずつ動かす
+    std::mt19937 engine(8);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+    for (AABB& aabb : aabbs) {
+        Vector3 move = { offset(engine), offset(engine), offset(engine) };
+        aabb.min = { aabb.min.x + move.x, aabb.min.y + move.y, aabb.min.z + move.z };
+        aabb.max = { aabb.max.x + move.x, aabb.max.y + move.y, aabb.max.z + move.z };
+    }
+    // UpdateItemした後でもRefit(span)の値が優先される
+    bvh.UpdateItem(0, { { 1000.0f, 1000.0f, 1000.0f }, { 1001.0f, 1001.0f, 1001.0f } });
+    bvh.Refit(aabbs);
+    ExpectValidTree(bvh, aabbs);
+    ExpectQueriesMatchBruteForce(bvh, aabbs, 9);
+    // 少し動かしただけなら木の品質は大きく変わらない
+    EXPECT_LT(bvh.ComputeCost(), builtCost * 2.0f);
+
+    // 後から呼ぶRefit()は何もしない
+    bvh.Refit();
+    ExpectValidTree(bvh, aabbs);
+}
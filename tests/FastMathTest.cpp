@@ -0,0 +1,114 @@
+#include "FastMath.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// FastMath.hに記した誤差の上限を、倍精度で求めた値と比べて確かめる
+
+TEST(FastMathTest, RsqrtRelativeErrorBound) {
+    std::vector<float> values;
+    // 仮数部の全範囲を細かく（rsqrtpsの近似誤差は仮数部で決まる）
+    for (int i = 0; i < (1 << 20); ++i) {
+        values.push_back(1.0f + 3.0f * static_cast<float>(i) / static_cast<float>(1 << 20));
+    }
+    // 指数部の広い範囲
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<float> exponent(-30.0f, 30.0f);
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(std::pow(10.0f, exponent(engine)));
+    }
+
+    double maxError = 0.0;
+    for (float x : values) {
+        double expected = 1.0 / std::sqrt(static_cast<double>(x));
+        maxError = (std::max)(maxError, std::abs(FastMath::Rsqrt(x) - expected) / expected);
+    }
+    EXPECT_LE(maxError, 3e-7);
+}
+
+TEST(FastMathTest, SinCosAbsoluteErrorBound) {
+    // |x| <= 8192 の範囲を一様に調べる
+    const int count = 1 << 21;
+    std::vector<float> x(count);
+    for (int i = 0; i < count; ++i) {
+        x[i] = -8192.0f + 16384.0f * static_cast<float>(i) / static_cast<float>(count - 1);
+    }
+    // 折り返しの境界付近（π/4の奇数倍）
+    for (int k = -100; k <= 100; ++k) {
+        float boundary = static_cast<float>(k * 0.78539816339744831);
+        x.push_back(std::nextafter(boundary, -1e9f));
+        x.push_back(boundary);
+        x.push_back(std::nextafter(boundary, 1e9f));
+    }
+
+    double maxSinError = 0.0;
+    double maxCosError = 0.0;
+    for (float value : x) {
+        float sinValue = 0.0f;
+        float cosValue = 0.0f;
+        FastMath::SinCos(value, sinValue, cosValue);
+        maxSinError = (std::max)(maxSinError, std::abs(sinValue - std::sin(static_cast<double>(value))));
+        maxCosError = (std::max)(maxCosError, std::abs(cosValue - std::cos(static_cast<double>(value))));
+    }
+    EXPECT_LE(maxSinError, 1e-7);
+    EXPECT_LE(maxCosError, 1e-7);
+
+    // まとめて求める場合も同じ上限に収まる（端数の処理も通るよう4の倍数にしない）
+    x.resize(count + 3);
+    std::vector<float> outSin(x.size());
+    std::vector<float> outCos(x.size());
+    FastMath::SinCos(x, outSin, outCos);
+    maxSinError = 0.0;
+    maxCosError = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        maxSinError = (std::max)(maxSinError, std::abs(outSin[i] - std::sin(static_cast<double>(x[i]))));
+        maxCosError = (std::max)(maxCosError, std::abs(outCos[i] - std::cos(static_cast<double>(x[i]))));
+    }
+    EXPECT_LE(maxSinError, 1e-7);
+    EXPECT_LE(maxCosError, 1e-7);
+}
+
+TEST(FastMathTest, NormalizeLengthErrorBound) {
+    // 4個ずつの処理の端数も通るよう4の倍数にしない
+    const size_t count = 100003;
+    std::mt19937 engine(2);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> exponent(-3.0f, 6.0f);
+    std::vector<Vector3> vectors(count);
+    for (Vector3& vector : vectors) {
+        // 正規化されない長さ（kNormalizeMinLengthSq以下）にならないものを作る
+        do {
+            float scale = std::pow(10.0f, exponent(engine));
+            vector = { component(engine) * scale, component(engine) * scale, component(engine) * scale };
+        } while (vector.x * vector.x + vector.y * vector.y + vector.z * vector.z <= FastMath::kNormalizeMinLengthSq * 100.0f);
+    }
+    // 短すぎるベクトルは変更されない
+    vectors[0] = { 0.0f, 0.0f, 0.0f };
+    vectors[1] = { 1e-5f, -1e-5f, 0.0f };
+    std::vector<Vector3> original = vectors;
+
+    FastMath::Normalize(vectors);
+
+    EXPECT_EQ(vectors[0].x, original[0].x);
+    EXPECT_EQ(vectors[1].x, original[1].x);
+    EXPECT_EQ(vectors[1].y, original[1].y);
+
+    double maxLengthError = 0.0;
+    double maxDirectionError = 0.0;
+    for (size_t i = 2; i < count; ++i) {
+        const Vector3& v = vectors[i];
+        double length = std::sqrt(double(v.x) * v.x + double(v.y) * v.y + double(v.z) * v.z);
+        maxLengthError = (std::max)(maxLengthError, std::abs(length - 1.0));
+
+        // 向きも元のベクトルと一致している
+        const Vector3& o = original[i];
+        double originalLength = std::sqrt(double(o.x) * o.x + double(o.y) * o.y + double(o.z) * o.z);
+        maxDirectionError = (std::max)(maxDirectionError, std::abs(v.x - o.x / originalLength));
+        maxDirectionError = (std::max)(maxDirectionError, std::abs(v.y - o.y / originalLength));
+        maxDirectionError = (std::max)(maxDirectionError, std::abs(v.z - o.z / originalLength));
+    }
+    EXPECT_LE(maxLengthError, 3e-7);
+    EXPECT_LE(maxDirectionError, 5e-7);
+}
@@ -0,0 +1,136 @@
+#include "MatrixSimd.h"
+#include "Mymath.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+// 乱数で一般の行列を作る
+Matrix4x4 RandomMatrix(std::mt19937& engine) {
+    std::uniform_real_distribution<float> element(-10.0f, 10.0f);
+    Matrix4x4 result;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = element(engine);
+        }
+    }
+    return result;
+}
+
+// 乱数でアフィン行列（拡大縮小・回転・平行移動）を作る
+Matrix4x4 RandomAffineMatrix(std::mt19937& engine) {
+    std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+    std::uniform_real_distribution<float> angle(-kPi, kPi);
+    std::uniform_real_distribution<float> translate(-100.0f, 100.0f);
+    return MakeAffineMatrix(
+        { scale(engine), scale(engine), scale(engine) },
+        { angle(engine), angle(engine), angle(engine) },
+        { translate(engine), translate(engine), translate(engine) });
+}
+
+// 要素の最大の絶対値
+float MaxAbs(const Matrix4x4& m) {
+    float result = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result = (std::max)(result, std::abs(m.m[i][j]));
+        }
+    }
+    return result;
+}
+
+// 要素の大きさに対する相対的な差がtolerance以内か
+void ExpectMatrixNear(const Matrix4x4& expected, const Matrix4x4& actual, float tolerance) {
+    float limit = tolerance * (std::max)(MaxAbs(expected), 1.0f);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(expected.m[i][j], actual.m[i][j], limit) << "m[" << i << "][" << j << "]";
+        }
+    }
+}
+
+// 条件数の目安（大きいほど逆行列の誤差が大きくなる）
+float ConditionNumber(const Matrix4x4& m) {
+    return MaxAbs(m) * MaxAbs(MatrixSimd::InverseScalar(m));
+}
+
+} // namespace
+
+TEST(MatrixSimdTest, MultiplyMatchesScalar) {
+    std::mt19937 engine(1);
+    for (int i = 0; i < 10000; ++i) {
+        Matrix4x4 m1 = RandomMatrix(engine);
+        Matrix4x4 m2 = RandomMatrix(engine);
+        ExpectMatrixNear(MatrixSimd::MultiplyScalar(m1, m2), MatrixSimd::Multiply(m1, m2), 1e-6f);
+    }
+}
+
+TEST(MatrixSimdTest, TransposeMatchesScalarExactly) {
+    std::mt19937 engine(2);
+    for (int i = 0; i < 1000; ++i) {
+        Matrix4x4 m = RandomMatrix(engine);
+        EXPECT_EQ(MatrixSimd::TransposeScalar(m), MatrixSimd::Transpose(m));
+    }
+}
+
+TEST(MatrixSimdTest, InverseMatchesScalar) {
+    std::mt19937 engine(3);
+    int testedCount = 0;
+    while (testedCount < 10000) {
+        // 条件数が悪すぎる（ほぼ特異な）行列は除く
+        Matrix4x4 m = RandomMatrix(engine);
+        float condition = ConditionNumber(m);
+        if (condition > 1.0e3f) {
+            continue;
+        }
+        ++testedCount;
+        Matrix4x4 inverse = MatrixSimd::Inverse(m);
+        ExpectMatrixNear(MatrixSimd::InverseScalar(m), inverse, 1e-4f);
+        ExpectMatrixNear(MakeIdentity4x4(), MatrixSimd::MultiplyScalar(m, inverse), 1e-6f * condition);
+    }
+}
+
+TEST(MatrixSimdTest, InverseAffineMatchesScalar) {
+    std::mt19937 engine(4);
+    for (int i = 0; i < 10000; ++i) {
+        Matrix4x4 m = RandomAffineMatrix(engine);
+        Matrix4x4 inverse = MatrixSimd::InverseAffine(m);
+        ExpectMatrixNear(MatrixSimd::InverseAffineScalar(m), inverse, 1e-5f);
+        // 一般の逆行列とも一致する
+        ExpectMatrixNear(MatrixSimd::InverseScalar(m), inverse, 1e-4f);
+        // 4列目は(0,0,0,1)のまま
+        EXPECT_EQ(inverse.m[0][3], 0.0f);
+        EXPECT_EQ(inverse.m[1][3], 0.0f);
+        EXPECT_EQ(inverse.m[2][3], 0.0f);
+        EXPECT_EQ(inverse.m[3][3], 1.0f);
+    }
+}
+
+// 積と転置はSIMD版に速度差がないためスカラー版、逆行列は使用中の実装に委譲する
+TEST(MatrixSimdTest, FreeFunctionsDelegateToBackend) {
+    std::mt19937 engine(5);
+    Matrix4x4 m1 = RandomAffineMatrix(engine);
+    Matrix4x4 m2 = RandomAffineMatrix(engine);
+    EXPECT_EQ(MatrixSimd::MultiplyScalar(m1, m2), Multiply(m1, m2));
+    EXPECT_EQ(MatrixSimd::Inverse(m1), Inverse(m1));
+    EXPECT_EQ(MatrixSimd::InverseAffine(m1), InverseAffine(m1));
+    EXPECT_EQ(MatrixSimd::TransposeScalar(m1), Transpose(m1));
+}
+
+// NEONとSIMDなしの構成では逆行列はスカラー版そのものなので、結果は完全に一致する
+TEST(MatrixSimdTest, InverseWithoutSseIsScalar) {
+#if defined(MATRIX_SIMD_SSE)
+    GTEST_SKIP() << "Inverse is vectorized on " << MatrixSimd::GetBackendName();
+#else
+    std::mt19937 engine(6);
+    for (int i = 0; i < 1000; ++i) {
+        Matrix4x4 m = RandomAffineMatrix(engine);
+        EXPECT_EQ(MatrixSimd::InverseScalar(m), MatrixSimd::Inverse(m));
+        EXPECT_EQ(MatrixSimd::InverseAffineScalar(m), MatrixSimd::InverseAffine(m));
+    }
+#endif
+}
@@ -0,0 +1,170 @@
+#include "MeshCache.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// テストごとに一時フォルダに元ファイルを作り、キャッシュを書き出す
+class MeshCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+            ("MeshCacheTest_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+
+        sourcePaths_ = { (directory_ / "model.obj").string(), (directory_ / "model.mtl").string() };
+        WriteText(sourcePaths_[0], "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+        WriteText(sourcePaths_[1], "newmtl material\nmap_Kd texture.png\n");
+        cachePath_ = MeshCache::GetCachePath(sourcePaths_[0]);
+
+        vertices_ = {
+            { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+            { { 1.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+            { { 0.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f } },
+        };
+        indices_ = { 0, 1, 2, 2, 1, 0 };
+        materials_.resize(2);
+        materials_[0].name = "material";
+        materials_[0].textureFilePath = "resources/texture.png";
+        materials_[0].diffuse = { 0.5f, 0.25f, 0.125f, 1.0f };
+        materials_[1].name = "other";
+        materials_[1].shininess = 32.0f;
+        materials_[1].alpha = 0.5f;
+        subMeshes_ = { { 0, 3, 0 }, { 3, 3, 1 } };
+    }
+
+    void TearDown() override {
+        std::error_code error;
+        std::filesystem::remove_all(directory_, error);
+    }
+
+    static void WriteText(const std::string& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    // 元ファイルの更新日時だけを進める
+    static void Touch(const std::string& path) {
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(10));
+    }
+
+    bool WriteCache() {
+        MeshCache::Contents contents;
+        contents.vertices = vertices_;
+        contents.indices = indices_;
+        contents.materials = materials_;
+        contents.subMeshes = subMeshes_;
+        contents.localAABB = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f } };
+        contents.localBoundingSphere = { { 0.5f, 0.5f, 0.0f }, 0.75f };
+        return MeshCache::Write(cachePath_, sourcePaths_, contents);
+    }
+
+    std::filesystem::path directory_;
+    std::vector<std::string> sourcePaths_;
+    std::string cachePath_;
+    std::vector<VertexData> vertices_;
+    std::vector<uint32_t> indices_;
+    std::vector<MaterialData> materials_;
+    std::vector<SubMeshData> subMeshes_;
+};
+
+} // namespace
+
+TEST_F(MeshCacheTest, RoundTrip) {
+    ASSERT_TRUE(WriteCache());
+
+    MeshCache cache;
+    ASSERT_TRUE(cache.Open(cachePath_));
+    EXPECT_FALSE(cache.IsSourceStampChanged());
+    EXPECT_EQ(cache.GetSourcePaths(), sourcePaths_);
+
+    std::span<const VertexData> vertices = cache.GetVertices();
+    ASSERT_EQ(vertices.size(), vertices_.size());
+    EXPECT_EQ(std::memcmp(vertices.data(), vertices_.data(), sizeof(VertexData) * vertices_.size()), 0);
+
+    std::span<const uint32_t> indices = cache.GetIndices();
+    EXPECT_EQ(std::vector<uint32_t>(indices.begin(), indices.end()), indices_);
+
+    std::span<const SubMeshData> subMeshes = cache.GetSubMeshes();
+    ASSERT_EQ(subMeshes.size(), subMeshes_.size());
+    for (size_t i = 0; i < subMeshes_.size(); ++i) {
+        EXPECT_EQ(subMeshes[i].indexStart, subMeshes_[i].indexStart);
+        EXPECT_EQ(subMeshes[i].indexCount, subMeshes_[i].indexCount);
+        EXPECT_EQ(subMeshes[i].materialIndex, subMeshes_[i].materialIndex);
+    }
+
+    ASSERT_EQ(cache.GetMaterialCount(), materials_.size());
+    for (uint32_t i = 0; i < cache.GetMaterialCount(); ++i) {
+        MaterialData material = cache.GetMaterial(i);
+        EXPECT_EQ(material.name, materials_[i].name);
+        EXPECT_EQ(material.textureFilePath, materials_[i].textureFilePath);
+        EXPECT_EQ(material.diffuse.y, materials_[i].diffuse.y);
+        EXPECT_EQ(material.shininess, materials_[i].shininess);
+        EXPECT_EQ(material.alpha, materials_[i].alpha);
+    }
+
+    EXPECT_EQ(cache.GetLocalAABB().max.y, 1.0f);
+    EXPECT_EQ(cache.GetLocalBoundingSphere().radius, 0.75f);
+
+    cache.Close();
+    EXPECT_FALSE(cache.IsOpen());
+}
+
+TEST_F(MeshCacheTest, TouchedSourceIsValidatedByContentHash) {
+    ASSERT_TRUE(WriteCache());
+    Touch(sourcePaths_[1]);
+
+    // 更新日時だけが変わった場合は内容のハッシュが一致するので有効
+    MeshCache cache;
+    ASSERT_TRUE(cache.Open(cachePath_));
+    EXPECT_TRUE(cache.IsSourceStampChanged());
+
+    // 書き直せば次からはハッシュを計算せずに有効と判定される
+    cache.Close();
+    ASSERT_TRUE(WriteCache());
+    ASSERT_TRUE(cache.Open(cachePath_));
+    EXPECT_FALSE(cache.IsSourceStampChanged());
+}
+
+TEST_F(MeshCacheTest, SameSizeDifferentContentIsMiss) {
+    ASSERT_TRUE(WriteCache());
+    // サイズは同じで内容だけが違う
+    WriteText(sourcePaths_[0], "v 0 0 0\nv 2 0 0\nv 0 1 0\nf 1 2 3\n");
+    Touch(sourcePaths_[0]);
+
+    MeshCache cache;
+    EXPECT_FALSE(cache.Open(cachePath_));
+    EXPECT_FALSE(cache.IsOpen());
+}
+
+TEST_F(MeshCacheTest, ChangedSizeIsMiss) {
+    ASSERT_TRUE(WriteCache());
+    WriteText(sourcePaths_[1], "newmtl material\nmap_Kd another_texture.png\n");
+
+    MeshCache cache;
+    EXPECT_FALSE(cache.Open(cachePath_));
+}
+
+TEST_F(MeshCacheTest, MissingSourceIsMiss) {
+    ASSERT_TRUE(WriteCache());
+    std::filesystem::remove(sourcePaths_[1]);
+
+    MeshCache cache;
+    EXPECT_FALSE(cache.Open(cachePath_));
+}
+
+TEST_F(MeshCacheTest, BrokenOrMissingCacheIsMiss) {
+    MeshCache cache;
+    EXPECT_FALSE(cache.Open(cachePath_));
+
+    // 途中で切れたファイル
+    ASSERT_TRUE(WriteCache());
+    std::filesystem::resize_file(cachePath_, std::filesystem::file_size(cachePath_) / 2);
+    EXPECT_FALSE(cache.Open(cachePath_));
+}
@@ -0,0 +1,153 @@
+#include "MeshOptimizer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// 三角形を頂点の内容で表したもの（頂点の番号の付け替えに左右されない）
+using TriangleKey = std::array<float, 9>;
+
+// 起伏のある格子状のメッシュ（四角形ごとに2枚の三角形を並べた、インデックスなしの三角形リスト）
+// 頂点は行ごとに左から順に並ぶので、頂点キャッシュの効率はあまり良くない
+std::vector<VertexData> MakeGridTriangleList(uint32_t cellCount) {
+    auto makeVertex = [cellCount](uint32_t x, uint32_t z) {
+        float u = static_cast<float>(x) / static_cast<float>(cellCount);
+        float v = static_cast<float>(z) / static_cast<float>(cellCount);
+        float px = u * 10.0f;
+        float pz = v * 10.0f;
+        // 高さ y = sin(x) * cos(z) の面の法線
+        Vector3 normal = { -std::cos(px) * std::cos(pz), 1.0f, std::sin(px) * std::sin(pz) };
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        return VertexData{
+            { px, std::sin(px) * std::cos(pz), pz, 1.0f },
+            { u, v },
+            { normal.x / length, normal.y / length, normal.z / length },
+        };
+    };
+
+    std::vector<VertexData> vertices;
+    for (uint32_t z = 0; z < cellCount; ++z) {
+        for (uint32_t x = 0; x < cellCount; ++x) {
+            vertices.push_back(makeVertex(x, z));
+            vertices.push_back(makeVertex(x, z + 1));
+            vertices.push_back(makeVertex(x + 1, z));
+            vertices.push_back(makeVertex(x + 1, z));
+            vertices.push_back(makeVertex(x, z + 1));
+            vertices.push_back(makeVertex(x + 1, z + 1));
+        }
+    }
+    return vertices;
+}
+
+// 三角形の集合（周り順は保ったまま最小の頂点が先頭になるよう回転し、三角形の並びは整列する）
+std::vector<TriangleKey> MakeTriangleSet(const std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices) {
+    std::vector<TriangleKey> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<std::array<float, 3>, 3> corners;
+        for (size_t k = 0; k < 3; ++k) {
+            const Vector4& position = vertices[indices[i + k]].position;
+            corners[k] = { position.x, position.y, position.z };
+        }
+        size_t first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+        TriangleKey key;
+        for (size_t k = 0; k < 3; ++k) {
+            std::copy(corners[(first + k) % 3].begin(), corners[(first + k) % 3].end(), key.begin() + k * 3);
+        }
+        triangles.push_back(key);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+class MeshOptimizerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        triangleList_ = MakeGridTriangleList(kCellCount);
+        MeshOptimizer::WeldVertices(triangleList_, MeshOptimizer::kWeldQuantum, vertices_, indices_);
+    }
+
+    static const uint32_t kCellCount = 64;
+
+    std::vector<VertexData> triangleList_;
+    std::vector<VertexData> vertices_;
+    std::vector<uint32_t> indices_;
+};
+
+} // namespace
+
+TEST_F(MeshOptimizerTest, WeldVerticesSharesGridVertices) {
+    // 格子点ごとに1頂点にまとまり、三角形は変わらない
+    EXPECT_EQ(vertices_.size(), size_t(kCellCount + 1) * (kCellCount + 1));
+    ASSERT_EQ(indices_.size(), triangleList_.size());
+    for (size_t i = 0; i < indices_.size(); ++i) {
+        ASSERT_LT(indices_[i], vertices_.size());
+        EXPECT_EQ(vertices_[indices_[i]].position.x, triangleList_[i].position.x);
+        EXPECT_EQ(vertices_[indices_[i]].position.z, triangleList_[i].position.z);
+    }
+}
+
+TEST_F(MeshOptimizerTest, PassesPreserveTrianglesAndDoNotWorsenAcmr) {
+    const std::vector<TriangleKey> originalTriangles = MakeTriangleSet(indices_, vertices_);
+    MeshOptimizer::VertexCacheStatistics original = MeshOptimizer::AnalyzeVertexCache(indices_, vertices_.size());
+
+    // 頂点キャッシュの最適化
+    MeshOptimizer::OptimizeVertexCache(indices_, vertices_.size());
+    EXPECT_EQ(originalTriangles, MakeTriangleSet(indices_, vertices_));
+    MeshOptimizer::VertexCacheStatistics vertexCache = MeshOptimizer::AnalyzeVertexCache(indices_, vertices_.size());
+    EXPECT_LE(vertexCache.acmr, original.acmr);
+    // 格子は頂点を共有する三角形が多いので、大きく改善する
+    EXPECT_LT(vertexCache.acmr, original.acmr * 0.8f);
+
+    // 重なりを減らす並べ替え（ACMRの低下はthreshold倍まで）
+    MeshOptimizer::OptimizeOverdraw(indices_, vertices_, MeshOptimizer::kOverdrawThreshold);
+    EXPECT_EQ(originalTriangles, MakeTriangleSet(indices_, vertices_));
+    MeshOptimizer::VertexCacheStatistics overdraw = MeshOptimizer::AnalyzeVertexCache(indices_, vertices_.size());
+    EXPECT_LE(overdraw.acmr, original.acmr);
+    EXPECT_LE(overdraw.acmr, vertexCache.acmr * MeshOptimizer::kOverdrawThreshold);
+
+    // 頂点の並べ替え（インデックスの付け替えだけなのでACMRは変わらない）
+    MeshOptimizer::OptimizeVertexFetch(vertices_, indices_);
+    EXPECT_EQ(originalTriangles, MakeTriangleSet(indices_, vertices_));
+    MeshOptimizer::VertexCacheStatistics vertexFetch = MeshOptimizer::AnalyzeVertexCache(indices_, vertices_.size());
+    EXPECT_EQ(vertexFetch.transformedVertexCount, overdraw.transformedVertexCount);
+    EXPECT_LE(vertexFetch.acmr, original.acmr);
+}
+
+TEST_F(MeshOptimizerTest, VertexFetchOrdersVerticesByFirstUse) {
+    MeshOptimizer::OptimizeVertexCache(indices_, vertices_.size());
+    MeshOptimizer::OptimizeVertexFetch(vertices_, indices_);
+
+    // 初めて使われる頂点の番号は0から1ずつ増える
+    uint32_t nextVertex = 0;
+    for (uint32_t index : indices_) {
+        ASSERT_LE(index, nextVertex);
+        if (index == nextVertex) {
+            ++nextVertex;
+        }
+    }
+    EXPECT_EQ(nextVertex, vertices_.size());
+}
+
+TEST(MeshOptimizerSubMeshTest, MergeSubMeshesByMaterialKeepsTriangles) {
+    // マテリアル1, 0, 1の順に並んだ三角形
+    std::vector<uint32_t> indices = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    std::vector<SubMeshData> subMeshes = {
+        { 0, 3, 1 },
+        { 3, 6, 0 },
+        { 9, 3, 1 },
+    };
+    MeshOptimizer::MergeSubMeshesByMaterial(indices, subMeshes);
+
+    ASSERT_EQ(subMeshes.size(), 2u);
+    EXPECT_EQ(subMeshes[0].materialIndex, 0u);
+    EXPECT_EQ(subMeshes[0].indexStart, 0u);
+    EXPECT_EQ(subMeshes[0].indexCount, 6u);
+    EXPECT_EQ(subMeshes[1].materialIndex, 1u);
+    EXPECT_EQ(subMeshes[1].indexStart, 6u);
+    EXPECT_EQ(subMeshes[1].indexCount, 6u);
+    // 同じマテリアルの中では元の順を保つ
+    EXPECT_EQ(indices, (std::vector<uint32_t>{ 3, 4, 5, 6, 7, 8, 0, 1, 2, 9, 10, 11 }));
+}
@@ -0,0 +1,306 @@
+#include "ObjFile.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 読み込み後の位置（xは反転される）
+Vector3 Position(float x, float y, float z) {
+    return { -x, y, z };
+}
+
+void ExpectPosition(const VertexData& vertex, const Vector3& expected) {
+    EXPECT_EQ(vertex.position.x, expected.x);
+    EXPECT_EQ(vertex.position.y, expected.y);
+    EXPECT_EQ(vertex.position.z, expected.z);
+    EXPECT_EQ(vertex.position.w, 1.0f);
+}
+
+// 数値の文字列をvの3要素に入れて解析し、strtofと同じ値になるか
+void ExpectParsedLikeStrtof(const std::vector<std::string>& numbers) {
+    std::string text;
+    for (const std::string& number : numbers) {
+        text += "v " + number + " " + number + "\t" + number + "\n";
+    }
+    for (size_t i = 1; i <= numbers.size(); ++i) {
+        text += "f " + std::to_string(i) + " " + std::to_string(i) + " " + std::to_string(i) + "\n";
+    }
+
+    ObjFile objFile;
+    objFile.Parse(text);
+    ASSERT_EQ(objFile.GetVertices().size(), numbers.size() * 3);
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        float expected = std::strtof(numbers[i].c_str(), nullptr);
+        const Vector4& position = objFile.GetVertices()[i * 3].position;
+        // 読んだ後の位置がずれていれば、続くyとzが違う値になる
+        EXPECT_EQ(position.x, -expected) << numbers[i];
+        EXPECT_EQ(position.y, expected) << numbers[i];
+        EXPECT_EQ(position.z, expected) << numbers[i];
+    }
+}
+
+std::string Format(const char* format, double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), format, value);
+    return buffer;
+}
+
+} // namespace
+
+TEST(ObjFileTest, ReadFloatMatchesStrtofForEdgeCases) {
+    ExpectParsedLikeStrtof({
+        "0", "-0", "1", "-1", "+1.25", "0.5", ".5", "-.25", "5.", "000123.4500",
+        // 指数表記
+        "1e-3", "1.5E+2", "-2.5e10", "3e0", "1E-30",
+        // 仮数が2^24を超える、小数部が10桁を超える
+        "16777216", "16777217", "123456789012", "3.14159265358979", "0.00000000001", "1.000000000000000000001",
+        "-0.1234567891", "0.1234567890123",
+        // Blenderの出力に多い形式
+        "-1.000000", "0.707107", "-0.0000",
+    });
+}
+
+TEST(ObjFileTest, ReadFloatMatchesStrtofForRandomNumbers) {
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-12, 12);
+    const char* formats[] = { "%.6f", "%.4f", "%.9f", "%.12f", "%.3e", "%.8e", "%g", "%.17g" };
+
+    std::vector<std::string> numbers;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        double value = mantissa(engine) * std::pow(10.0, exponent(engine));
+        numbers.push_back(Format(formats[i % std::size(formats)], value));
+    }
+    ExpectParsedLikeStrtof(numbers);
+}
+
+TEST(ObjFileTest, FaceFormats) {
+    ObjFile objFile;
+    objFile.Parse(
+        "v 1 2 3\n"
+        "v 4 5 6\n"
+        "v 7 8 9\n"
+        "vt 0.25 0.75\n"
+        "vn 0 1 0\n"
+        "f 1 2 3\n"
+        "f 1/1 2/1 3/1\n"
+        "f 1//1 2//1 3//1\n"
+        "f 1/1/1 2/1/1 3/1/1\n");
+
+    const std::vector<VertexData>& vertices = objFile.GetVertices();
+    ASSERT_EQ(vertices.size(), 12u);
+    EXPECT_EQ(objFile.GetStatistics().faceCount, 4u);
+    EXPECT_EQ(objFile.GetStatistics().skippedFaceCount, 0u);
+
+    for (uint32_t face = 0; face < 4; ++face) {
+        // 周り順を逆にするので、3・2・1の順になる
+        ExpectPosition(vertices[face * 3 + 0], Position(7.0f, 8.0f, 9.0f));
+        ExpectPosition(vertices[face * 3 + 1], Position(4.0f, 5.0f, 6.0f));
+        ExpectPosition(vertices[face * 3 + 2], Position(1.0f, 2.0f, 3.0f));
+
+        bool hasTexcoord = face == 1 || face == 3;
+        bool hasNormal = face >= 2;
+        for (uint32_t k = 0; k < 3; ++k) {
+            const VertexData& vertex = vertices[face * 3 + k];
+            // テクスチャ座標のvは反転、省略時は0
+            EXPECT_EQ(vertex.texcoord.x, hasTexcoord ? 0.25f : 0.0f);
+            EXPECT_EQ(vertex.texcoord.y, hasTexcoord ? 0.25f : 0.0f);
+            EXPECT_EQ(vertex.normal.y, hasNormal ? 1.0f : 0.0f);
+        }
+    }
+}
+
+TEST(ObjFileTest, NegativeIndicesAreRelativeToTheEnd) {
+    ObjFile objFile;
+    objFile.Parse(
+        "v 1 0 0\n"
+        "v 2 0 0\n"
+        "v 3 0 0\n"
+        "vt 0 0.5\n"
+        "vn 1 0 0\n"
+        "f -3/-1/-1 -2/-1/-1 -1/-1/-1\n"
+        "v 4 0 0\n"
+        "vn 0 0 1\n"
+        // ここでの-1は後から追加した4番目の頂点と2番目の法線
+        "f -4//-1 -3//-2 -1//-1\n");
+
+    const std::vector<VertexData>& vertices = objFile.GetVertices();
+    ASSERT_EQ(vertices.size(), 6u);
+    ExpectPosition(vertices[0], Position(3.0f, 0.0f, 0.0f));
+    ExpectPosition(vertices[1], Position(2.0f, 0.0f, 0.0f));
+    ExpectPosition(vertices[2], Position(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(vertices[0].texcoord.y, 0.5f);
+    EXPECT_EQ(vertices[0].normal.x, -1.0f);
+
+    ExpectPosition(vertices[3], Position(4.0f, 0.0f, 0.0f));
+    ExpectPosition(vertices[4], Position(2.0f, 0.0f, 0.0f));
+    ExpectPosition(vertices[5], Position(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(vertices[3].normal.z, 1.0f);
+    EXPECT_EQ(vertices[4].normal.x, -1.0f);
+}
+
+TEST(ObjFileTest, PolygonsAreFanTriangulatedWithReversedWinding) {
+    ObjFile objFile;
+    objFile.Parse(
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "v -1 0.5 0\n"
+        "f 1 2 3 4\n"
+        "f 1 2 3 4 5\n");
+
+    const std::vector<VertexData>& vertices = objFile.GetVertices();
+    // 四角形は2枚、五角形は3枚
+    ASSERT_EQ(vertices.size(), 15u);
+    EXPECT_EQ(objFile.GetStatistics().faceCount, 2u);
+
+    // 1頂点目を中心に(1, i, i+1)の扇形に分け、それぞれを(i+1, i, 1)の順で登録する
+    const float corners[5][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }, { -1.0f, 0.5f } };
+    uint32_t vertex = 0;
+    for (uint32_t cornerCount : { 4u, 5u }) {
+        for (uint32_t i = 1; i + 1 < cornerCount; ++i) {
+            for (uint32_t corner : { i + 1, i, 0u }) {
+                ExpectPosition(vertices[vertex++], Position(corners[corner][0], corners[corner][1], 0.0f));
+            }
+        }
+    }
+}
+
+TEST(ObjFileTest, GroupsSplitOnObjectGroupAndMaterial) {
+    ObjFile objFile;
+    objFile.Parse(
+        "mtllib my materials.mtl\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1 0\n"
+        // 面のないグループは残らない
+        "o Empty\n"
+        "usemtl Unused\n"
+        "o First Object\n"
+        "usemtl Red\n"
+        "f 1 2 3\n"
+        "f 1 2 3\n"
+        // 名前もマテリアルも同じなら分けない
+        "usemtl Red\n"
+        "f 1 2 3\n"
+        "usemtl Blue\n"
+        "f 1 2 3\n"
+        // マテリアルはグループが変わっても引き継ぐ
+        "g Second\n"
+        "f 1 2 3\n"
+        "mtllib ignored.mtl\n");
+
+    EXPECT_EQ(objFile.GetMaterialLibrary(), "my materials.mtl");
+    const std::vector<ObjFile::Group>& groups = objFile.GetGroups();
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(groups[0].name, "First Object");
+    EXPECT_EQ(groups[0].materialName, "Red");
+    EXPECT_EQ(groups[0].vertexStart, 0u);
+    EXPECT_EQ(groups[0].vertexCount, 9u);
+    EXPECT_EQ(groups[1].name, "First Object");
+    EXPECT_EQ(groups[1].materialName, "Blue");
+    EXPECT_EQ(groups[1].vertexStart, 9u);
+    EXPECT_EQ(groups[1].vertexCount, 3u);
+    EXPECT_EQ(groups[2].name, "Second");
+    EXPECT_EQ(groups[2].materialName, "Blue");
+    EXPECT_EQ(groups[2].vertexStart, 12u);
+    EXPECT_EQ(groups[2].vertexCount, 3u);
+}
+
+TEST(ObjFileTest, CrlfMatchesLf) {
+    std::string text =
+        "# comment\n"
+        "mtllib model.mtl\n"
+        "o Model\n"
+        "v 1.5 -2 3e-1\n"
+        "v 4 5 6 0.5 0.5 0.5\n"
+        "v 7 8 9\n"
+        "vt 0.1 0.2 0.0\n"
+        "vn 0 0 -1\n"
+        "usemtl Material\n"
+        "s off\n"
+        "f 1/1/1 2/1/1 3/1/1 # trailing comment\n"
+        "f 3/1/1 2/1/1 1/1/1";
+    std::string crlfText;
+    for (char c : text) {
+        if (c == '\n') {
+            crlfText += '\r';
+        }
+        crlfText += c;
+    }
+
+    ObjFile lf;
+    lf.Parse(text);
+    ObjFile crlf;
+    crlf.Parse(crlfText);
+
+    ASSERT_EQ(lf.GetVertices().size(), 6u);
+    ASSERT_EQ(crlf.GetVertices().size(), lf.GetVertices().size());
+    for (size_t i = 0; i < lf.GetVertices().size(); ++i) {
+        const VertexData& a = lf.GetVertices()[i];
+        const VertexData& b = crlf.GetVertices()[i];
+        EXPECT_EQ(a.position.x, b.position.x);
+        EXPECT_EQ(a.position.y, b.position.y);
+        EXPECT_EQ(a.position.z, b.position.z);
+        EXPECT_EQ(a.texcoord.x, b.texcoord.x);
+        EXPECT_EQ(a.texcoord.y, b.texcoord.y);
+        EXPECT_EQ(a.normal.z, b.normal.z);
+    }
+    ExpectPosition(lf.GetVertices()[2], Position(1.5f, -2.0f, 0.3f));
+    EXPECT_EQ(lf.GetVertices()[0].texcoord.y, 0.8f);
+
+    // 名前に改行コードの\rが残らない
+    EXPECT_EQ(crlf.GetMaterialLibrary(), "model.mtl");
+    ASSERT_EQ(crlf.GetGroups().size(), 1u);
+    EXPECT_EQ(crlf.GetGroups()[0].name, "Model");
+    EXPECT_EQ(crlf.GetGroups()[0].materialName, "Material");
+}
+
+TEST(ObjFileTest, InvalidFacesAreSkipped) {
+    ObjFile objFile;
+    objFile.Parse(
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1 0\n"
+        "vt 0 0\n"
+        "f 1 2 3\n"
+        // 範囲外の位置・UV・法線、負の範囲外、頂点が足りない
+        "f 1 2 4\n"
+        "f 1/2 2/1 3/1\n"
+        "f 1//1 2//1 3//1\n"
+        "f -4 1 2\n"
+        "f 1 2\n"
+        "f 1 2 3\n");
+
+    EXPECT_EQ(objFile.GetStatistics().faceCount, 2u);
+    EXPECT_EQ(objFile.GetStatistics().skippedFaceCount, 5u);
+    EXPECT_EQ(objFile.GetVertices().size(), 6u);
+    EXPECT_EQ(objFile.GetStatistics().positionCount, 3u);
+    EXPECT_EQ(objFile.GetStatistics().texcoordCount, 1u);
+}
+
+TEST(ObjFileTest, LoadsResourceModel) {
+    ObjFile objFile;
+    ASSERT_TRUE(objFile.Load(ENGINE_RESOURCE_DIR "/06_02/multiMaterial.obj"));
+    EXPECT_EQ(objFile.GetMaterialLibrary(), "multiMaterial.mtl");
+    EXPECT_EQ(objFile.GetStatistics().faceCount, 14u);
+    EXPECT_EQ(objFile.GetVertices().size(), 42u);
+
+    const std::vector<ObjFile::Group>& groups = objFile.GetGroups();
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups[0].name, "Plane");
+    EXPECT_EQ(groups[0].materialName, "Material.001");
+    EXPECT_EQ(groups[0].vertexCount, 6u);
+    EXPECT_EQ(groups[1].name, "Cube");
+    EXPECT_EQ(groups[1].materialName, "Material");
+    EXPECT_EQ(groups[1].vertexStart, 6u);
+    EXPECT_EQ(groups[1].vertexCount, 36u);
+
+    EXPECT_FALSE(objFile.Load(ENGINE_RESOURCE_DIR "/06_02/missing.obj"));
+}
@@ -0,0 +1,67 @@
+#include "ParticleKernel.h"
+#include "ParticleTestUtility.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// CPUが対応しているカーネルの一覧
+std::vector<ParticleKernelType> AvailableKernelTypes() {
+    std::vector<ParticleKernelType> types;
+    for (ParticleKernelType type : { ParticleKernelType::Scalar, ParticleKernelType::SSE, ParticleKernelType::AVX2 }) {
+        if (static_cast<int>(type) <= static_cast<int>(GetBestParticleKernelType())) {
+            types.push_back(type);
+        }
+    }
+    return types;
+}
+
+} // namespace
+
+// 全カーネルはスカラー版と同じ演算順序で計算するので、結果はビット単位で一致する
+TEST(ParticleKernelTest, AllKernelsMatchScalarBitExactly) {
+    // 8個・4個ずつの処理の端数も通るよう、範囲の先頭と末尾をずらす
+    const uint32_t count = 1003;
+    const uint32_t begin = 3;
+    const uint32_t end = count - 2;
+    const ParticlePool source = ParticleTestUtility::MakeRandomPool(count, 1);
+
+    ParticlePool expected = source;
+    for (int step = 0; step < 10; ++step) {
+        IntegrateParticles(ParticleKernelType::Scalar, expected, begin, end, 1.0f / 60.0f);
+    }
+
+    for (ParticleKernelType type : AvailableKernelTypes()) {
+        SCOPED_TRACE(static_cast<int>(type));
+        ParticlePool actual = source;
+        for (int step = 0; step < 10; ++step) {
+            IntegrateParticles(type, actual, begin, end, 1.0f / 60.0f);
+        }
+        ParticleTestUtility::ExpectPoolsBitEqual(expected, actual);
+    }
+}
+
+TEST(ParticleKernelTest, OutsideRangeIsUntouched) {
+    const ParticlePool source = ParticleTestUtility::MakeRandomPool(64, 2);
+    for (ParticleKernelType type : AvailableKernelTypes()) {
+        SCOPED_TRACE(static_cast<int>(type));
+        ParticlePool actual = source;
+        IntegrateParticles(type, actual, 5, 5, 1.0f / 60.0f);
+        ParticleTestUtility::ExpectPoolsBitEqual(source, actual);
+    }
+}
+
+TEST(ParticleKernelTest, SelectedKernelIsUsedByDefault) {
+    ParticleKernelType previous = GetParticleKernelType();
+    SetParticleKernelType(ParticleKernelType::Scalar);
+    EXPECT_EQ(GetParticleKernelType(), ParticleKernelType::Scalar);
+
+    // 既定のカーネルで計算した結果も一致する
+    ParticlePool expected = ParticleTestUtility::MakeRandomPool(100, 3);
+    ParticlePool actual = expected;
+    IntegrateParticles(ParticleKernelType::Scalar, expected, 0, 100, 0.02f);
+    SetParticleKernelType(GetBestParticleKernelType());
+    IntegrateParticles(actual, 0, 100, 0.02f);
+    ParticleTestUtility::ExpectPoolsBitEqual(expected, actual);
+
+    SetParticleKernelType(previous);
+}
@@ -0,0 +1,147 @@
+#include "ParticleSimulation.h"
+#include "ParticleTestUtility.h"
+#include "JobSystem.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+namespace {
+
+// 全ての力場・衝突・反発を有効にした設定
+ParticleForceStage MakeForceStage() {
+    ParticleForceStage stage;
+    stage.attractors.push_back({ { 0.0f, 2.0f, 0.0f }, 4.0f, 8.0f });
+    stage.vortices.push_back({ { 1.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f }, 3.0f, 0.0f });
+    stage.windVolumes.push_back({ { -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f }, { 2.0f, 0.0f, 1.0f }, 0.5f });
+    stage.planeColliders.push_back({ { 0.0f, 1.0f, 0.0f }, -8.0f, 0.5f, 0.1f });
+    stage.sphereColliders.push_back({ { 3.0f, 0.0f, 3.0f }, 2.0f, 0.3f, 0.2f });
+    stage.repulsion.isEnabled = true;
+    stage.repulsion.radius = 0.5f;
+    stage.repulsion.strength = 2.0f;
+    return stage;
+}
+
+// 全ての寿命に応じた変化を有効にした設定
+ParticleLifetimeCurves MakeLifetimeCurves() {
+    ParticleLifetimeCurves curves;
+    curves.hasSize = true;
+    curves.size.Bake(ParticleCurve().AddKey(0.0f, 0.5f).AddKey(0.5f, 1.5f).AddKey(1.0f, 0.0f));
+    curves.hasColor = true;
+    curves.color.Bake(ParticleGradient().AddKey(0.0f, { 1.0f, 0.5f, 0.0f, 1.0f }).AddKey(1.0f, { 0.2f, 0.2f, 0.2f, 0.0f }));
+    curves.hasRotationSpeed = true;
+    curves.rotationSpeed.Bake(ParticleCurve().AddKey(0.0f, 1.0f).AddKey(1.0f, 3.0f));
+    curves.hasDamping = true;
+    curves.damping.Bake(ParticleCurve(0.5f));
+    return curves;
+}
+
+// 固定シードのパーティクルをsubStepCount回進めた結果
+ParticlePool Simulate(uint32_t subStepCount) {
+    // 複数のチャンクに分かれる数にする
+    ParticlePool pool = ParticleTestUtility::MakeRandomPool(kParticleChunkSize * 8 + 123, 42);
+    ParticleLifetimeCurves curves = MakeLifetimeCurves();
+    ParticleForceStage forces = MakeForceStage();
+    ParticleSpatialHash spatialHash;
+    SimulateParticles(pool, curves, forces, spatialHash, 1.0f / 60.0f, subStepCount);
+    return pool;
+}
+
+} // namespace
+
+// ワーカーがいない場合（直列）といる場合（並列）で結果がビット単位で一致する
+TEST(ParticleSimulationTest, ParallelMatchesSerial) {
+    JobSystem* jobSystem = JobSystem::GetInstance();
+    jobSystem->Finalize();
+    ASSERT_EQ(jobSystem->GetWorkerCount(), 0u);
+    ParticlePool serial = Simulate(30);
+
+    jobSystem->Initialize(4);
+    ASSERT_EQ(jobSystem->GetWorkerCount(), 4u);
+    ParticlePool parallel = Simulate(30);
+    // 並列でも毎回同じ結果になる
+    ParticlePool parallelAgain = Simulate(30);
+    jobSystem->Finalize();
+
+    // 寿命が尽きて削除されたものがあっても、削除の順序は直列で決まるので並びも一致する
+    EXPECT_LT(serial.Size(), kParticleChunkSize * 8 + 123);
+    ParticleTestUtility::ExpectPoolsBitEqual(serial, parallel);
+    ParticleTestUtility::ExpectPoolsBitEqual(serial, parallelAgain);
+}
+
+TEST(ParticleSimulationTest, RepulsionTimingsAreRecorded) {
+    ParticlePool pool = ParticleTestUtility::MakeRandomPool(1000, 7);
+    ParticleForceStage forces;
+    forces.repulsion.isEnabled = true;
+    ParticleSpatialHash spatialHash;
+    ParticleSimulationTimings timings = SimulateParticles(pool, ParticleLifetimeCurves(), forces, spatialHash, 1.0f / 60.0f, 2);
+    EXPECT_GE(timings.spatialHashBuildMilliseconds, 0.0f);
+    EXPECT_GT(timings.spatialHashBuildMilliseconds + timings.repulsionMilliseconds, 0.0f);
+
+    // 反発が無効なら計測しない
+    forces.repulsion.isEnabled = false;
+    timings = SimulateParticles(pool, ParticleLifetimeCurves(), forces, spatialHash, 1.0f / 60.0f, 2);
+    EXPECT_EQ(timings.spatialHashBuildMilliseconds, 0.0f);
+    EXPECT_EQ(timings.repulsionMilliseconds, 0.0f);
+}
+
+// KillExpiredは先頭から1粒ずつKillした場合と同じ並びになる
+TEST(ParticleSimulationTest, KillExpiredMatchesRepeatedKill) {
+    ParticlePool pool = ParticleTestUtility::MakeRandomPool(1000, 7);
+    // 途中にも末尾にも、寿命が尽きたものが連続する箇所を作る
+    ParticleRandom random(8);
+    for (uint32_t i = 0; i < pool.Size(); ++i) {
+        bool isExpired = random.NextFloat() < 0.3f || (i >= 400 && i < 420) || i >= 990;
+        if (isExpired) {
+            pool.lifeTime[i] = pool.lifeTimeMax[i];
+        }
+    }
+
+    ParticlePool expected = pool;
+    uint32_t expectedKillCount = 0;
+    for (uint32_t i = 0; i < expected.Size(); ) {
+        if (expected.lifeTime[i] >= expected.lifeTimeMax[i]) {
+            expected.Kill(i);
+            ++expectedKillCount;
+            continue;
+        }
+        ++i;
+    }
+
+    EXPECT_EQ(pool.KillExpired(), expectedKillCount);
+    ParticleTestUtility::ExpectPoolsBitEqual(expected, pool);
+
+    // 全て寿命が尽きていれば空になる
+    for (uint32_t i = 0; i < pool.Size(); ++i) {
+        pool.lifeTime[i] = pool.lifeTimeMax[i];
+    }
+    uint32_t remainingCount = pool.Size();
+    EXPECT_EQ(pool.KillExpired(), remainingCount);
+    EXPECT_TRUE(pool.Empty());
+    EXPECT_EQ(pool.KillExpired(), 0u);
+}
+
+// 範囲を指定した1ステップは、SimulateParticlesの1ステップのうちその範囲の結果と一致し、範囲外は変えない
+// （寿命が尽きるものと反発がなければKillExpiredで並びが変わらない）
+TEST(ParticleSimulationTest, StepParticlesMatchesSimulateInRange) {
+    ParticlePool source = ParticleTestUtility::MakeRandomPool(1000, 9);
+    ParticleLifetimeCurves curves = MakeLifetimeCurves();
+    ParticleForceStage forces = MakeForceStage();
+    forces.repulsion.isEnabled = false;
+    const float kDeltaTime = 1.0f / 60.0f;
+
+    ParticlePool simulated = source;
+    ParticleSpatialHash spatialHash;
+    SimulateParticles(simulated, curves, forces, spatialHash, kDeltaTime, 1);
+    ASSERT_EQ(simulated.Size(), source.Size());
+
+    ParticlePool stepped = source;
+    const uint32_t kBegin = 300;
+    const uint32_t kEnd = 700;
+    StepParticles(stepped, curves, forces, kBegin, kEnd, kDeltaTime);
+
+    // 範囲内はSimulateParticlesの結果、範囲外は元のまま
+    ParticlePool expected = source;
+    for (std::vector<float> ParticlePool::* column : ParticleTestUtility::Columns()) {
+        std::copy(&(simulated.*column)[kBegin], &(simulated.*column)[kEnd], &(expected.*column)[kBegin]);
+    }
+    ParticleTestUtility::ExpectPoolsBitEqual(expected, stepped);
+}
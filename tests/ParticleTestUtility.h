@@ -0,0 +1,56 @@
+#pragma once
+#include "ParticlePool.h"
+#include "ParticleRandom.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// パーティクルのテスト・ベンチマークで使う共通処理
+namespace ParticleTestUtility
+{
+    // プールの全属性配列
+    inline std::vector<std::vector<float> ParticlePool::*> Columns() {
+        return {
+            &ParticlePool::positionX, &ParticlePool::positionY, &ParticlePool::positionZ,
+            &ParticlePool::velocityX, &ParticlePool::velocityY, &ParticlePool::velocityZ,
+            &ParticlePool::accelX, &ParticlePool::accelY, &ParticlePool::accelZ,
+            &ParticlePool::colorR, &ParticlePool::colorG, &ParticlePool::colorB, &ParticlePool::colorA,
+            &ParticlePool::startColorR, &ParticlePool::startColorG, &ParticlePool::startColorB, &ParticlePool::startColorA,
+            &ParticlePool::endColorR, &ParticlePool::endColorG, &ParticlePool::endColorB, &ParticlePool::endColorA,
+            &ParticlePool::size, &ParticlePool::startSize, &ParticlePool::endSize,
+            &ParticlePool::rotation, &ParticlePool::rotationVelocity,
+            &ParticlePool::lifeTime, &ParticlePool::lifeTimeMax,
+        };
+    }
+
+    // 固定シードの乱数でcount個のパーティクルを作る
+    inline ParticlePool MakeRandomPool(uint32_t count, uint64_t seed) {
+        ParticleRandom random(seed);
+        ParticlePool pool;
+        uint32_t first = pool.Append(count);
+        for (std::vector<float> ParticlePool::* column : Columns()) {
+            random.FillUniform(&(pool.*column)[first], count, -10.0f, 10.0f);
+        }
+        // 寿命は正、経過時間は寿命より短くする
+        random.FillUniform(&pool.lifeTimeMax[first], count, 1.0f, 3.0f);
+        random.FillUniform(&pool.lifeTime[first], count, 0.0f, 1.0f);
+        return pool;
+    }
+
+    // 2つのプールの全属性がビット単位で一致するか確かめる
+    inline void ExpectPoolsBitEqual(const ParticlePool& expected, const ParticlePool& actual) {
+        ASSERT_EQ(expected.Size(), actual.Size());
+        for (std::vector<float> ParticlePool::* column : Columns()) {
+            const std::vector<float>& lhs = expected.*column;
+            const std::vector<float>& rhs = actual.*column;
+            for (size_t i = 0; i < lhs.size(); ++i) {
+                uint32_t lhsBits = 0;
+                uint32_t rhsBits = 0;
+                std::memcpy(&lhsBits, &lhs[i], sizeof(float));
+                std::memcpy(&rhsBits, &rhs[i], sizeof(float));
+                ASSERT_EQ(lhsBits, rhsBits) << "particle " << i << ": " << lhs[i] << " vs " << rhs[i];
+            }
+        }
+    }
+};
@@ -0,0 +1,168 @@
+#include "Quaternion.h"
+#include "Mymath.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+// 乱数で単位クォータニオンを作る（固定シードで毎回同じ値になる）
+Quaternion RandomQuaternion(std::mt19937& engine) {
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    Quaternion quaternion = { distribution(engine), distribution(engine), distribution(engine), distribution(engine) };
+    return Normalize(quaternion);
+}
+
+// 同じ回転を表すか（qと-qは同じ回転）
+void ExpectSameRotation(const Quaternion& expected, const Quaternion& actual, float tolerance) {
+    float sign = Dot(expected, actual) < 0.0f ? -1.0f : 1.0f;
+    EXPECT_NEAR(expected.x, sign * actual.x, tolerance);
+    EXPECT_NEAR(expected.y, sign * actual.y, tolerance);
+    EXPECT_NEAR(expected.z, sign * actual.z, tolerance);
+    EXPECT_NEAR(expected.w, sign * actual.w, tolerance);
+}
+
+void ExpectMatrixNear(const Matrix4x4& expected, const Matrix4x4& actual, float tolerance) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(expected.m[i][j], actual.m[i][j], tolerance) << "m[" << i << "][" << j << "]";
+        }
+    }
+}
+
+// 2つの単位クォータニオンが表す回転の間の角度
+float AngleBetween(const Quaternion& q0, const Quaternion& q1) {
+    return 2.0f * std::acos((std::min)(std::abs(Dot(q0, q1)), 1.0f));
+}
+
+} // namespace
+
+TEST(QuaternionTest, MultiplyMatchesMatrixComposition) {
+    std::mt19937 engine(1);
+    for (int i = 0; i < 1000; ++i) {
+        Quaternion lhs = RandomQuaternion(engine);
+        Quaternion rhs = RandomQuaternion(engine);
+        // rhsの回転を行ったあとにlhsの回転を行う
+        Matrix4x4 expected = Multiply(MakeRotateMatrix(rhs), MakeRotateMatrix(lhs));
+        ExpectMatrixNear(expected, MakeRotateMatrix(Multiply(lhs, rhs)), 1e-5f);
+    }
+}
+
+TEST(QuaternionTest, MultiplyByInverseIsIdentity) {
+    std::mt19937 engine(2);
+    for (int i = 0; i < 1000; ++i) {
+        Quaternion quaternion = RandomQuaternion(engine);
+        ExpectSameRotation(IdentityQuaternion(), Multiply(quaternion, Inverse(quaternion)), 1e-6f);
+    }
+}
+
+TEST(QuaternionTest, EulerMatchesRotateMatrix) {
+    std::mt19937 engine(3);
+    std::uniform_real_distribution<float> angle(-kPi, kPi);
+    for (int i = 0; i < 1000; ++i) {
+        Vector3 rotate = { angle(engine), angle(engine), angle(engine) };
+        ExpectMatrixNear(MakeRotateMatrix(rotate), MakeRotateMatrix(MakeRotateQuaternion(rotate)), 1e-5f);
+    }
+}
+
+TEST(QuaternionTest, MatrixRoundTrip) {
+    std::mt19937 engine(4);
+    std::vector<Quaternion> quaternions;
+    for (int i = 0; i < 1000; ++i) {
+        quaternions.push_back(RandomQuaternion(engine));
+    }
+    // 対角成分の符号で分岐する箇所を通すため、各軸の180度回転も含める
+    quaternions.push_back({ 1.0f, 0.0f, 0.0f, 0.0f });
+    quaternions.push_back({ 0.0f, 1.0f, 0.0f, 0.0f });
+    quaternions.push_back({ 0.0f, 0.0f, 1.0f, 0.0f });
+    quaternions.push_back(IdentityQuaternion());
+
+    for (const Quaternion& quaternion : quaternions) {
+        ExpectSameRotation(quaternion, MakeRotateQuaternion(MakeRotateMatrix(quaternion)), 1e-5f);
+    }
+}
+
+TEST(QuaternionTest, RotateVectorMatchesMatrix) {
+    std::mt19937 engine(5);
+    std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+    for (int i = 0; i < 1000; ++i) {
+        Quaternion quaternion = RandomQuaternion(engine);
+        Vector3 vector = { coordinate(engine), coordinate(engine), coordinate(engine) };
+        Vector3 expected = TransformVector(vector, MakeRotateMatrix(quaternion));
+        Vector3 actual = RotateVector(vector, quaternion);
+        EXPECT_NEAR(expected.x, actual.x, 1e-4f);
+        EXPECT_NEAR(expected.y, actual.y, 1e-4f);
+        EXPECT_NEAR(expected.z, actual.z, 1e-4f);
+    }
+}
+
+TEST(QuaternionTest, SlerpEndpointsAndConstantAngularVelocity) {
+    std::mt19937 engine(6);
+    for (int i = 0; i < 200; ++i) {
+        Quaternion q0 = RandomQuaternion(engine);
+        Quaternion q1 = RandomQuaternion(engine);
+        ExpectSameRotation(q0, Slerp(q0, q1, 0.0f), 1e-5f);
+        ExpectSameRotation(q1, Slerp(q0, q1, 1.0f), 1e-5f);
+
+        // 回転角は補間係数に比例する
+        float angle = AngleBetween(q0, q1);
+        for (float t : { 0.25f, 0.5f, 0.75f }) {
+            Quaternion result = Slerp(q0, q1, t);
+            EXPECT_NEAR(Norm(result), 1.0f, 1e-5f);
+            EXPECT_NEAR(AngleBetween(q0, result), angle * t, 1e-3f);
+        }
+    }
+}
+
+TEST(QuaternionTest, InterpolationTakesShortestPath) {
+    Quaternion q0 = IdentityQuaternion();
+    Quaternion q1 = MakeRotateAxisAngleQuaternion({ 0.0f, 1.0f, 0.0f }, kPi * 0.5f);
+    Quaternion negated = { -q1.x, -q1.y, -q1.z, -q1.w };
+    // 符号を反転した同じ回転に向かっても、遠回りせず同じ結果になる
+    ExpectSameRotation(Slerp(q0, q1, 0.5f), Slerp(q0, negated, 0.5f), 1e-6f);
+    ExpectSameRotation(Nlerp(q0, q1, 0.5f), Nlerp(q0, negated, 0.5f), 1e-6f);
+    ExpectSameRotation(MakeRotateAxisAngleQuaternion({ 0.0f, 1.0f, 0.0f }, kPi * 0.25f), Slerp(q0, negated, 0.5f), 1e-6f);
+}
+
+TEST(QuaternionTest, NlerpIsNormalized) {
+    std::mt19937 engine(7);
+    std::uniform_real_distribution<float> parameter(0.0f, 1.0f);
+    for (int i = 0; i < 1000; ++i) {
+        Quaternion q0 = RandomQuaternion(engine);
+        Quaternion q1 = RandomQuaternion(engine);
+        EXPECT_NEAR(Norm(Nlerp(q0, q1, parameter(engine))), 1.0f, 1e-6f);
+    }
+}
+
+TEST(QuaternionTest, BatchMatchesScalar) {
+    // 4個ずつの処理の端数も確かめるため4の倍数にしない
+    const size_t count = 1003;
+    std::mt19937 engine(8);
+    std::uniform_real_distribution<float> parameter(0.0f, 1.0f);
+    std::vector<Quaternion> q0(count);
+    std::vector<Quaternion> q1(count);
+    std::vector<float> t(count);
+    for (size_t i = 0; i < count; ++i) {
+        q0[i] = RandomQuaternion(engine);
+        q1[i] = RandomQuaternion(engine);
+        t[i] = parameter(engine);
+    }
+    // ほぼ同じ向き（Slerpが線形補間に切り替わる範囲）も含める
+    q1[0] = q0[0];
+    q1[1] = Normalize({ q0[1].x + 1e-4f, q0[1].y, q0[1].z, q0[1].w });
+
+    std::vector<Quaternion> slerp(count);
+    std::vector<Quaternion> nlerp(count);
+    SlerpBatch(q0, q1, t, slerp);
+    NlerpBatch(q0, q1, t, nlerp);
+
+    for (size_t i = 0; i < count; ++i) {
+        SCOPED_TRACE(i);
+        ExpectSameRotation(Slerp(q0[i], q1[i], t[i]), slerp[i], 1e-6f);
+        ExpectSameRotation(Nlerp(q0[i], q1[i], t[i]), nlerp[i], 1e-6f);
+    }
+}